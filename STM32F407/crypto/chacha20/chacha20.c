@@ -0,0 +1,347 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file chacha20.c
+
+    ChaCha20 (RFC 8439, 96 bit nonce), HChaCha20 and XChaCha20 with the API
+    shapes of salsa20.c. The rounds are crypto_core_chacha20_block, in
+    assembly on the Cortex M4 with CRYPTO_HAS_ASM_CHACHA20_BLOCK. Long
+    inputs use the multi-block kernels of chacha20_simd.c on hosts.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_stream.h"
+#include "../include/chacha20defs.h"
+
+static uint32_t load_littleendian(const uint8_t * x)
+{
+    return (uint32_t)(x[0]) | (((uint32_t)(x[1])) << 8) | (((uint32_t)(x[2])) << 16) | (((uint32_t)(x[3])) << 24);
+}
+
+static void store_littleendian(uint8_t * x, uint32_t u)
+{
+    x[0] = (uint8_t)u;
+    u >>= 8;
+    x[1] = (uint8_t)u;
+    u >>= 8;
+    x[2] = (uint8_t)u;
+    u >>= 8;
+    x[3] = (uint8_t)u;
+}
+
+#ifndef CRYPTO_HAS_ASM_CHACHA20_BLOCK
+
+#define CHACHA20_ROTL(x, r) (((x) << (r)) | ((x) >> (32 - (r))))
+
+#define CHACHA20_QUARTERROUND(a, b, c, d)                                                                                                  \
+    {                                                                                                                                      \
+        a += b;                                                                                                                            \
+        d = CHACHA20_ROTL(d ^ a, 16);                                                                                                      \
+        c += d;                                                                                                                            \
+        b = CHACHA20_ROTL(b ^ c, 12);                                                                                                      \
+        a += b;                                                                                                                            \
+        d = CHACHA20_ROTL(d ^ a, 8);                                                                                                       \
+        c += d;                                                                                                                            \
+        b = CHACHA20_ROTL(b ^ c, 7);                                                                                                       \
+    }
+
+void crypto_core_chacha20_block(uint32_t * state)
+{
+    uint32_t x[16];
+    int ctr;
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        x[ctr] = state[ctr];
+    }
+
+    for (ctr = 20; ctr > 0; ctr -= 2)
+    {
+        CHACHA20_QUARTERROUND(x[0], x[4], x[8], x[12]);
+        CHACHA20_QUARTERROUND(x[1], x[5], x[9], x[13]);
+        CHACHA20_QUARTERROUND(x[2], x[6], x[10], x[14]);
+        CHACHA20_QUARTERROUND(x[3], x[7], x[11], x[15]);
+
+        CHACHA20_QUARTERROUND(x[0], x[5], x[10], x[15]);
+        CHACHA20_QUARTERROUND(x[1], x[6], x[11], x[12]);
+        CHACHA20_QUARTERROUND(x[2], x[7], x[8], x[13]);
+        CHACHA20_QUARTERROUND(x[3], x[4], x[9], x[14]);
+    }
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        state[ctr] = x[ctr];
+    }
+}
+
+#endif
+
+// "expand 32-byte k"
+static const uint32_t chacha20_sigma[4] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+
+static void chacha20_input(uint32_t * j, const uint8_t * k, uint32_t counter, const uint8_t * n)
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        j[i] = chacha20_sigma[i];
+    }
+    for (i = 0; i < 8; i++)
+    {
+        j[4 + i] = load_littleendian(k + 4 * i);
+    }
+    j[12] = counter;
+    for (i = 0; i < 3; i++)
+    {
+        j[13 + i] = load_littleendian(n + 4 * i);
+    }
+}
+
+// Keystream block of the input block j.
+static void chacha20_block(uint32_t * block, const uint32_t * j)
+{
+    int ctr;
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        block[ctr] = j[ctr];
+    }
+
+    crypto_core_chacha20_block(block);
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        block[ctr] += j[ctr];
+    }
+}
+
+// c = m ^ keystream (or the keystream if m is NULL) for len bytes, word-wise if
+// all buffers are 32 bit aligned.
+static void chacha20_xor_keystream(uint8_t * c, const uint8_t * m, const uint8_t * keystream, unsigned int len)
+{
+    unsigned int i = 0;
+
+    if (!m)
+    {
+        memcpy(c, keystream, len);
+        return;
+    }
+
+    if (((uintptr_t)c | (uintptr_t)m | (uintptr_t)keystream) % sizeof(uint32_t) == 0)
+    {
+        for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t))
+        {
+            *(uint32_t *)(c + i) = *(const uint32_t *)(m + i) ^ *(const uint32_t *)(keystream + i);
+        }
+    }
+
+    for (; i < len; ++i)
+    {
+        c[i] = m[i] ^ keystream[i];
+    }
+}
+
+// c = m ^ keystream for d bytes starting with the input block j, whose counter
+// is advanced.
+static void chacha20_xor(uint8_t * c, const uint8_t * m, unsigned int d, uint32_t * j)
+{
+    uint32_t block[16];
+
+#ifdef CRYPTO_HAS_CHACHA20_SIMD
+    if (d >= CHACHA20_SIMD_MIN_BYTES)
+    {
+        unsigned int u = crypto_stream_chacha20_xor_simd(c, m, d, j);
+
+        d -= u;
+        c += u;
+        if (m)
+        {
+            m += u;
+        }
+    }
+#endif
+
+    while (d)
+    {
+        unsigned int len = (d < 64) ? d : 64;
+
+        chacha20_block(block, j);
+        j[12]++;
+        chacha20_xor_keystream(c, m, (const uint8_t *)block, len);
+
+        d -= len;
+        c += len;
+        if (m)
+        {
+            m += len;
+        }
+    }
+
+    memset(block, 0, sizeof(block));
+}
+
+int crypto_stream_chacha20_ietf_xor_ic(uint8_t * c, const uint8_t * m, unsigned int d, const uint8_t * n, uint32_t ic, const uint8_t * k)
+{
+    uint32_t j[16];
+
+    chacha20_input(j, k, ic, n);
+    chacha20_xor(c, m, d, j);
+    memset(j, 0, sizeof(j));
+
+    return 0;
+}
+
+int crypto_stream_chacha20_ietf_xor(uint8_t * c, const uint8_t * m, unsigned int d, const uint8_t * n, const uint8_t * k)
+{
+    return crypto_stream_chacha20_ietf_xor_ic(c, m, d, n, 0, k);
+}
+
+int crypto_stream_chacha20_ietf(uint8_t * c, unsigned int d, const uint8_t * n, const uint8_t * k)
+{
+    return crypto_stream_chacha20_ietf_xor_ic(c, 0, d, n, 0, k);
+}
+
+int crypto_core_hchacha20(uint8_t * out, const uint8_t * in, const uint8_t * k, const uint8_t * c)
+{
+    uint32_t x[16];
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        x[i] = c ? load_littleendian(c + 4 * i) : chacha20_sigma[i];
+    }
+    for (i = 0; i < 8; i++)
+    {
+        x[4 + i] = load_littleendian(k + 4 * i);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        x[12 + i] = load_littleendian(in + 4 * i);
+    }
+
+    crypto_core_chacha20_block(x);
+
+    for (i = 0; i < 4; i++)
+    {
+        store_littleendian(out + 4 * i, x[i]);
+        store_littleendian(out + 16 + 4 * i, x[12 + i]);
+    }
+    memset(x, 0, sizeof(x));
+
+    return 0;
+}
+
+int crypto_stream_xchacha20_xor(uint8_t * c, const uint8_t * m, unsigned int d, const uint8_t * n, const uint8_t * k)
+{
+    uint8_t subkey[32];
+    uint8_t nonce[crypto_stream_chacha20_ietf_NONCEBYTES];
+
+    crypto_core_hchacha20(subkey, n, k, 0);
+    memset(nonce, 0, 4);
+    memcpy(nonce + 4, n + 16, 8);
+    crypto_stream_chacha20_ietf_xor_ic(c, m, d, nonce, 0, subkey);
+    memset(subkey, 0, sizeof(subkey));
+
+    return 0;
+}
+
+int crypto_stream_xchacha20(uint8_t * c, unsigned int d, const uint8_t * n, const uint8_t * k)
+{
+    return crypto_stream_xchacha20_xor(c, 0, d, n, k);
+}
+
+int crypto_stream_chacha20_ietf_xor_chunked_init(chacha20_xor_chunked *context, const uint8_t *n, const uint8_t *k)
+{
+    uint32_t i;
+
+    for (i = 0; i < 8; ++i)
+    {
+        context->key[i] = load_littleendian(k + 4 * i);
+    }
+
+    for (i = 0; i < 3; ++i)
+    {
+        context->nonce[i] = load_littleendian(n + 4 * i);
+    }
+
+    context->counter = 0;
+    context->chunk_bytes_left = 0;
+
+    return 0;
+}
+
+int crypto_stream_chacha20_ietf_xor_chunked(chacha20_xor_chunked *context, uint8_t *c, const uint8_t *m, unsigned int d)
+{
+    uint32_t j[16];
+    uint8_t *block;
+    int i;
+
+    if (!d)
+    {
+        return 0;
+    }
+
+    block = (uint8_t *)(context->block);
+
+    if (context->chunk_bytes_left)
+    {
+        uint32_t e;
+
+        e = context->chunk_bytes_left;
+        if (e > d)
+        {
+            e = d;
+        }
+
+        chacha20_xor_keystream(c, m, block + 64 - context->chunk_bytes_left, e);
+
+        c += e;
+        m += e;
+        d -= e;
+        context->chunk_bytes_left -= e;
+
+        if (!d)
+        {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        j[i] = chacha20_sigma[i];
+    }
+    for (i = 0; i < 8; i++)
+    {
+        j[4 + i] = context->key[i];
+    }
+    j[12] = context->counter;
+    for (i = 0; i < 3; i++)
+    {
+        j[13 + i] = context->nonce[i];
+    }
+
+    // Whole blocks directly, the last partial one through context->block.
+    chacha20_xor(c, m, d & ~63u, j);
+    c += d & ~63u;
+    m += d & ~63u;
+    d &= 63;
+
+    if (d)
+    {
+        chacha20_block(context->block, j);
+        j[12]++;
+        chacha20_xor_keystream(c, m, block, d);
+
+        context->chunk_bytes_left = 64 - d;
+    }
+
+    context->counter = j[12];
+    memset(j, 0, sizeof(j));
+
+    return 0;
+}
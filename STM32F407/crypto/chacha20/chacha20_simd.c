@@ -0,0 +1,255 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file chacha20_simd.c
+
+    ChaCha20 keystream for several consecutive blocks in parallel, organized
+    like salsa20_simd.c: word i of the blocks resides in the lanes of vector
+    x[i], the blocks are transposed back to memory 4x4 words at a time by
+    the store macros of simddefs.h.
+
+    - SSE2 (x86-64) and NEON (AArch64): 4 blocks, 256 bytes.
+    - AVX2: 8 blocks, 512 bytes. Compiled with function level target
+      attributes and selected at runtime, also without SSE2.
+
+    The rotations by 16 and 8 bits are byte permutations where the instruction
+    set has them (AVX2 shuffle, NEON vrev32).
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/chacha20defs.h"
+#include "../include/simddefs.h"
+#include "../include/avx2defs.h"
+
+#ifdef CRYPTO_HAS_CHACHA20_SIMD
+
+#include <stddef.h>
+
+#define CHACHA20_QUARTERROUND(a, b, c, d)  \
+    a = ADD(a, b);                         \
+    d = ROTL16(XOR(d, a));                 \
+    c = ADD(c, d);                         \
+    b = ROTL(XOR(b, c), 12);               \
+    a = ADD(a, b);                         \
+    d = ROTL8(XOR(d, a));                  \
+    c = ADD(c, d);                         \
+    b = ROTL(XOR(b, c), 7);
+
+// Column round followed by diagonal round, see crypto_core_chacha20_block.
+#define CHACHA20_DOUBLEROUND(x)                             \
+    CHACHA20_QUARTERROUND(x[0], x[4], x[8], x[12])          \
+    CHACHA20_QUARTERROUND(x[1], x[5], x[9], x[13])          \
+    CHACHA20_QUARTERROUND(x[2], x[6], x[10], x[14])         \
+    CHACHA20_QUARTERROUND(x[3], x[7], x[11], x[15])         \
+    CHACHA20_QUARTERROUND(x[0], x[5], x[10], x[15])         \
+    CHACHA20_QUARTERROUND(x[1], x[6], x[11], x[12])         \
+    CHACHA20_QUARTERROUND(x[2], x[7], x[8], x[13])          \
+    CHACHA20_QUARTERROUND(x[3], x[4], x[9], x[14])
+
+#ifdef CRYPTO_HAS_SSE2
+
+#define ADD(a, b) _mm_add_epi32(a, b)
+#define XOR(a, b) _mm_xor_si128(a, b)
+#define ROTL(a, r) _mm_or_si128(_mm_slli_epi32(a, r), _mm_srli_epi32(a, 32 - (r)))
+#define ROTL16(a) _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xb1), 0xb1)
+#define ROTL8(a) ROTL(a, 8)
+
+// Four blocks c[0 .. 255] = m[0 .. 255] ^ keystream.
+static void
+chacha20_xor_blocks4_sse2(
+    uint8_t*       c,
+    const uint8_t* m,
+    const uint32_t state[16]
+)
+{
+    __m128i x[16];
+    __m128i j[16];
+    int     i;
+
+    for (i = 0; i < 16; i++)
+    {
+        j[i] = _mm_set1_epi32((int)state[i]);
+    }
+    j[12] = ADD(j[12], _mm_setr_epi32(0, 1, 2, 3));
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = j[i];
+    }
+
+    for (i = 0; i < 10; i++)
+    {
+        CHACHA20_DOUBLEROUND(x);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = ADD(x[i], j[i]);
+    }
+
+    SIMD_SSE2_STORE4(x, 0, c, m);
+    SIMD_SSE2_STORE4(x, 4, c, m);
+    SIMD_SSE2_STORE4(x, 8, c, m);
+    SIMD_SSE2_STORE4(x, 12, c, m);
+}
+
+#define chacha20_xor_blocks4 chacha20_xor_blocks4_sse2
+
+#undef ADD
+#undef XOR
+#undef ROTL
+#undef ROTL16
+#undef ROTL8
+
+#endif // #ifdef CRYPTO_HAS_SSE2
+
+#ifdef CRYPTO_HAS_NEON
+
+#define ADD(a, b) vaddq_u32(a, b)
+#define XOR(a, b) veorq_u32(a, b)
+#define ROTL(a, r) vsriq_n_u32(vshlq_n_u32(a, r), a, 32 - (r))
+#define ROTL16(a) vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(a)))
+#define ROTL8(a) ROTL(a, 8)
+
+// Four blocks c[0 .. 255] = m[0 .. 255] ^ keystream.
+static void
+chacha20_xor_blocks4_neon(
+    uint8_t*       c,
+    const uint8_t* m,
+    const uint32_t state[16]
+)
+{
+    static const uint32_t lanes[4] = { 0, 1, 2, 3 };
+    uint32x4_t            x[16];
+    uint32x4_t            j[16];
+    int                   i;
+
+    for (i = 0; i < 16; i++)
+    {
+        j[i] = vdupq_n_u32(state[i]);
+    }
+    j[12] = ADD(j[12], vld1q_u32(lanes));
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = j[i];
+    }
+
+    for (i = 0; i < 10; i++)
+    {
+        CHACHA20_DOUBLEROUND(x);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = ADD(x[i], j[i]);
+    }
+
+    SIMD_NEON_STORE4(x, 0, c, m);
+    SIMD_NEON_STORE4(x, 4, c, m);
+    SIMD_NEON_STORE4(x, 8, c, m);
+    SIMD_NEON_STORE4(x, 12, c, m);
+}
+
+#define chacha20_xor_blocks4 chacha20_xor_blocks4_neon
+
+#undef ADD
+#undef XOR
+#undef ROTL
+#undef ROTL16
+#undef ROTL8
+
+#endif // #ifdef CRYPTO_HAS_NEON
+
+#ifdef CRYPTO_HAS_AVX2
+
+#define ADD(a, b) _mm256_add_epi32(a, b)
+#define XOR(a, b) _mm256_xor_si256(a, b)
+#define ROTL(a, r) _mm256_or_si256(_mm256_slli_epi32(a, r), _mm256_srli_epi32(a, 32 - (r)))
+#define ROTL16(a) _mm256_shuffle_epi8(a, rot16)
+#define ROTL8(a) _mm256_shuffle_epi8(a, rot8)
+
+// Eight blocks c[0 .. 511] = m[0 .. 511] ^ keystream.
+static AVX2_FUNCTION void
+chacha20_xor_blocks8_avx2(
+    uint8_t*       c,
+    const uint8_t* m,
+    const uint32_t state[16]
+)
+{
+    const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                          3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    __m256i       x[16];
+    __m256i       j[16];
+    int           i;
+
+    for (i = 0; i < 16; i++)
+    {
+        j[i] = _mm256_set1_epi32((int)state[i]);
+    }
+    j[12] = ADD(j[12], _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = j[i];
+    }
+
+    for (i = 0; i < 10; i++)
+    {
+        CHACHA20_DOUBLEROUND(x);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        x[i] = ADD(x[i], j[i]);
+    }
+
+    SIMD_AVX2_STORE8(x, 0, c, m);
+    SIMD_AVX2_STORE8(x, 8, c, m);
+}
+
+#undef ADD
+#undef XOR
+#undef ROTL
+#undef ROTL16
+#undef ROTL8
+
+#endif // #ifdef CRYPTO_HAS_AVX2
+
+unsigned int
+crypto_stream_chacha20_xor_simd(
+    uint8_t*       c,
+    const uint8_t* m,
+    unsigned int   len,
+    uint32_t       state[16]
+)
+{
+    unsigned int done = 0;
+
+#ifdef CRYPTO_HAS_AVX2
+    if ((len >= 8 * 64) && crypto_cpu_has_avx2())
+    {
+        while (len - done >= 8 * 64)
+        {
+            chacha20_xor_blocks8_avx2(c + done, m ? (m + done) : NULL, state);
+            state[12] += 8;
+            done += 8 * 64;
+        }
+    }
+#endif
+
+#ifdef chacha20_xor_blocks4
+    while (len - done >= 4 * 64)
+    {
+        chacha20_xor_blocks4(c + done, m ? (m + done) : NULL, state);
+        state[12] += 4;
+        done += 4 * 64;
+    }
+#endif
+    return done;
+}
+
+#endif // #ifdef CRYPTO_HAS_CHACHA20_SIMD
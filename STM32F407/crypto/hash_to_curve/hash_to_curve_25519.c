@@ -0,0 +1,388 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file hash_to_curve_25519.c
+
+    RFC 9380 suites curve25519_XMD:SHA-512_ELL2_RO_ and _NU_.
+
+    The Elligator2 map is the straight-line variant of RFC 9380 G.2.1: like
+    fe25519_elligator2_isrt.c it needs a single exponentiation (by
+    (p - 5) / 8 = 2^252 - 3), which here also yields the v coordinate. The
+    result stays a fraction u = xn / xd. The points are then moved to
+    edwards25519 (RFC 9380 G.2.2), added and multiplied by the cofactor with
+    the complete formulas of ge25519.c, and mapped back. This needs one
+    inversion in total for hash_to_curve instead of one per map plus one for
+    the affine addition: 1 / ((Z - Y).X) yields both denominators of
+    u = (Z + Y) / (Z - Y) and v = sqrt(-486664).u.Z / X.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_hash_to_curve.h"
+#include "../include/crypto_hash.h"
+#include "../include/ge25519.h"
+
+// Length of one field element in hash_to_field, L = ceil((255 + 128) / 8).
+#define HASH_TO_FIELD_BYTES 48
+
+// 2^((p + 3) / 8), packed little endian.
+static const uint8_t h2c_twoPowC1_packed[32] =
+{
+    0xb1, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b
+};
+
+// sqrt(-486664) with sgn0 = 0, packed little endian.
+static const uint8_t h2c_sqrtMinus486664_packed[32] =
+{
+    0x06, 0x7e, 0x45, 0xff, 0xaa, 0x04, 0x6e, 0xcc, 0x82, 0x1a, 0x7d, 0x4b, 0xd1, 0xd3, 0xa1, 0xc5,
+    0x7e, 0x4f, 0xfc, 0x03, 0xdc, 0x08, 0x7b, 0xd2, 0xbb, 0x06, 0xa0, 0x60, 0xf4, 0xed, 0x26, 0x0f
+};
+
+static const uint8_t h2c_oversizeDstPrefix[] = "H2C-OVERSIZE-DST-";
+
+int
+crypto_expand_message_xmd_sha512(
+    uint8_t*           out,
+    size_t             outlen,
+    const uint8_t*     msg,
+    unsigned long long msglen,
+    const uint8_t*     dst,
+    size_t             dstlen
+)
+{
+    crypto_hash_sha512_state state;
+    uint8_t                  dstHash[crypto_hash_sha512_BYTES];
+    uint8_t                  b0[crypto_hash_sha512_BYTES];
+    uint8_t                  bi[crypto_hash_sha512_BYTES];
+    uint8_t                  tmp[crypto_hash_sha512_BLOCKBYTES];
+    uint8_t                  dstLenByte;
+    size_t                   ell, i, j;
+
+    ell = (outlen + crypto_hash_sha512_BYTES - 1) / crypto_hash_sha512_BYTES;
+    if ((ell > 255) || (outlen > 65535) || (dstlen == 0))
+    {
+        return -1;
+    }
+
+    if (dstlen > 255)
+    {
+        crypto_hash_sha512_init(&state);
+        crypto_hash_sha512_update(&state, h2c_oversizeDstPrefix, sizeof(h2c_oversizeDstPrefix) - 1);
+        crypto_hash_sha512_update(&state, dst, dstlen);
+        crypto_hash_sha512_final(&state, dstHash);
+        dst = dstHash;
+        dstlen = sizeof(dstHash);
+    }
+    dstLenByte = (uint8_t)dstlen;
+
+    // b_0 = H(Z_pad || msg || I2OSP(outlen, 2) || I2OSP(0, 1) || DST_prime)
+    memset(tmp, 0, sizeof(tmp));
+    crypto_hash_sha512_init(&state);
+    crypto_hash_sha512_update(&state, tmp, crypto_hash_sha512_BLOCKBYTES);
+    crypto_hash_sha512_update(&state, msg, msglen);
+    tmp[0] = (uint8_t)(outlen >> 8);
+    tmp[1] = (uint8_t)outlen;
+    tmp[2] = 0;
+    crypto_hash_sha512_update(&state, tmp, 3);
+    crypto_hash_sha512_update(&state, dst, dstlen);
+    crypto_hash_sha512_update(&state, &dstLenByte, 1);
+    crypto_hash_sha512_final(&state, b0);
+
+    // b_i = H((b_0 ^ b_(i - 1)) || I2OSP(i, 1) || DST_prime), b_1 = H(b_0 || ...)
+    memcpy(tmp, b0, sizeof(b0));
+    for (i = 1; i <= ell; i++)
+    {
+        size_t len = outlen - (i - 1) * crypto_hash_sha512_BYTES;
+
+        tmp[crypto_hash_sha512_BYTES] = (uint8_t)i;
+        crypto_hash_sha512_init(&state);
+        crypto_hash_sha512_update(&state, tmp, crypto_hash_sha512_BYTES + 1);
+        crypto_hash_sha512_update(&state, dst, dstlen);
+        crypto_hash_sha512_update(&state, &dstLenByte, 1);
+        crypto_hash_sha512_final(&state, bi);
+
+        if (len > crypto_hash_sha512_BYTES)
+        {
+            len = crypto_hash_sha512_BYTES;
+        }
+        memcpy(out, bi, len);
+        out += len;
+
+        for (j = 0; j < crypto_hash_sha512_BYTES; j++)
+        {
+            tmp[j] = b0[j] ^ bi[j];
+        }
+    }
+
+    memset(b0, 0, sizeof(b0));
+    memset(bi, 0, sizeof(bi));
+    memset(tmp, 0, sizeof(tmp));
+    memset(&state, 0, sizeof(state));
+
+    return 0;
+}
+
+// r = OS2IP(in[0 .. 47]) mod p. With in = a + 2^255.b: r = a + 19.b
+static void
+h2c_field_from_48bytes(
+    fe25519*      r,
+    const uint8_t in[HASH_TO_FIELD_BYTES]
+)
+{
+    uint8_t le[HASH_TO_FIELD_BYTES + 1];
+    uint8_t hi[32];
+    fe25519 a, b, nineteen, t;
+    int     i;
+
+    for (i = 0; i < HASH_TO_FIELD_BYTES; i++)
+    {
+        le[i] = in[HASH_TO_FIELD_BYTES - 1 - i];
+    }
+    le[HASH_TO_FIELD_BYTES] = 0;
+
+    memset(hi, 0, sizeof(hi));
+    for (i = 0; i < HASH_TO_FIELD_BYTES - 31; i++)
+    {
+        hi[i] = (uint8_t)((le[31 + i] >> 7) | (le[32 + i] << 1));
+    }
+
+    fe25519_unpack(&a, le); // clears bit #255
+    fe25519_unpack(&b, hi);
+    memset(hi, 0, sizeof(hi));
+    hi[0] = 19;
+    fe25519_unpack(&nineteen, hi);
+    fe25519_mul(&t, &b, &nineteen);
+    fe25519_add(r, &a, &t);
+
+    memset(le, 0, sizeof(le));
+}
+
+// Returns sgn0(a), i.e. the parity of the fully reduced value.
+static int
+h2c_sgn0(
+    const fe25519* a
+)
+{
+    fe25519 t;
+
+    fe25519_cpy(&t, a);
+    return (int)fe25519_getparity(&t);
+}
+
+// map_to_curve_elligator2_curve25519 of RFC 9380 G.2.1: u = xn / xd, v = y.
+static void
+h2c_map_to_curve_elligator2(
+    fe25519*       xn,
+    fe25519*       xd,
+    fe25519*       y,
+    const fe25519* r
+)
+{
+    fe25519 tv1, tv2, tv3, x1n, x2n, gxd, gx1, gx2, y11, y12, y21, y22, y1, y2, t;
+    fe25519 sqrtMinusOne, twoPowC1;
+    int     e1, e2, e3, e4;
+
+    fe25519_unpack(&sqrtMinusOne, fe25519_sqrtMinusOne_packed);
+    fe25519_unpack(&twoPowC1, h2c_twoPowC1_packed);
+
+    fe25519_square(&t, r);
+    fe25519_add(&tv1, &t, &t);            // tv1 = 2.r^2
+    fe25519_add(xd, &tv1, &fe25519_one);  // xd = 1 + 2.r^2, nonzero as 2 is no square
+    fe25519_cpy(&x1n, &fe25519_minusA);   // x1 = x1n / xd
+    fe25519_square(&tv2, xd);
+    fe25519_mul(&gxd, &tv2, xd);          // gxd = xd^3
+    fe25519_mul(&t, &fe25519_minusA, &tv1);
+    fe25519_neg(&gx1, &t);                // A.tv1 = x1n + A.xd
+    fe25519_mul(&t, &gx1, &x1n);          // x1n^2 + A.x1n.xd
+    fe25519_add(&gx1, &t, &tv2);          // x1n^2 + A.x1n.xd + xd^2
+    fe25519_mul(&t, &gx1, &x1n);
+    fe25519_cpy(&gx1, &t);                // gx1 = x1n^3 + A.x1n^2.xd + x1n.xd^2
+    fe25519_square(&tv3, &gxd);
+    fe25519_square(&tv2, &tv3);           // gxd^4
+    fe25519_mul(&t, &tv3, &gxd);          // gxd^3
+    fe25519_mul(&tv3, &t, &gx1);          // gx1.gxd^3
+    fe25519_mul(&t, &tv2, &tv3);          // gx1.gxd^7
+    fe25519_pow2523(&tv2, &t);            // (gx1.gxd^7)^((p - 5) / 8)
+    fe25519_mul(&y11, &tv2, &tv3);
+    fe25519_mul(&y12, &y11, &sqrtMinusOne);
+    fe25519_square(&t, &y11);
+    fe25519_mul(&tv2, &t, &gxd);
+    e1 = fe25519_iseq(&tv2, &gx1);
+    fe25519_cpy(&y1, &y12);
+    fe25519_cmov(&y1, &y11, e1);          // sqrt(gx1 / gxd) if it is a square
+
+    fe25519_mul(&x2n, &x1n, &tv1);        // x2 = x2n / xd = 2.r^2.x1n / xd
+    fe25519_mul(&t, &y11, r);
+    fe25519_mul(&y21, &t, &twoPowC1);
+    fe25519_mul(&y22, &y21, &sqrtMinusOne);
+    fe25519_mul(&gx2, &gx1, &tv1);        // g(x2) = 2.r^2.g(x1)
+    fe25519_square(&t, &y21);
+    fe25519_mul(&tv2, &t, &gxd);
+    e2 = fe25519_iseq(&tv2, &gx2);
+    fe25519_cpy(&y2, &y22);
+    fe25519_cmov(&y2, &y21, e2);          // sqrt(gx2 / gxd) if it is a square
+
+    fe25519_square(&t, &y1);
+    fe25519_mul(&tv2, &t, &gxd);
+    e3 = fe25519_iseq(&tv2, &gx1);
+    fe25519_cpy(xn, &x2n);
+    fe25519_cmov(xn, &x1n, e3);
+    fe25519_cpy(y, &y2);
+    fe25519_cmov(y, &y1, e3);
+    e4 = h2c_sgn0(y);
+    fe25519_neg(&t, y);
+    fe25519_cmov(y, &t, e3 ^ e4);         // sgn0(y) = e3
+}
+
+// Elligator2 map to curve25519 and the rational map to edwards25519 of RFC 9380
+// G.2.2, including the mapping of the exceptional point (0, 0) to the neutral
+// element. Both differ by a point of order 2, which is removed by the cofactor.
+static void
+h2c_map_to_edwards(
+    ge25519_p3*    p,
+    const fe25519* r
+)
+{
+    fe25519 un, ud, v, xn, xd, yn, yd, t, zero, sqrtMinus486664;
+    int     exceptional;
+
+    h2c_map_to_curve_elligator2(&un, &ud, &v, r);
+
+    fe25519_unpack(&sqrtMinus486664, h2c_sqrtMinus486664_packed);
+    fe25519_mul(&xn, &un, &sqrtMinus486664); // x = sqrt(-486664).u / v
+    fe25519_mul(&xd, &ud, &v);
+    fe25519_sub(&yn, &un, &ud);              // y = (u - 1) / (u + 1)
+    fe25519_add(&yd, &un, &ud);
+
+    fe25519_mul(&t, &xd, &yd);
+    exceptional = fe25519_iszero_01(&t);
+    fe25519_setzero(&zero);
+    fe25519_cmov(&xn, &zero, exceptional);
+    fe25519_cmov(&xd, &fe25519_one, exceptional);
+    fe25519_cmov(&yn, &fe25519_one, exceptional);
+    fe25519_cmov(&yd, &fe25519_one, exceptional);
+
+    fe25519_mul(&p->x, &xn, &yd);
+    fe25519_mul(&p->y, &yn, &xd);
+    fe25519_mul(&p->z, &xd, &yd);
+    fe25519_mul(&p->t, &xn, &yn);
+}
+
+// r = 8.p
+static void
+h2c_clear_cofactor(
+    ge25519_p3*       r,
+    const ge25519_p3* p
+)
+{
+    ge25519_p2   t2;
+    ge25519_p1p1 t;
+
+    ge25519_p3_to_p2(&t2, p);
+    ge25519_dbl_p1p1(&t, &t2);
+    ge25519_p1p1_to_p2(&t2, &t);
+    ge25519_dbl_p1p1(&t, &t2);
+    ge25519_p1p1_to_p2(&t2, &t);
+    ge25519_dbl_p1p1(&t, &t2);
+    ge25519_p1p1_to_p3(r, &t);
+}
+
+// Maps p back to curve25519: u = (Z + Y) / (Z - Y), v = sqrt(-486664).u.Z / X
+// with the single inversion of (Z - Y).X. The neutral element, which is only
+// reached with negligible probability, yields (0, 0).
+static void
+h2c_to_montgomery(
+    uint8_t*          u,
+    uint8_t*          v,
+    const ge25519_p3* p
+)
+{
+    fe25519 zPlusY, zMinusY, den, inv, t, r, sqrtMinus486664;
+
+    fe25519_add(&zPlusY, &p->z, &p->y);
+    fe25519_sub(&zMinusY, &p->z, &p->y);
+    fe25519_mul(&den, &zMinusY, &p->x);
+    fe25519_invert(&inv, &den);
+    fe25519_mul(&t, &zPlusY, &inv);
+
+    fe25519_mul(&r, &t, &p->x);
+    fe25519_pack(u, &r);
+
+    if (v)
+    {
+        fe25519_unpack(&sqrtMinus486664, h2c_sqrtMinus486664_packed);
+        fe25519_mul(&r, &t, &p->z);
+        fe25519_mul(&t, &r, &sqrtMinus486664);
+        fe25519_pack(v, &t);
+    }
+}
+
+int
+crypto_hash_to_curve_curve25519_xmd_sha512_ell2_ro(
+    uint8_t*           u,
+    uint8_t*           v,
+    const uint8_t*     msg,
+    unsigned long long msglen,
+    const uint8_t*     dst,
+    size_t             dstlen
+)
+{
+    uint8_t        uniform[2 * HASH_TO_FIELD_BYTES];
+    fe25519        r0, r1;
+    ge25519_p3     q0, q1, p;
+    ge25519_cached q1Cached;
+    ge25519_p1p1   t;
+
+    if (crypto_expand_message_xmd_sha512(uniform, sizeof(uniform), msg, msglen, dst, dstlen) != 0)
+    {
+        return -1;
+    }
+    h2c_field_from_48bytes(&r0, uniform);
+    h2c_field_from_48bytes(&r1, uniform + HASH_TO_FIELD_BYTES);
+
+    h2c_map_to_edwards(&q0, &r0);
+    h2c_map_to_edwards(&q1, &r1);
+
+    ge25519_p3_to_cached(&q1Cached, &q1);
+    ge25519_add_p1p1(&t, &q0, &q1Cached);
+    ge25519_p1p1_to_p3(&p, &t);
+    h2c_clear_cofactor(&p, &p);
+
+    h2c_to_montgomery(u, v, &p);
+
+    memset(uniform, 0, sizeof(uniform));
+    return 0;
+}
+
+int
+crypto_encode_to_curve_curve25519_xmd_sha512_ell2_nu(
+    uint8_t*           u,
+    uint8_t*           v,
+    const uint8_t*     msg,
+    unsigned long long msglen,
+    const uint8_t*     dst,
+    size_t             dstlen
+)
+{
+    uint8_t    uniform[HASH_TO_FIELD_BYTES];
+    fe25519    r;
+    ge25519_p3 p;
+
+    if (crypto_expand_message_xmd_sha512(uniform, sizeof(uniform), msg, msglen, dst, dstlen) != 0)
+    {
+        return -1;
+    }
+    h2c_field_from_48bytes(&r, uniform);
+
+    h2c_map_to_edwards(&p, &r);
+    h2c_clear_cofactor(&p, &p);
+
+    h2c_to_montgomery(u, v, &p);
+
+    memset(uniform, 0, sizeof(uniform));
+    return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef LOCAL_AVX2_HEADER_
+#define LOCAL_AVX2_HEADER_
+
+#include "../include/crypto_target_config.h"
+
+#ifdef CRYPTO_HAS_AVX2
+
+#include <immintrin.h>
+
+// The AVX2 kernels are compiled with function level target attributes, the
+// callers check for AVX2 support at runtime with crypto_cpu_has_avx2().
+#define AVX2_FUNCTION __attribute__ ((__target__ ("avx2")))
+#define AVX2_INLINE inline __attribute__ ((__always_inline__, __target__ ("avx2")))
+
+#endif
+
+#endif // #ifndef LOCAL_AVX2_HEADER_
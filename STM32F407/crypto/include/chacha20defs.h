@@ -0,0 +1,33 @@
+#ifndef LOCAL_CHACHA20_HEADER_
+#define LOCAL_CHACHA20_HEADER_
+
+#include <stdint.h>
+#include "../include/crypto_stream.h"
+
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_NEON) || defined(CRYPTO_HAS_AVX2)
+
+#define CRYPTO_HAS_CHACHA20_SIMD
+
+// Remaining length from which on the stream functions use the vector kernels.
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_NEON)
+#define CHACHA20_SIMD_MIN_BYTES 256
+#else
+#define CHACHA20_SIMD_MIN_BYTES 512
+#endif
+
+/// Computes c = m ^ keystream for the largest multiple of 4 blocks in len, or
+/// writes the keystream if m is NULL. With AVX2 as the only vector extension
+/// the largest multiple of 8 blocks, none on CPUs without AVX2. state is the
+/// ChaCha20 input block in host order, its block counter (word 12) is advanced
+/// modulo 2^32. Returns the number of bytes processed.
+unsigned int
+crypto_stream_chacha20_xor_simd(
+    uint8_t*       c,
+    const uint8_t* m,
+    unsigned int   len,
+    uint32_t       state[16]
+);
+
+#endif
+
+#endif // #ifndef LOCAL_CHACHA20_HEADER_
@@ -0,0 +1,17 @@
+#ifndef LOCAL_CPACE_HEADER_
+#define LOCAL_CPACE_HEADER_
+
+#include <stdint.h>
+#include "../include/crypto_pake.h"
+
+/// crypto_cpace_share with the ephemeral scalar y given by the caller instead
+/// of sampled, for known answer tests only. A scalar must never be used for
+/// two sessions.
+int
+crypto_cpace_share_scalar(
+    crypto_cpace_session* session,
+    uint8_t*              Y,
+    const uint8_t*        y
+);
+
+#endif // #ifndef LOCAL_CPACE_HEADER_
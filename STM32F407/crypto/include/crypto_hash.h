@@ -0,0 +1,76 @@
+#ifndef CRYPTO_HASH_H
+#define CRYPTO_HASH_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+
+#define crypto_hash crypto_hash_sha512
+#define crypto_hash_BYTES crypto_hash_sha512_BYTES
+
+#define crypto_hash_sha512_BYTES 64
+#define crypto_hash_sha512_BLOCKBYTES 128
+
+typedef struct
+{
+    uint64_t state[8];
+    uint64_t count;     // number of bytes hashed so far
+    uint8_t  buffer[crypto_hash_sha512_BLOCKBYTES];
+} crypto_hash_sha512_state;
+
+int
+crypto_hash_sha512(uint8_t *out,const uint8_t *in,unsigned long long inlen);
+
+int
+crypto_hash_sha512_init(crypto_hash_sha512_state *state);
+
+int
+crypto_hash_sha512_update(crypto_hash_sha512_state *state,const uint8_t *in,unsigned long long inlen);
+
+int
+crypto_hash_sha512_final(crypto_hash_sha512_state *state,uint8_t *out);
+
+/// Absorbs in[k] into state[k] and writes its digest to out + 64 k for k < n,
+/// i.e. crypto_hash_sha512_update() and crypto_hash_sha512_final() for each
+/// state. On hosts with AVX2, four states at a time are compressed in
+/// parallel.
+int
+crypto_hash_sha512_update_final_batch(crypto_hash_sha512_state state[],uint8_t *out,
+                                      const uint8_t *const in[],const unsigned long long inlen[],size_t n);
+
+/// Hashes the n messages in[k] of inlen[k] bytes to out + 64 k.
+int
+crypto_hash_sha512_batch(uint8_t *out,const uint8_t *const in[],const unsigned long long inlen[],size_t n);
+
+/// Compression function: processes nblocks blocks of 128 bytes.
+/// This is the function to be replaced by target specific implementations.
+void
+crypto_hashblocks_sha512(uint64_t state[8],const uint8_t *in,size_t nblocks);
+
+#define crypto_hash_sha256_BYTES 32
+#define crypto_hash_sha256_BLOCKBYTES 64
+
+typedef struct
+{
+    uint32_t state[8];
+    uint64_t count;     // number of bytes hashed so far
+    uint8_t  buffer[crypto_hash_sha256_BLOCKBYTES];
+} crypto_hash_sha256_state;
+
+int
+crypto_hash_sha256(uint8_t *out,const uint8_t *in,unsigned long long inlen);
+
+int
+crypto_hash_sha256_init(crypto_hash_sha256_state *state);
+
+int
+crypto_hash_sha256_update(crypto_hash_sha256_state *state,const uint8_t *in,unsigned long long inlen);
+
+int
+crypto_hash_sha256_final(crypto_hash_sha256_state *state,uint8_t *out);
+
+/// Compression function: processes nblocks blocks of 64 bytes.
+void
+crypto_hashblocks_sha256(uint32_t state[8],const uint8_t *in,size_t nblocks);
+
+#endif
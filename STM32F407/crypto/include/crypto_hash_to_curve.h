@@ -0,0 +1,37 @@
+#ifndef CRYPTO_HASH_TO_CURVE_H
+#define CRYPTO_HASH_TO_CURVE_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+
+#define crypto_hash_to_curve_curve25519 crypto_hash_to_curve_curve25519_xmd_sha512_ell2_ro
+#define crypto_encode_to_curve_curve25519 crypto_encode_to_curve_curve25519_xmd_sha512_ell2_nu
+
+#define crypto_hash_to_curve_curve25519_BYTES 32
+
+/// expand_message_xmd of RFC 9380 with SHA-512. Domain separation tags longer
+/// than 255 bytes are hashed as specified. Returns -1 if outlen exceeds 255
+/// blocks of 64 bytes or if dstlen is 0, 0 otherwise.
+int
+crypto_expand_message_xmd_sha512(uint8_t *out,size_t outlen,
+                                 const uint8_t *msg,unsigned long long msglen,
+                                 const uint8_t *dst,size_t dstlen);
+
+/// hash_to_curve with the suite curve25519_XMD:SHA-512_ELL2_RO_ of RFC 9380.
+/// Writes the coordinates (u, v) of the point on curve25519, fully reduced and
+/// little endian. v may be NULL. Returns -1 if dstlen is 0, 0 otherwise.
+/// Constant time with respect to msg.
+int
+crypto_hash_to_curve_curve25519_xmd_sha512_ell2_ro(uint8_t *u,uint8_t *v,
+                                                   const uint8_t *msg,unsigned long long msglen,
+                                                   const uint8_t *dst,size_t dstlen);
+
+/// encode_to_curve with the suite curve25519_XMD:SHA-512_ELL2_NU_ of RFC 9380,
+/// same conventions as crypto_hash_to_curve_curve25519_xmd_sha512_ell2_ro.
+int
+crypto_encode_to_curve_curve25519_xmd_sha512_ell2_nu(uint8_t *u,uint8_t *v,
+                                                     const uint8_t *msg,unsigned long long msglen,
+                                                     const uint8_t *dst,size_t dstlen);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef CRYPTO_ONETIMEAUTH_H
+#define CRYPTO_ONETIMEAUTH_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+
+#define crypto_onetimeauth crypto_onetimeauth_poly1305
+#define crypto_onetimeauth_verify crypto_onetimeauth_poly1305_verify
+#define crypto_onetimeauth_BYTES crypto_onetimeauth_poly1305_BYTES
+#define crypto_onetimeauth_KEYBYTES crypto_onetimeauth_poly1305_KEYBYTES
+
+#define crypto_onetimeauth_poly1305_BYTES 16
+#define crypto_onetimeauth_poly1305_KEYBYTES 32
+#define crypto_onetimeauth_poly1305_BLOCKBYTES 16
+
+/// The accumulator h and the key r use three limbs of 44, 44 and 42 bits with
+/// CRYPTO_HAS_POLY1305_RADIX44 and five limbs of 26 bits otherwise.
+typedef struct
+{
+#ifdef CRYPTO_HAS_POLY1305_RADIX44
+    uint64_t r[3];
+    uint64_t h[3];
+#else
+    uint32_t r[5];
+    uint32_t h[5];
+#endif
+    uint32_t pad[4];
+    uint32_t leftover;  // number of bytes in buffer
+    uint8_t  buffer[crypto_onetimeauth_poly1305_BLOCKBYTES];
+} crypto_onetimeauth_poly1305_state;
+
+int
+crypto_onetimeauth_poly1305(uint8_t *out,const uint8_t *in,unsigned long long inlen,const uint8_t *k);
+
+/// Returns 0 if h is the authenticator of in under k and -1 otherwise. Constant time.
+int
+crypto_onetimeauth_poly1305_verify(const uint8_t *h,const uint8_t *in,unsigned long long inlen,const uint8_t *k);
+
+int
+crypto_onetimeauth_poly1305_init(crypto_onetimeauth_poly1305_state *state,const uint8_t *k);
+
+int
+crypto_onetimeauth_poly1305_update(crypto_onetimeauth_poly1305_state *state,const uint8_t *in,unsigned long long inlen);
+
+/// Writes the authenticator to out and clears the state.
+int
+crypto_onetimeauth_poly1305_final(crypto_onetimeauth_poly1305_state *state,uint8_t *out);
+
+#endif
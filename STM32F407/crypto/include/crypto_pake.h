@@ -0,0 +1,129 @@
+#ifndef CRYPTO_PAKE_H
+#define CRYPTO_PAKE_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+#include "crypto_hash.h"
+
+// CPace (draft-irtf-cfrg-cpace, CPACE-X25519-SHA512) and the augmentation
+// layer of AuCPace (draft-haase-aucpace). Sessions are slots of an arena in
+// memory owned by the caller, no heap is used.
+//
+// Message flow, with the AuCPace augmentation in front of CPace:
+//
+//   client (initiator)                       server (responder)
+//                                            crypto_aucpace_server_augment -> X
+//   crypto_aucpace_client_augment(w, X)
+//   crypto_aucpace_generator                 crypto_aucpace_generator
+//   crypto_cpace_share -> Ya                 crypto_cpace_share -> Yb
+//   crypto_cpace_finish(Yb) -> ISK           crypto_cpace_finish(Ya) -> ISK
+//
+// Plain CPace starts with crypto_cpace_generator and the password related
+// string PRS on both sides.
+
+#define crypto_cpace_BYTES 32      // shares Ya, Yb and AuCPace values X, W, w
+#define crypto_cpace_ISKBYTES 64
+
+#define crypto_cpace_INITIATOR 0
+#define crypto_cpace_RESPONDER 1
+
+/// Session states. Each call advances the state by one step and returns -1
+/// without further effect if the session is not in the state it expects.
+#define crypto_cpace_STATE_FREE 0
+#define crypto_cpace_STATE_OPEN 1
+#define crypto_cpace_STATE_AUGMENTED 2
+#define crypto_cpace_STATE_GENERATOR 3
+#define crypto_cpace_STATE_SHARED 4
+#define crypto_cpace_STATE_DONE 5
+#define crypto_cpace_STATE_FAILED 6
+
+/// Phases with separate timings in crypto_cpace_session.cycles.
+#define crypto_cpace_PHASE_AUGMENT 0   // AuCPace: X or PRS
+#define crypto_cpace_PHASE_GENERATOR 1 // generator string hash and Elligator2
+#define crypto_cpace_PHASE_SHARE 2     // ephemeral scalar and share
+#define crypto_cpace_PHASE_FINISH 3    // shared secret ladder and ISK
+#define crypto_cpace_PHASES 4
+
+/// Time source for the phase timings, e.g. the DWT cycle counter on the
+/// device or rdtsc on hosts. May be NULL.
+typedef uint64_t (*crypto_pake_clock)(void);
+
+typedef struct
+{
+    uint32_t                 state;
+    uint32_t                 role;
+    crypto_pake_clock        clock;                     // of the arena
+    uint8_t                  prs[crypto_cpace_BYTES];   // AuCPace PRS
+    uint8_t                  g[crypto_cpace_BYTES];     // generator
+    uint8_t                  y[crypto_cpace_BYTES];     // ephemeral scalar
+    uint8_t                  Y[crypto_cpace_BYTES];     // own share
+    crypto_hash_sha512_state isk;                       // ISK hash, absorbs the prefix up to sid
+    uint64_t                 cycles[crypto_cpace_PHASES];
+} crypto_cpace_session;
+
+typedef struct
+{
+    crypto_cpace_session* sessions;
+    size_t                capacity;
+    crypto_pake_clock     clock;
+} crypto_pake_arena;
+
+/// Number of bytes of arena memory needed for n sessions.
+#define crypto_pake_ARENABYTES(n) ((n) * sizeof(crypto_cpace_session) + sizeof(uint64_t))
+
+/// Places as many sessions as fit into memory[0 .. size - 1], all free.
+/// Returns the number of sessions.
+size_t
+crypto_pake_arena_init(crypto_pake_arena *arena,void *memory,size_t size,crypto_pake_clock clock);
+
+/// Returns a free session for the role crypto_cpace_INITIATOR or
+/// crypto_cpace_RESPONDER, or NULL if all are in use.
+crypto_cpace_session*
+crypto_pake_session_open(crypto_pake_arena *arena,uint32_t role);
+
+/// Erases the session and returns it to the arena. Sessions of other arenas
+/// are left untouched.
+void
+crypto_pake_session_close(crypto_pake_arena *arena,crypto_cpace_session *session);
+
+/// CPace: derives the generator from the password related string prs, the
+/// channel identifier ci and the session id sid.
+int
+crypto_cpace_generator(crypto_cpace_session *session,const uint8_t *prs,size_t prslen,
+                       const uint8_t *ci,size_t cilen,const uint8_t *sid,size_t sidlen);
+
+/// Samples the ephemeral scalar and writes the own share Y.
+int
+crypto_cpace_share(crypto_cpace_session *session,uint8_t *Y);
+
+/// Computes the shared secret with the share of the peer and the
+/// intermediate session key ISK over the transcript ordered by role. ad and
+/// adPeer are the associated data sent along with the own and the peer's
+/// share. Returns -1 and fails the session if the shared secret is zero,
+/// i.e. Ypeer is of small order.
+int
+crypto_cpace_finish(crypto_cpace_session *session,uint8_t *isk,const uint8_t *Ypeer,
+                    const uint8_t *ad,size_t adlen,const uint8_t *adPeer,size_t adPeerlen);
+
+/// AuCPace registration: verifier W = w.B of the password derived scalar w,
+/// w = PBKDF(password, user, salt) as chosen by the application, e.g.
+/// crypto_pwhash_scryptsalsa208sha256_ll of crypto_pwhash.h.
+int
+crypto_aucpace_verifier(uint8_t *W,const uint8_t *w);
+
+/// AuCPace server: writes X = x.B for a fresh x and keeps PRS = x.W.
+int
+crypto_aucpace_server_augment(crypto_cpace_session *session,uint8_t *X,const uint8_t *W);
+
+/// AuCPace client: keeps PRS = w.X. Returns -1 and fails the session if X
+/// is of small order.
+int
+crypto_aucpace_client_augment(crypto_cpace_session *session,const uint8_t *w,const uint8_t *X);
+
+/// crypto_cpace_generator with the PRS of the augmentation.
+int
+crypto_aucpace_generator(crypto_cpace_session *session,const uint8_t *ci,size_t cilen,
+                         const uint8_t *sid,size_t sidlen);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef CRYPTO_PWHASH_H
+#define CRYPTO_PWHASH_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+
+// scrypt (RFC 7914) with Salsa20/8 and PBKDF2-HMAC-SHA256, e.g. for deriving
+// the AuCPace password scalar w of crypto_pake.h. The work memory is owned by
+// the caller, no heap is used.
+
+/// Upper bound for the threads of crypto_pwhash_scryptsalsa208sha256_ll.
+#define crypto_pwhash_scryptsalsa208sha256_THREADSMAX 16
+
+/// Number of bytes of work memory for the cost parameters N, r and p, if the
+/// p lanes are processed by the given number of threads: the p lanes of
+/// 128 r bytes and for each thread N + 2 blocks of 128 r bytes.
+#define crypto_pwhash_scryptsalsa208sha256_MEMORYBYTES(N, r, p, threads) \
+    (((size_t)(p) + (size_t)(threads) * ((size_t)(N) + 2)) * 128 * (size_t)(r) + 64)
+
+/// Derives buf[0 .. buflen - 1] from the password and the salt. N is a power
+/// of two >= 2, r * p < 2^30. Up to threads lanes, at most p and
+/// crypto_pwhash_scryptsalsa208sha256_THREADSMAX, are computed in parallel
+/// on hosts with CRYPTO_HAS_PTHREADS. Otherwise threads is ignored and the
+/// lanes are computed one after the other. The result does not depend on
+/// threads. Returns -1 if the parameters are invalid or memorySize is less
+/// than crypto_pwhash_scryptsalsa208sha256_MEMORYBYTES(N, r, p, threads) for
+/// the limited number of threads, i.e. for threads = 1 without
+/// CRYPTO_HAS_PTHREADS.
+int
+crypto_pwhash_scryptsalsa208sha256_ll(const uint8_t *passwd,size_t passwdlen,
+                                      const uint8_t *salt,size_t saltlen,
+                                      uint64_t N,uint32_t r,uint32_t p,
+                                      uint8_t *buf,size_t buflen,
+                                      void *memory,size_t memorySize,unsigned int threads);
+
+#endif
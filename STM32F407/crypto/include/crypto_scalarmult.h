@@ -2,6 +2,7 @@
 #define CRYPTO_SCALARMULT_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "bigint.h"
 
 #define crypto_scalarmult crypto_scalarmult_curve25519
@@ -25,6 +26,27 @@ crypto_scalarmult_base_curve25519(
     const uint8_t* n
 );
 
+/// Calculates r[i] = s[i] * p[i] for i = 0 .. n-1. Same result as n calls of
+/// crypto_scalarmult_curve25519. On hosts with AVX2 four ladders are run
+/// in parallel, the remaining n mod 4 items use the single ladder.
+int
+crypto_scalarmult_curve25519_batch(
+    uint8_t       r[][crypto_scalarmult_BYTES],
+    const uint8_t s[][crypto_scalarmult_SCALARBYTES],
+    const uint8_t p[][crypto_scalarmult_BYTES],
+    size_t        n
+);
+#ifdef CRYPTO_HAS_AVX2
+
+/// Four ladders in parallel. Requires a CPU supporting AVX2, see crypto_cpu_has_avx2().
+void
+crypto_scalarmult_curve25519_x4_avx2(
+    uint8_t       r[4][crypto_scalarmult_BYTES],
+    const uint8_t s[4][crypto_scalarmult_SCALARBYTES],
+    const uint8_t p[4][crypto_scalarmult_BYTES]
+);
+
+#endif
 
 extern const uint8_t g_basePointCurve25519[32];
 
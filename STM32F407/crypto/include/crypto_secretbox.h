@@ -0,0 +1,31 @@
+#ifndef CRYPTO_SECRETBOX_H
+#define CRYPTO_SECRETBOX_H 1
+
+#include <stdint.h>
+#include "crypto_target_config.h"
+
+#define crypto_secretbox crypto_secretbox_xsalsa20poly1305
+#define crypto_secretbox_open crypto_secretbox_xsalsa20poly1305_open
+#define crypto_secretbox_KEYBYTES crypto_secretbox_xsalsa20poly1305_KEYBYTES
+#define crypto_secretbox_NONCEBYTES crypto_secretbox_xsalsa20poly1305_NONCEBYTES
+#define crypto_secretbox_ZEROBYTES crypto_secretbox_xsalsa20poly1305_ZEROBYTES
+#define crypto_secretbox_BOXZEROBYTES crypto_secretbox_xsalsa20poly1305_BOXZEROBYTES
+
+#define crypto_secretbox_xsalsa20poly1305_KEYBYTES 32
+#define crypto_secretbox_xsalsa20poly1305_NONCEBYTES 24
+#define crypto_secretbox_xsalsa20poly1305_ZEROBYTES 32
+#define crypto_secretbox_xsalsa20poly1305_BOXZEROBYTES 16
+
+/// NaCl layout: m starts with ZEROBYTES zero bytes, c receives BOXZEROBYTES zero
+/// bytes, the 16 byte authenticator and the ciphertext. The ciphertext is
+/// authenticated in the same pass that encrypts it. c may equal m.
+int
+crypto_secretbox_xsalsa20poly1305(uint8_t *c,const uint8_t *m,unsigned long long mlen,const uint8_t *n,const uint8_t *k);
+
+/// Returns 0 and the plaintext (after ZEROBYTES zero bytes) in m if the
+/// authenticator is valid. Otherwise returns -1 without writing to m, i.e.
+/// no unauthenticated plaintext is released and c is kept if m equals c.
+int
+crypto_secretbox_xsalsa20poly1305_open(uint8_t *m,const uint8_t *c,unsigned long long clen,const uint8_t *n,const uint8_t *k);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef CRYPTO_SIGN_H
+#define CRYPTO_SIGN_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crypto_target_config.h"
+
+#define crypto_sign crypto_sign_ed25519
+#define crypto_sign_open crypto_sign_ed25519_open
+#define crypto_sign_keypair crypto_sign_ed25519_keypair
+#define crypto_sign_BYTES crypto_sign_ed25519_BYTES
+#define crypto_sign_PUBLICKEYBYTES crypto_sign_ed25519_PUBLICKEYBYTES
+#define crypto_sign_SECRETKEYBYTES crypto_sign_ed25519_SECRETKEYBYTES
+
+#define crypto_sign_ed25519_BYTES 64
+#define crypto_sign_ed25519_PUBLICKEYBYTES 32
+#define crypto_sign_ed25519_SECRETKEYBYTES 64
+#define crypto_sign_ed25519_SEEDBYTES 32
+
+/// Number of signatures checked by one multi-scalar multiplication in
+/// crypto_sign_ed25519_verify_batch. The stack use is roughly
+/// (2 * CHUNK + 1) * (2 * sizeof(ge25519_p3) + sizeof(sc25519)) bytes plus the
+/// buckets of ge25519_multi_scalarmult_vartime.
+#ifndef CRYPTO_SIGN_ED25519_BATCH_CHUNK
+#ifdef CORTEX_M4
+#define CRYPTO_SIGN_ED25519_BATCH_CHUNK 16
+#else
+#define CRYPTO_SIGN_ED25519_BATCH_CHUNK 64
+#endif
+#endif
+
+/// sk is the 32 byte seed followed by the public key (RFC 8032 / NaCl layout).
+int
+crypto_sign_ed25519_seed_keypair(uint8_t *pk,uint8_t *sk,const uint8_t *seed);
+
+int
+crypto_sign_ed25519_keypair(uint8_t *pk,uint8_t *sk);
+
+/// Writes the 64 byte signature of m to sig.
+int
+crypto_sign_ed25519_detached(uint8_t *sig,const uint8_t *m,unsigned long long mlen,const uint8_t *sk);
+
+/// Returns 0 if sig is a valid signature of m under pk and -1 otherwise.
+/// Non-canonical encodings of S and of the public key are rejected.
+int
+crypto_sign_ed25519_verify_detached(const uint8_t *sig,const uint8_t *m,unsigned long long mlen,const uint8_t *pk);
+
+/// Verifies n detached signatures sig[i] of m[i] under pk[i] together, using a
+/// randomized linear combination of the verification equations
+/// sum z_i (R_i + k_i A_i - S_i B) = 0 with 128 bit random z_i. If the
+/// combined check fails, the signatures are verified individually.
+/// valid[i] is set to 1 for valid and to 0 for invalid signatures.
+/// Returns 0 if all signatures are valid and -1 otherwise.
+int
+crypto_sign_ed25519_verify_batch(const uint8_t *const sig[],const uint8_t *const m[],const unsigned long long mlen[],
+                                 const uint8_t *const pk[],size_t n,int valid[]);
+
+/// sm = signature || m, *smlen = mlen + 64. m and sm + 64 are allowed to overlap.
+int
+crypto_sign_ed25519(uint8_t *sm,unsigned long long *smlen,const uint8_t *m,unsigned long long mlen,const uint8_t *sk);
+
+/// Verifies sm and copies the message to m. m and sm + 64 are allowed to overlap.
+/// Returns -1 and *mlen = 0 if the signature is invalid.
+int
+crypto_sign_ed25519_open(uint8_t *m,unsigned long long *mlen,const uint8_t *sm,unsigned long long smlen,const uint8_t *pk);
+
+#endif
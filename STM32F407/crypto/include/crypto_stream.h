@@ -2,6 +2,7 @@
 #define CRYPTO_STREAM_H 1
 
 #include<stdint.h>
+#include "crypto_target_config.h"
 
 #define crypto_stream crypto_stream_xsalsa20
 #define crypto_stream_xor crypto_stream_xsalsa20_xor
@@ -28,10 +29,17 @@ crypto_stream_xsalsa20 (uint8_t *c,unsigned int d,const uint8_t *n,const uint8_t
 int
 crypto_stream_xsalsa20_xor (uint8_t *c,const uint8_t *m,unsigned int d,const uint8_t *n,const uint8_t *k);
 
+int
+crypto_core_salsa20 (uint8_t *out,const uint8_t *in,const uint8_t *k,const uint8_t *c);
+
 
+// Context of the chunked interface. counter is the number of the next keystream
+// block. block holds the current keystream block, of which the last
+// chunk_bytes_left bytes are not used yet.
 typedef struct
 {
-    uint32_t in[(2 * crypto_stream_salsa20_NONCEBYTES) / sizeof(uint32_t)];
+    uint32_t nonce[crypto_stream_salsa20_NONCEBYTES / sizeof(uint32_t)];
+    uint64_t counter;
     uint32_t key[crypto_stream_salsa20_KEYBYTES / sizeof(uint32_t)];
     uint32_t block[crypto_stream_salsa20_CHUNKBYTES / sizeof(uint32_t)];
     uint32_t chunk_bytes_left;
@@ -40,13 +48,73 @@ typedef struct
 int
 crypto_stream_salsa20_xor_chunked_init(salsa20_xor_chunked *context, const uint8_t *n,const uint8_t *k);
 
+// Encrypts the next d bytes of the stream. c may equal m (in place). If c and m
+// are 32 bit aligned and the preceding chunks have multiples of 4 bytes, the
+// message is XORed word-wise.
 int
 crypto_stream_salsa20_xor_chunked (salsa20_xor_chunked *context, uint8_t *c,const uint8_t *m,unsigned int d);
 
 
+#define crypto_stream_chacha20_ietf_KEYBYTES 32
+#define crypto_stream_chacha20_ietf_NONCEBYTES 12
+#define crypto_stream_xchacha20_KEYBYTES 32
+#define crypto_stream_xchacha20_NONCEBYTES 24
+
+#define crypto_stream_chacha20_CHUNKBYTES 64
+
+// ChaCha20 with 96 bit nonce and 32 bit block counter (RFC 8439). The counter
+// starts at ic (0 for crypto_stream_chacha20_ietf(_xor)) and wraps modulo 2^32.
+int
+crypto_stream_chacha20_ietf (uint8_t *c,unsigned int d,const uint8_t *n,const uint8_t *k);
+
+int
+crypto_stream_chacha20_ietf_xor (uint8_t *c,const uint8_t *m,unsigned int d,const uint8_t *n,const uint8_t *k);
+
+int
+crypto_stream_chacha20_ietf_xor_ic (uint8_t *c,const uint8_t *m,unsigned int d,const uint8_t *n,uint32_t ic,const uint8_t *k);
+
+// XChaCha20: ChaCha20 keyed with HChaCha20(k, n[0..15]) and the nonce 0^32 || n[16..23].
+int
+crypto_stream_xchacha20 (uint8_t *c,unsigned int d,const uint8_t *n,const uint8_t *k);
+
+int
+crypto_stream_xchacha20_xor (uint8_t *c,const uint8_t *m,unsigned int d,const uint8_t *n,const uint8_t *k);
+
+// in is the 16 byte nonce, c the 16 byte constant or NULL for "expand 32-byte k".
+int
+crypto_core_hchacha20 (uint8_t *out,const uint8_t *in,const uint8_t *k,const uint8_t *c);
+
+// Context of the chunked ChaCha20 interface, see salsa20_xor_chunked.
+typedef struct
+{
+    uint32_t nonce[crypto_stream_chacha20_ietf_NONCEBYTES / sizeof(uint32_t)];
+    uint32_t counter;
+    uint32_t key[crypto_stream_chacha20_ietf_KEYBYTES / sizeof(uint32_t)];
+    uint32_t block[crypto_stream_chacha20_CHUNKBYTES / sizeof(uint32_t)];
+    uint32_t chunk_bytes_left;
+} chacha20_xor_chunked;
+
+int
+crypto_stream_chacha20_ietf_xor_chunked_init(chacha20_xor_chunked *context, const uint8_t *n,const uint8_t *k);
+
+// Encrypts the next d bytes of the stream, c may equal m.
+int
+crypto_stream_chacha20_ietf_xor_chunked (chacha20_xor_chunked *context, uint8_t *c,const uint8_t *m,unsigned int d);
+
+#ifdef CRYPTO_HAS_ASM_CHACHA20_BLOCK
+
+#define crypto_core_chacha20_block crypto_core_chacha20_block_asm
+
+#endif
+
+/// The 20 ChaCha20 rounds on the 16 word state x, without the final addition.
+extern void
+crypto_core_chacha20_block (uint32_t * x);
+
 #ifdef CRYPTO_HAS_ASM_HSALSA20_BLOCK
 
 #define crypto_core_hsalsa20_block crypto_core_hsalsa20_block_asm
+#define crypto_core_salsa208_block crypto_core_salsa208_block_asm
 
 #endif
 
@@ -59,4 +127,9 @@ crypto_core_hsalsa20_aligned (uint32_t *pOut,
 extern void
 crypto_core_hsalsa20_block (volatile uint32_t * x);
 
+/// The 8 rounds of Salsa20/8 (scrypt) on the 16 word state x, without the
+/// final addition.
+extern void
+crypto_core_salsa208_block (volatile uint32_t * x);
+
 #endif
@@ -24,7 +24,11 @@
 #ifndef CRYPTO_TARGET_CONFIG_HEADER_
 #define CRYPTO_TARGET_CONFIG_HEADER_
 
+#if defined(__x86_64__) || defined(__aarch64__)
+#include "crypto_target_config_host64.h"
+#else
 #include "crypto_target_config_cortexM4.h"
+#endif
 
 #ifndef FORCE_INLINE
 #define FORCE_INLINE
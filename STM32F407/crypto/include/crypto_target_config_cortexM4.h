@@ -17,13 +17,15 @@
 
 #include <stdint.h>
 
-#ifndef NACL_NO_ASM_OPTIMIZATION
+// If CRYPTO_TARGET_CONFIG_FROM_BUILD is defined, the build system (CMakeLists.txt)
+// passes the CRYPTO_HAS_* switches on the command line and the defaults below are skipped.
+#if !defined(NACL_NO_ASM_OPTIMIZATION) && !defined(CRYPTO_TARGET_CONFIG_FROM_BUILD)
 
 #define CRYPTO_HAS_ASM_HSALSA20_BLOCK
+#define CRYPTO_HAS_ASM_CHACHA20_BLOCK
 #define CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE
 
-#define CRYPTO_TARGET_HAS_ASM_SHA512_CORE
-#define CRYPTO_TARGET_HAS_ASM_ENDIAN_SWAP
+#define CRYPTO_HAS_ASM_SHA512_CORE
 
 // Assembly mpy 256x256 is significantly faster than the C version.
 //#define CRYPTO_HAS_ASM_MPY_256
@@ -49,6 +51,10 @@
 
 #endif
 
+// Use the divstep based inversion (crypto/numerics/fe25519_invert_safegcd.c) instead of
+// the exponentiation by p - 2 built on the assembly squaring and multiplication.
+//#define CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+
 #if defined(__clang__) || defined(__GNUC__)
 
 #define FORCE_INLINE inline __attribute__ ((__always_inline__))
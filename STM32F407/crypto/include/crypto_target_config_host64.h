@@ -0,0 +1,87 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================                      
+
+    \file crypto_target_config_host64.h
+
+    Target specific adaptions for 64 bit hosts (x86-64, AArch64)
+ 
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#ifndef TARGET_CONFIG_HEADER_HOST64_
+#define TARGET_CONFIG_HEADER_HOST64_
+
+// We assume, that we are compiling with GCC or with CLANG
+
+#include <stdint.h>
+
+// If CRYPTO_TARGET_CONFIG_FROM_BUILD is defined, the build system (CMakeLists.txt)
+// passes the CRYPTO_HAS_* switches on the command line and the defaults below are skipped.
+#ifndef CRYPTO_TARGET_CONFIG_FROM_BUILD
+
+// 64x64 => 128 bit multiplications are cheap on these targets. Use five limbs of
+// 51 bits for fe25519 instead of the packed 8x32 bit representation.
+#if defined(__SIZEOF_INT128__) && !defined(CRYPTO_NO_FE25519_RADIX51)
+#define CRYPTO_HAS_FE25519_RADIX51
+#endif
+
+// The divstep inversion with 62 bit limbs is faster than the exponentiation
+// by p - 2, also for the radix 2^51 representation.
+#if defined(__SIZEOF_INT128__) && !defined(CRYPTO_NO_FE25519_INVERT_SAFEGCD)
+#define CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+#endif
+
+// Poly1305 with three limbs of 44, 44 and 42 bits instead of five 26 bit limbs.
+#if defined(__SIZEOF_INT128__) && !defined(CRYPTO_NO_POLY1305_RADIX44)
+#define CRYPTO_HAS_POLY1305_RADIX44
+#endif
+
+// AVX2 kernels are compiled with function level target attributes and selected
+// at runtime, so that the library still runs on x86-64 CPUs without AVX2.
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__)) && !defined(CRYPTO_NO_AVX2)
+#define CRYPTO_HAS_AVX2
+#endif
+
+// 128 bit vectors are part of the baseline of x86-64 (SSE2) and AArch64 (NEON).
+#if defined(__SSE2__) && !defined(CRYPTO_NO_SSE2)
+#define CRYPTO_HAS_SSE2
+#endif
+
+#if defined(__ARM_NEON) && !defined(CRYPTO_NO_NEON)
+#define CRYPTO_HAS_NEON
+#endif
+
+// The p lanes of scrypt run in POSIX threads.
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(CRYPTO_NO_PTHREADS)
+#define CRYPTO_HAS_PTHREADS
+#endif
+
+#endif // #ifndef CRYPTO_TARGET_CONFIG_FROM_BUILD
+
+// Refills of the randombytes generator cover 16 Salsa20 blocks, such that the
+// multi-block kernels are used.
+#define RANDOMBYTES_DRBG_BUFFERBYTES 1024
+
+#if defined(__clang__) || defined(__GNUC__)
+
+#ifdef CRYPTO_HAS_AVX2
+static inline int
+crypto_cpu_has_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#define FORCE_INLINE inline __attribute__ ((__always_inline__))
+#define NO_INLINE __attribute__ ((noinline))
+
+#else
+
+#define FORCE_INLINE
+#define NO_INLINE
+
+#endif
+
+#endif // #ifdef TARGET_CONFIG_HEADER_HOST64_
@@ -17,11 +17,25 @@
 #ifndef FE25519_HEADER_
 #define FE25519_HEADER_
 
+#include <stddef.h>
 #include "../include/bigint.h"
 
 
+#ifdef CRYPTO_HAS_FE25519_RADIX51
+
+/// Five limbs of 51 bits each, see fe25519_radix51.c.
+/// Limbs are allowed to exceed 51 bits in between operations (lazy carries).
+typedef struct
+{
+    uint64_t limbs[5];
+} fe25519;
+
+#else
+
 typedef UN_256bitValue fe25519;
 
+#endif
+
 void
 fe25519_cpy(
     fe25519*       result,
@@ -591,6 +605,26 @@ fe25519_invert(
     const fe25519* x
 );
 
+/// Inverts the n elements of in using a single inversion (Montgomery's trick).
+/// Zero inputs yield zero outputs. scratch shall provide space for n elements.
+/// out and in may overlap.
+void
+fe25519_batch_invert(
+    fe25519*       out,
+    const fe25519* in,
+    size_t         n,
+    fe25519*       scratch
+);
+
+/// Constant time inversion by use of Bernstein-Yang divsteps instead of the
+/// exponentiation by p - 2. Used by fe25519_invert() if CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+/// is defined.
+void
+fe25519_invert_safegcd(
+    fe25519*       r,
+    const fe25519* x
+);
+
 void
 fe25519_invert_useProvidedScratchBuffers(
     fe25519*       r,
@@ -600,6 +634,12 @@ fe25519_invert_useProvidedScratchBuffers(
     fe25519*       t3    
 );
 
+void
+fe25519_pow2523(
+    fe25519*       r,
+    const fe25519* x
+);
+
 void
 fe25519_pow2523_useProvidedScratchBuffers(
     fe25519*       r,
@@ -609,6 +649,8 @@ fe25519_pow2523_useProvidedScratchBuffers(
     fe25519*       t3    
 );
 
+/// Elligator2 map with a separate inversion and Legendre symbol, i.e. two
+/// exponentiations. Same result as fe25519_elligator2(), which is faster.
 void
 fe25519_elligator2x_useProvidedScratchBuffers(
     fe25519*       x,
@@ -627,6 +669,8 @@ fe25519_generateRandomValue(
 );
 
 
+/// Elligator2 map x = v or x = -v - A with v = -A / (1 + 2.r^2), such that
+/// x^3 + A.x^2 + x is a square. Uses fe25519_elligator2_isrt(). Constant time.
 void
 fe25519_elligator2(
     fe25519*       x,
@@ -644,6 +688,85 @@ fe25519_elligator2_useProvidedScratchBuffers(
     fe25519*       v
     );
 
+/// sqrt(-1) = 2^((p - 1) / 4), packed little endian.
+extern const uint8_t fe25519_sqrtMinusOne_packed[32];
+
+/// Returns 1 if x is zero and 0 otherwise. Unlike fe25519_iszero() positive
+/// logic and const. Constant time.
+int32_t
+fe25519_iszero_01(
+    const fe25519* x
+);
+
+/// Returns 1 if a == b and 0 otherwise. Constant time.
+int32_t
+fe25519_iseq(
+    const fe25519* a,
+    const fe25519* b
+);
+
+/// Calculates r = sqrt(u / v) in constant time using one exponentiation by (p - 5) / 8.
+/// Returns 1 if u / v is a square and 0 otherwise. For non-squares r is
+/// sqrt(sqrt(-1).u / v). For v == 0 the result is r = 0 and the return value is
+/// 1 if u == 0. The sign of the root is not normalized.
+int32_t
+fe25519_sqrt_ratio(
+    fe25519*       r,
+    const fe25519* u,
+    const fe25519* v
+);
+
+/// Elligator2 map using the inverse square root trick, i.e. a single exponentiation.
+void
+fe25519_elligator2_isrt(
+    fe25519*       x,
+    const fe25519* r
+);
+
+void
+fe25519_elligator2_isrt_useProvidedScratchBuffers(
+    fe25519*       x,
+    const fe25519* r,
+    // Scratch buffers
+    fe25519*       t0,
+    fe25519*       t1,
+    fe25519*       t2,
+    fe25519*       t3,
+    fe25519*       v
+    );
+
+/// Same as fe25519_elligator2_isrt_useProvidedScratchBuffers() with the fifth
+/// scratch buffer on the stack.
+void
+fe25519_elligator2_isrt_useFourProvidedScratchBuffers(
+    fe25519*       x,
+    const fe25519* r,
+    // Scratch buffers
+    fe25519*       t0,
+    fe25519*       t1,
+    fe25519*       t2,
+    fe25519*       v
+    );
+
+/// x[i] = fe25519_elligator2(r[i]) for i = 0 .. n-1. On x86-64 CPUs with AVX2
+/// four maps at a time run in the lanes of the vector registers.
+void
+fe25519_elligator2_batch(
+    fe25519*       x,
+    const fe25519* r,
+    size_t         n
+    );
+
+#ifdef CRYPTO_HAS_AVX2
+/// Four maps in parallel. Requires a CPU supporting AVX2, see crypto_cpu_has_avx2().
+void
+fe25519_elligator2_x4_avx2(
+    fe25519*       x,
+    const fe25519* r
+    );
+#endif
+
+/// Calculates one of the square roots of in, if in is a square. Constant time.
 void
 fe25519_squareroot(
     fe25519*        result,
@@ -653,6 +776,7 @@ fe25519_squareroot(
 extern const fe25519 fe25519_one;
 extern const fe25519 fe25519_minusA;
 extern const fe25519 fe25519_minusAdiv2;
+extern const fe25519 fe25519_Asquare;
 
 
 #endif // #ifndef FE25519_HEADER_
@@ -0,0 +1,460 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file fe25519x4_avx2.h
+
+    Four field elements in the four 64 bit lanes of the AVX2 registers, using
+    a lane-sliced radix 2^25.5 representation, i.e. ten vectors each holding
+    the corresponding limb of the four elements. Used by the four-way
+    ladder (scalarmult_25519_x4_avx2.c) and the four-way Elligator2 map
+    (fe25519_elligator2_x4_avx2.c). The functions are compiled with function
+    level target attributes, the caller checks for AVX2 support at runtime.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#ifndef FE25519X4_AVX2_HEADER_
+#define FE25519X4_AVX2_HEADER_
+
+#include "fe25519.h"
+#include "avx2defs.h"
+
+#ifdef CRYPTO_HAS_AVX2
+
+#define MUL(a, b) _mm256_mul_epu32(a, b)
+#define ADD(a, b) _mm256_add_epi64(a, b)
+
+// The limb loops need to be unrolled such that the limbs stay in registers.
+#define UNROLL_LIMBS _Pragma("GCC unroll 10")
+
+/// Four field elements, limb i of ladder k residing in lane k of v[i].
+/// Limb i has the weight 2^ceil(25.5 * i), i.e. even limbs hold 26 bits and odd limbs 25 bits.
+/// After fe25519x4_carry() limbs are < 2^26 (limb #1 < 2^25 + 2^14).
+/// Multiplication operands shall have limbs < 2^27.
+typedef struct
+{
+    __m256i v[10];
+} fe25519x4;
+
+#define CARRY26(i) \
+    c = _mm256_srli_epi64(h[i], 26); h[i] = _mm256_and_si256(h[i], mask26); h[(i) + 1] = ADD(h[(i) + 1], c);
+#define CARRY25(i) \
+    c = _mm256_srli_epi64(h[i], 25); h[i] = _mm256_and_si256(h[i], mask25); h[(i) + 1] = ADD(h[(i) + 1], c);
+
+static AVX2_INLINE void
+fe25519x4_carry(
+    __m256i h[10]
+)
+{
+    const __m256i mask26 = _mm256_set1_epi64x((1 << 26) - 1);
+    const __m256i mask25 = _mm256_set1_epi64x((1 << 25) - 1);
+    __m256i       c;
+
+    CARRY26(0); CARRY25(1); CARRY26(2); CARRY25(3); CARRY26(4);
+    CARRY25(5); CARRY26(6); CARRY25(7); CARRY26(8);
+
+    // The carry of limb #9 has the weight 2^255 == 19.
+    c = _mm256_srli_epi64(h[9], 25);
+    h[9] = _mm256_and_si256(h[9], mask25);
+    h[0] = ADD(h[0], c);
+    h[0] = ADD(h[0], _mm256_slli_epi64(c, 1));
+    h[0] = ADD(h[0], _mm256_slli_epi64(c, 4));
+
+    CARRY26(0);
+}
+
+#undef CARRY26
+#undef CARRY25
+
+static AVX2_INLINE void
+fe25519x4_add(
+    fe25519x4*       r,
+    const fe25519x4* a,
+    const fe25519x4* b
+)
+{
+    int i;
+
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        r->v[i] = ADD(a->v[i], b->v[i]);
+    }
+}
+
+/// r = a + 4 * p - b. Requires the limbs of b to be < 2^27.
+static AVX2_INLINE void
+fe25519x4_sub(
+    fe25519x4*       r,
+    const fe25519x4* a,
+    const fe25519x4* b
+)
+{
+    const __m256i fourP0 = _mm256_set1_epi64x(0xfffffb4);
+    const __m256i fourPEven = _mm256_set1_epi64x(0xffffffc);
+    const __m256i fourPOdd = _mm256_set1_epi64x(0x7fffffc);
+    __m256i       h[10];
+    int           i;
+
+    h[0] = _mm256_sub_epi64(ADD(a->v[0], fourP0), b->v[0]);
+    UNROLL_LIMBS
+    for (i = 1; i < 10; i++)
+    {
+        h[i] = _mm256_sub_epi64(ADD(a->v[i], (i & 1) ? fourPOdd : fourPEven), b->v[i]);
+    }
+    fe25519x4_carry(h);
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        r->v[i] = h[i];
+    }
+}
+
+static AVX2_INLINE void
+fe25519x4_mul(
+    fe25519x4*       r,
+    const fe25519x4* a,
+    const fe25519x4* b
+)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    __m256i       f[10], f2[10], g[10], g19[10], h[10];
+    int           i;
+
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        f[i] = a->v[i];
+        f2[i] = ADD(f[i], f[i]);
+        g[i] = b->v[i];
+        g19[i] = MUL(g[i], nineteen);
+    }
+
+    h[0] = MUL(f[0], g[0]);
+    h[0] = ADD(h[0], MUL(f2[1], g19[9]));
+    h[0] = ADD(h[0], MUL(f[2], g19[8]));
+    h[0] = ADD(h[0], MUL(f2[3], g19[7]));
+    h[0] = ADD(h[0], MUL(f[4], g19[6]));
+    h[0] = ADD(h[0], MUL(f2[5], g19[5]));
+    h[0] = ADD(h[0], MUL(f[6], g19[4]));
+    h[0] = ADD(h[0], MUL(f2[7], g19[3]));
+    h[0] = ADD(h[0], MUL(f[8], g19[2]));
+    h[0] = ADD(h[0], MUL(f2[9], g19[1]));
+    h[1] = MUL(f[0], g[1]);
+    h[1] = ADD(h[1], MUL(f[1], g[0]));
+    h[1] = ADD(h[1], MUL(f[2], g19[9]));
+    h[1] = ADD(h[1], MUL(f[3], g19[8]));
+    h[1] = ADD(h[1], MUL(f[4], g19[7]));
+    h[1] = ADD(h[1], MUL(f[5], g19[6]));
+    h[1] = ADD(h[1], MUL(f[6], g19[5]));
+    h[1] = ADD(h[1], MUL(f[7], g19[4]));
+    h[1] = ADD(h[1], MUL(f[8], g19[3]));
+    h[1] = ADD(h[1], MUL(f[9], g19[2]));
+    h[2] = MUL(f[0], g[2]);
+    h[2] = ADD(h[2], MUL(f2[1], g[1]));
+    h[2] = ADD(h[2], MUL(f[2], g[0]));
+    h[2] = ADD(h[2], MUL(f2[3], g19[9]));
+    h[2] = ADD(h[2], MUL(f[4], g19[8]));
+    h[2] = ADD(h[2], MUL(f2[5], g19[7]));
+    h[2] = ADD(h[2], MUL(f[6], g19[6]));
+    h[2] = ADD(h[2], MUL(f2[7], g19[5]));
+    h[2] = ADD(h[2], MUL(f[8], g19[4]));
+    h[2] = ADD(h[2], MUL(f2[9], g19[3]));
+    h[3] = MUL(f[0], g[3]);
+    h[3] = ADD(h[3], MUL(f[1], g[2]));
+    h[3] = ADD(h[3], MUL(f[2], g[1]));
+    h[3] = ADD(h[3], MUL(f[3], g[0]));
+    h[3] = ADD(h[3], MUL(f[4], g19[9]));
+    h[3] = ADD(h[3], MUL(f[5], g19[8]));
+    h[3] = ADD(h[3], MUL(f[6], g19[7]));
+    h[3] = ADD(h[3], MUL(f[7], g19[6]));
+    h[3] = ADD(h[3], MUL(f[8], g19[5]));
+    h[3] = ADD(h[3], MUL(f[9], g19[4]));
+    h[4] = MUL(f[0], g[4]);
+    h[4] = ADD(h[4], MUL(f2[1], g[3]));
+    h[4] = ADD(h[4], MUL(f[2], g[2]));
+    h[4] = ADD(h[4], MUL(f2[3], g[1]));
+    h[4] = ADD(h[4], MUL(f[4], g[0]));
+    h[4] = ADD(h[4], MUL(f2[5], g19[9]));
+    h[4] = ADD(h[4], MUL(f[6], g19[8]));
+    h[4] = ADD(h[4], MUL(f2[7], g19[7]));
+    h[4] = ADD(h[4], MUL(f[8], g19[6]));
+    h[4] = ADD(h[4], MUL(f2[9], g19[5]));
+    h[5] = MUL(f[0], g[5]);
+    h[5] = ADD(h[5], MUL(f[1], g[4]));
+    h[5] = ADD(h[5], MUL(f[2], g[3]));
+    h[5] = ADD(h[5], MUL(f[3], g[2]));
+    h[5] = ADD(h[5], MUL(f[4], g[1]));
+    h[5] = ADD(h[5], MUL(f[5], g[0]));
+    h[5] = ADD(h[5], MUL(f[6], g19[9]));
+    h[5] = ADD(h[5], MUL(f[7], g19[8]));
+    h[5] = ADD(h[5], MUL(f[8], g19[7]));
+    h[5] = ADD(h[5], MUL(f[9], g19[6]));
+    h[6] = MUL(f[0], g[6]);
+    h[6] = ADD(h[6], MUL(f2[1], g[5]));
+    h[6] = ADD(h[6], MUL(f[2], g[4]));
+    h[6] = ADD(h[6], MUL(f2[3], g[3]));
+    h[6] = ADD(h[6], MUL(f[4], g[2]));
+    h[6] = ADD(h[6], MUL(f2[5], g[1]));
+    h[6] = ADD(h[6], MUL(f[6], g[0]));
+    h[6] = ADD(h[6], MUL(f2[7], g19[9]));
+    h[6] = ADD(h[6], MUL(f[8], g19[8]));
+    h[6] = ADD(h[6], MUL(f2[9], g19[7]));
+    h[7] = MUL(f[0], g[7]);
+    h[7] = ADD(h[7], MUL(f[1], g[6]));
+    h[7] = ADD(h[7], MUL(f[2], g[5]));
+    h[7] = ADD(h[7], MUL(f[3], g[4]));
+    h[7] = ADD(h[7], MUL(f[4], g[3]));
+    h[7] = ADD(h[7], MUL(f[5], g[2]));
+    h[7] = ADD(h[7], MUL(f[6], g[1]));
+    h[7] = ADD(h[7], MUL(f[7], g[0]));
+    h[7] = ADD(h[7], MUL(f[8], g19[9]));
+    h[7] = ADD(h[7], MUL(f[9], g19[8]));
+    h[8] = MUL(f[0], g[8]);
+    h[8] = ADD(h[8], MUL(f2[1], g[7]));
+    h[8] = ADD(h[8], MUL(f[2], g[6]));
+    h[8] = ADD(h[8], MUL(f2[3], g[5]));
+    h[8] = ADD(h[8], MUL(f[4], g[4]));
+    h[8] = ADD(h[8], MUL(f2[5], g[3]));
+    h[8] = ADD(h[8], MUL(f[6], g[2]));
+    h[8] = ADD(h[8], MUL(f2[7], g[1]));
+    h[8] = ADD(h[8], MUL(f[8], g[0]));
+    h[8] = ADD(h[8], MUL(f2[9], g19[9]));
+    h[9] = MUL(f[0], g[9]);
+    h[9] = ADD(h[9], MUL(f[1], g[8]));
+    h[9] = ADD(h[9], MUL(f[2], g[7]));
+    h[9] = ADD(h[9], MUL(f[3], g[6]));
+    h[9] = ADD(h[9], MUL(f[4], g[5]));
+    h[9] = ADD(h[9], MUL(f[5], g[4]));
+    h[9] = ADD(h[9], MUL(f[6], g[3]));
+    h[9] = ADD(h[9], MUL(f[7], g[2]));
+    h[9] = ADD(h[9], MUL(f[8], g[1]));
+    h[9] = ADD(h[9], MUL(f[9], g[0]));
+
+    fe25519x4_carry(h);
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        r->v[i] = h[i];
+    }
+}
+
+static AVX2_INLINE void
+fe25519x4_square(
+    fe25519x4*       r,
+    const fe25519x4* a
+)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    __m256i       f[10], f2[10], f4[10], f19[10], h[10];
+    int           i;
+
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        f[i] = a->v[i];
+        f2[i] = ADD(f[i], f[i]);
+        f4[i] = ADD(f2[i], f2[i]);
+        f19[i] = MUL(f[i], nineteen);
+    }
+
+    h[0] = MUL(f[0], f[0]);
+    h[0] = ADD(h[0], MUL(f4[1], f19[9]));
+    h[0] = ADD(h[0], MUL(f2[2], f19[8]));
+    h[0] = ADD(h[0], MUL(f4[3], f19[7]));
+    h[0] = ADD(h[0], MUL(f2[4], f19[6]));
+    h[0] = ADD(h[0], MUL(f2[5], f19[5]));
+    h[1] = MUL(f2[0], f[1]);
+    h[1] = ADD(h[1], MUL(f2[2], f19[9]));
+    h[1] = ADD(h[1], MUL(f2[3], f19[8]));
+    h[1] = ADD(h[1], MUL(f2[4], f19[7]));
+    h[1] = ADD(h[1], MUL(f2[5], f19[6]));
+    h[2] = MUL(f2[0], f[2]);
+    h[2] = ADD(h[2], MUL(f2[1], f[1]));
+    h[2] = ADD(h[2], MUL(f4[3], f19[9]));
+    h[2] = ADD(h[2], MUL(f2[4], f19[8]));
+    h[2] = ADD(h[2], MUL(f4[5], f19[7]));
+    h[2] = ADD(h[2], MUL(f[6], f19[6]));
+    h[3] = MUL(f2[0], f[3]);
+    h[3] = ADD(h[3], MUL(f2[1], f[2]));
+    h[3] = ADD(h[3], MUL(f2[4], f19[9]));
+    h[3] = ADD(h[3], MUL(f2[5], f19[8]));
+    h[3] = ADD(h[3], MUL(f2[6], f19[7]));
+    h[4] = MUL(f2[0], f[4]);
+    h[4] = ADD(h[4], MUL(f4[1], f[3]));
+    h[4] = ADD(h[4], MUL(f[2], f[2]));
+    h[4] = ADD(h[4], MUL(f4[5], f19[9]));
+    h[4] = ADD(h[4], MUL(f2[6], f19[8]));
+    h[4] = ADD(h[4], MUL(f2[7], f19[7]));
+    h[5] = MUL(f2[0], f[5]);
+    h[5] = ADD(h[5], MUL(f2[1], f[4]));
+    h[5] = ADD(h[5], MUL(f2[2], f[3]));
+    h[5] = ADD(h[5], MUL(f2[6], f19[9]));
+    h[5] = ADD(h[5], MUL(f2[7], f19[8]));
+    h[6] = MUL(f2[0], f[6]);
+    h[6] = ADD(h[6], MUL(f4[1], f[5]));
+    h[6] = ADD(h[6], MUL(f2[2], f[4]));
+    h[6] = ADD(h[6], MUL(f2[3], f[3]));
+    h[6] = ADD(h[6], MUL(f4[7], f19[9]));
+    h[6] = ADD(h[6], MUL(f[8], f19[8]));
+    h[7] = MUL(f2[0], f[7]);
+    h[7] = ADD(h[7], MUL(f2[1], f[6]));
+    h[7] = ADD(h[7], MUL(f2[2], f[5]));
+    h[7] = ADD(h[7], MUL(f2[3], f[4]));
+    h[7] = ADD(h[7], MUL(f2[8], f19[9]));
+    h[8] = MUL(f2[0], f[8]);
+    h[8] = ADD(h[8], MUL(f4[1], f[7]));
+    h[8] = ADD(h[8], MUL(f2[2], f[6]));
+    h[8] = ADD(h[8], MUL(f4[3], f[5]));
+    h[8] = ADD(h[8], MUL(f[4], f[4]));
+    h[8] = ADD(h[8], MUL(f2[9], f19[9]));
+    h[9] = MUL(f2[0], f[9]);
+    h[9] = ADD(h[9], MUL(f2[1], f[8]));
+    h[9] = ADD(h[9], MUL(f2[2], f[7]));
+    h[9] = ADD(h[9], MUL(f2[3], f[6]));
+    h[9] = ADD(h[9], MUL(f2[4], f[5]));
+
+    fe25519x4_carry(h);
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        r->v[i] = h[i];
+    }
+}
+
+static AVX2_INLINE void
+fe25519x4_mpyWith121666(
+    fe25519x4*       r,
+    const fe25519x4* a
+)
+{
+    const __m256i v121666 = _mm256_set1_epi64x(121666);
+    __m256i       h[10];
+    int           i;
+
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        h[i] = MUL(a->v[i], v121666);
+    }
+    fe25519x4_carry(h);
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        r->v[i] = h[i];
+    }
+}
+
+/// Swaps lane k of a and b if lane k of mask is all ones. Lanes with zero mask are left untouched.
+static AVX2_INLINE void
+fe25519x4_cswap(
+    fe25519x4* a,
+    fe25519x4* b,
+    __m256i    mask
+)
+{
+    int i;
+
+    UNROLL_LIMBS
+    for (i = 0; i < 10; i++)
+    {
+        __m256i t = _mm256_and_si256(mask, _mm256_xor_si256(a->v[i], b->v[i]));
+
+        a->v[i] = _mm256_xor_si256(a->v[i], t);
+        b->v[i] = _mm256_xor_si256(b->v[i], t);
+    }
+}
+
+static inline uint32_t
+load_littleendian32(
+    const uint8_t* x
+)
+{
+    return (uint32_t)(x[0]) | (((uint32_t)(x[1])) << 8) | (((uint32_t)(x[2])) << 16) | (((uint32_t)(x[3])) << 24);
+}
+
+/// Unpacks lane k from in[k]. Bit #255 is cleared.
+static inline AVX2_FUNCTION void
+fe25519x4_unpack(
+    fe25519x4*    r,
+    const uint8_t in[4][32]
+)
+{
+    static const uint8_t offset[10] = { 0, 3, 6, 9, 12, 16, 19, 22, 25, 28 };
+    static const uint8_t shift[10] = { 0, 2, 3, 5, 6, 0, 1, 3, 4, 6 };
+    int                  i;
+
+    for (i = 0; i < 10; i++)
+    {
+        uint32_t mask = (i & 1) ? ((1 << 25) - 1) : ((1 << 26) - 1);
+
+        r->v[i] = _mm256_set_epi64x((load_littleendian32(in[3] + offset[i]) >> shift[i]) & mask,
+                                    (load_littleendian32(in[2] + offset[i]) >> shift[i]) & mask,
+                                    (load_littleendian32(in[1] + offset[i]) >> shift[i]) & mask,
+                                    (load_littleendian32(in[0] + offset[i]) >> shift[i]) & mask);
+    }
+}
+
+/// Packs lane k to out[k]. The output is smaller than 2^255 but not necessarily fully reduced.
+/// a shall be the result of fe25519x4_carry(). A second carry pass reduces limb #1 below 2^25,
+/// otherwise the packed value could reach 2^255 + 2^40.
+static inline AVX2_FUNCTION void
+fe25519x4_pack(
+    uint8_t          out[4][32],
+    const fe25519x4* a
+)
+{
+    static const uint8_t weight[11] = { 0, 26, 51, 77, 102, 128, 153, 179, 204, 230, 255 };
+    __m256i              h[10];
+    uint64_t             limbs[10][4];
+    int                  i, k;
+
+    for (i = 0; i < 10; i++)
+    {
+        h[i] = a->v[i];
+    }
+    // If the carry of limb #9 is not zero, limbs #2 .. #9 have become zero.
+    // Otherwise limb #1 is < 2^25 after this pass. Both cases are below 2^255.
+    fe25519x4_carry(h);
+    for (i = 0; i < 10; i++)
+    {
+        _mm256_storeu_si256((__m256i *)limbs[i], h[i]);
+    }
+
+    for (k = 0; k < 4; k++)
+    {
+        uint64_t accu = 0;
+        int      bitsInAccu = 0; // bit position of accu relative to the weight of the current limb.
+        int      byteCtr = 0;
+
+        for (i = 0; i < 10; i++)
+        {
+            accu += limbs[i][k] << bitsInAccu;
+
+            // Bytes below the weight of the next limb won't see any further additions.
+            bitsInAccu += weight[i + 1] - weight[i];
+            while ((bitsInAccu >= 8) && (byteCtr < 32))
+            {
+                out[k][byteCtr++] = (uint8_t)accu;
+                accu >>= 8;
+                bitsInAccu -= 8;
+            }
+        }
+        while (byteCtr < 32)
+        {
+            out[k][byteCtr++] = (uint8_t)accu;
+            accu >>= 8;
+        }
+    }
+}
+
+#undef MUL
+#undef ADD
+#undef UNROLL_LIMBS
+
+#endif // #ifdef CRYPTO_HAS_AVX2
+
+#endif // #ifndef FE25519X4_AVX2_HEADER_
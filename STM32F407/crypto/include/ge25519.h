@@ -0,0 +1,237 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file ge25519.h
+
+    Defines the group elements of the twisted edwards curve
+    -x^2 + y^2 = 1 + d.x^2.y^2 that is birationally equivalent to curve25519.
+
+    Provides the same interface as the corresponding header in avrnacl of
+    Michael Hutter and Peter Schwabe.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#ifndef GE25519_HEADER_
+#define GE25519_HEADER_
+
+#include "../include/fe25519.h"
+#include "../include/sc25519.h"
+
+/// Flash budget for the precomputed base point table used by
+/// ge25519_scalarmult_base(). Valid settings are 24, 12 and 6 (KByte).
+/// Smaller tables trade flash for 4 additional doublings per halving.
+/// 0 disables the table and crypto_scalarmult_base falls back to the ladder.
+#ifndef GE25519_BASE_TABLE_SIZE_KB
+#define GE25519_BASE_TABLE_SIZE_KB 24
+#endif
+
+#if (GE25519_BASE_TABLE_SIZE_KB == 24)
+#define GE25519_BASE_TABLE_WINDOWS 32
+#elif (GE25519_BASE_TABLE_SIZE_KB == 12)
+#define GE25519_BASE_TABLE_WINDOWS 16
+#elif (GE25519_BASE_TABLE_SIZE_KB == 6)
+#define GE25519_BASE_TABLE_WINDOWS 8
+#elif (GE25519_BASE_TABLE_SIZE_KB == 0)
+#define GE25519_BASE_TABLE_WINDOWS 0
+#else
+#error "GE25519_BASE_TABLE_SIZE_KB shall be one of 24, 12, 6 or 0."
+#endif
+
+/// Extended coordinates: x = X/Z, y = Y/Z, x.y = T/Z
+typedef struct
+{
+    fe25519 x;
+    fe25519 y;
+    fe25519 z;
+    fe25519 t;
+} ge25519_p3;
+
+typedef ge25519_p3 ge25519;
+
+/// Projective coordinates: x = X/Z, y = Y/Z
+typedef struct
+{
+    fe25519 x;
+    fe25519 y;
+    fe25519 z;
+} ge25519_p2;
+
+/// Completed coordinates: x = X/Z, y = Y/T
+typedef struct
+{
+    fe25519 x;
+    fe25519 y;
+    fe25519 z;
+    fe25519 t;
+} ge25519_p1p1;
+
+/// Affine point in the form (y - x, y + x, 2.d.x.y) used for mixed additions.
+typedef struct
+{
+    fe25519 ysubx;
+    fe25519 xaddy;
+    fe25519 t2d;
+} ge25519_niels;
+
+/// Projective point in the form (Y + X, Y - X, Z, 2.d.T) used for additions
+/// of two points in extended coordinates.
+typedef struct
+{
+    fe25519 xaddy;
+    fe25519 ysubx;
+    fe25519 z;
+    fe25519 t2d;
+} ge25519_cached;
+
+/// Same as ge25519_niels, but fully reduced and packed so that tables in flash
+/// are independent of the representation chosen for fe25519.
+typedef struct
+{
+    UN_256bitValue ysubx;
+    UN_256bitValue xaddy;
+    UN_256bitValue t2d;
+} ge25519_niels_packed;
+
+void
+ge25519_setneutral(
+    ge25519_p3* r
+);
+
+void
+ge25519_p3_to_p2(
+    ge25519_p2*       r,
+    const ge25519_p3* p
+);
+
+void
+ge25519_p1p1_to_p2(
+    ge25519_p2*         r,
+    const ge25519_p1p1* p
+);
+
+void
+ge25519_p1p1_to_p3(
+    ge25519_p3*         r,
+    const ge25519_p1p1* p
+);
+
+void
+ge25519_dbl_p1p1(
+    ge25519_p1p1*     r,
+    const ge25519_p2* p
+);
+
+void
+ge25519_p3_to_cached(
+    ge25519_cached*   r,
+    const ge25519_p3* p
+);
+
+void
+ge25519_add_p1p1(
+    ge25519_p1p1*         r,
+    const ge25519_p3*     p,
+    const ge25519_cached* q
+);
+
+/// r = p - q
+void
+ge25519_sub_p1p1(
+    ge25519_p1p1*         r,
+    const ge25519_p3*     p,
+    const ge25519_cached* q
+);
+
+void
+ge25519_mixadd_p1p1(
+    ge25519_p1p1*        r,
+    const ge25519_p3*    p,
+    const ge25519_niels* q
+);
+
+/// Sets r to the base point B of ed25519.
+void
+ge25519_setbase(
+    ge25519_p3* r
+);
+
+/// Encodes p as the y coordinate with the sign of x in the most significant bit.
+void
+ge25519_pack(
+    uint8_t           r[32],
+    const ge25519_p3* p
+);
+
+/// Decodes p and negates the point, as required for signature verification.
+/// Returns 0 on success and -1 if p is not the canonical encoding of a point.
+/// Not constant time, use only for public inputs.
+int
+ge25519_unpackneg_vartime(
+    ge25519_p3*   r,
+    const uint8_t p[32]
+);
+
+/// Returns 1 if 8 * p is the neutral element, i.e. if the order of p divides
+/// the cofactor 8, and 0 otherwise. Not constant time, use only for public
+/// inputs.
+int
+ge25519_is_small_order_vartime(
+    const ge25519_p3* p
+);
+
+/// Calculates r = s1 * p1 + s2 * B with B being the base point of ed25519.
+/// s1 and s2 shall be reduced. Straus' method with sliding window NAFs, the
+/// odd multiples of B are taken from ge25519_base_odd_multiples.
+/// Not constant time, use only for public inputs such as in signature
+/// verification.
+void
+ge25519_double_scalarmult_vartime(
+    ge25519_p3*       r,
+    const ge25519_p3* p1,
+    const sc25519*    s1,
+    const sc25519*    s2
+);
+
+/// Calculates r = s[0] * p[0] + ... + s[n - 1] * p[n - 1] using Pippenger's
+/// bucket method with signed digits. The scalars shall be smaller than 2^253.
+/// scratch shall provide n entries. Not constant time, use only for public
+/// inputs such as in batch signature verification.
+void
+ge25519_multi_scalarmult_vartime(
+    ge25519_p3*       r,
+    const ge25519_p3  p[],
+    const sc25519     s[],
+    size_t            n,
+    ge25519_cached    scratch[]
+);
+
+/// Calculates r = s * B with B being the base point of ed25519.
+/// s is not required to be reduced modulo the group order but shall be smaller
+/// than 2^255. Constant time.
+void
+ge25519_scalarmult_base(
+    ge25519_p3*    r,
+    const sc25519* s
+);
+
+#if (GE25519_BASE_TABLE_WINDOWS > 0)
+
+/// Sliding window width of the base point in ge25519_double_scalarmult_vartime.
+/// ge25519_base_odd_multiples adds 3 KByte to the table.
+#define GE25519_BASE_SLIDE_WIDTH 7
+
+/// Entry i holds (2 i + 1) * B.
+extern const ge25519_niels_packed
+ge25519_base_odd_multiples[1 << (GE25519_BASE_SLIDE_WIDTH - 2)];
+
+/// Window w holds i * 16^(w * 64 / GE25519_BASE_TABLE_WINDOWS) * B for i = 1 .. 8.
+extern const ge25519_niels_packed
+ge25519_base_multiples[GE25519_BASE_TABLE_WINDOWS][8];
+
+#endif
+
+#endif // #ifndef GE25519_HEADER_
@@ -1,6 +1,49 @@
 #ifndef RANDOMBYTES_H
 #define RANDOMBYTES_H
 
+#include <stdint.h>
+#include "crypto_target_config.h"
+
 void randombytes(unsigned char *x,unsigned long long xlen);
 
-#endif
\ No newline at end of file
+// Fast-key-erasure generator (crypto/support/randombytes_drbg.c) behind the
+// randombytes() backends. Each refill computes RANDOMBYTES_DRBG_BUFFERBYTES
+// of Salsa20 keystream under key with a zero nonce; the first 32 bytes replace
+// the key and the rest is handed out and erased byte by byte. The backends
+// reseed it from their entropy source every RANDOMBYTES_DRBG_RESEED_INTERVAL
+// refills.
+
+#ifndef RANDOMBYTES_DRBG_BUFFERBYTES
+#define RANDOMBYTES_DRBG_BUFFERBYTES 256
+#endif
+
+#ifndef RANDOMBYTES_DRBG_RESEED_INTERVAL
+#define RANDOMBYTES_DRBG_RESEED_INTERVAL 1024
+#endif
+
+#define randombytes_drbg_SEEDBYTES 32
+
+typedef struct
+{
+    uint8_t  key[32];
+    uint8_t  buffer[RANDOMBYTES_DRBG_BUFFERBYTES];
+    uint32_t position;  // first unused byte of buffer
+    uint32_t refills;   // since the last reseed
+} randombytes_drbg;
+
+/// Keys the generator with seed.
+void
+randombytes_drbg_init(randombytes_drbg *drbg,const uint8_t *seed);
+
+/// Mixes seed into the key and discards the buffered output.
+void
+randombytes_drbg_reseed(randombytes_drbg *drbg,const uint8_t *seed);
+
+/// Returns nonzero once RANDOMBYTES_DRBG_RESEED_INTERVAL refills were made.
+int
+randombytes_drbg_reseed_due(const randombytes_drbg *drbg);
+
+void
+randombytes_drbg_generate(randombytes_drbg *drbg,uint8_t *x,unsigned long long xlen);
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 #include "../include/crypto_stream.h"
+#include "../include/bigint.h"
+
+// "expand 32-byte k"
+extern const UN_128bitValue g_salsa20_sigma;
 
 
 extern int crypto_core_hsalsa20 (
@@ -12,4 +16,30 @@ extern int crypto_core_hsalsa20 (
     const uint8_t *c
     );
 
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_NEON) || defined(CRYPTO_HAS_AVX2)
+
+#define CRYPTO_HAS_SALSA20_SIMD
+
+// Remaining length from which on the stream functions use the vector kernels.
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_NEON)
+#define SALSA20_SIMD_MIN_BYTES 256
+#else
+#define SALSA20_SIMD_MIN_BYTES 512
+#endif
+
+/// Computes c = m ^ keystream for the largest multiple of 4 blocks in len, or
+/// writes the keystream if m is NULL. With AVX2 as the only vector extension
+/// the largest multiple of 8 blocks, none on CPUs without AVX2. state is the
+/// Salsa20 input block in host order, its block counter (words 8 and 9) is
+/// advanced. Returns the number of bytes processed.
+unsigned int
+crypto_stream_salsa20_xor_simd(
+    uint8_t*       c,
+    const uint8_t* m,
+    unsigned int   len,
+    uint32_t       state[16]
+);
+
+#endif
+
 #endif // #ifndef LOCAL_SALSA20_HEADER_
@@ -17,6 +17,7 @@
 #ifndef SC25519_HEADER_
 #define SC25519_HEADER_
 
+#include <stddef.h>
 #include "../include/bigint.h"
 
 
@@ -40,6 +41,13 @@ sc25519_from32bytes(
     const uint8_t x[32]
 );
 
+/// Returns 1 if the little endian number s is smaller than the group order L,
+/// e.g. for rejecting non-canonical S of signatures. Not constant time.
+int
+sc25519_is_canonical_vartime(
+    const uint8_t s[32]
+);
+
 #define SC25519_WINDOW4_SIZE (64)
 
 #define SC25519_INITIALIZER_FOR_ONE_HALF { \
@@ -58,7 +66,8 @@ sc25519_window4(
 );
 
 /// Generate an interleave table for the algorithm, that simultaneously computes
-/// the sum of two scalar products.
+/// the sum of two scalar products. r[i] holds bit i of s1 in bit 0 and
+/// bit i of s2 in bit 1.
 void
 sc25519_2interleave1(
     uint8_t  r[255],
@@ -66,6 +75,18 @@ sc25519_2interleave1(
     const sc25519* s2
 );
 
+#define SC25519_SLIDE_SIZE (256)
+
+/// convert s < 2^255 to a sliding window NAF of 256 signed chars with
+/// s = sum r[i] * 2^i. The nonzero digits are odd and in the range
+/// -(2^(w-1) - 1) .. 2^(w-1) - 1. Not constant time, use only for public scalars.
+void
+sc25519_slide(
+    signed char    r[SC25519_SLIDE_SIZE],
+    const sc25519* s,
+    uint8_t        w
+);
+
 void
 sc25519_add(
     sc25519*       result,
@@ -87,6 +108,17 @@ sc25519_mul(
     const sc25519* y
 );
 
+/// r = x * y + c modulo the group order with a single reduction, e.g. for
+/// S = r + k * a of signatures. x, y and c shall be reduced. r may overlap
+/// with x, y or c.
+void
+sc25519_muladd(
+    sc25519*       r,
+    const sc25519* x,
+    const sc25519* y,
+    const sc25519* c
+);
+
 void
 sc25519_sqr(
 	sc25519*       r,
@@ -99,11 +131,84 @@ void
 sc25519_reduce(UN_512bitValue* valueToReduce);
 
 
-/// inversion modulo point group order.
+/// Scalar x.R mod L in Montgomery representation with R = 2^256, i.e. the
+/// factor R mod L = 2^256 mod L is kept in the stored value. Chains of
+/// multiplications need only one Montgomery reduction per operation instead of
+/// the Barrett reduction of sc25519_mul. The conversion costs one
+/// multiplication and reduction each way. Addition and subtraction are the same
+/// as for sc25519: use sc25519_add(&r.value, &x.value, &y.value).
+/// All sc25519_mont functions return values fully reduced modulo L and run in
+/// constant time.
+typedef struct
+{
+    sc25519 value;
+} sc25519_mont;
+
+/// r = x.R mod L. x shall be smaller than 2^256.
+void
+sc25519_to_mont(
+    sc25519_mont*  r,
+    const sc25519* x
+);
+
+/// r = x.R^-1 mod L, fully reduced. x.value may be any value below 2^256.
+void
+sc25519_from_mont(
+    sc25519*            r,
+    const sc25519_mont* x
+);
+
+/// r = x.R mod L for the little endian number x, which need not be smaller
+/// than L.
+void
+sc25519_mont_from32bytes(
+    sc25519_mont* r,
+    const uint8_t x[32]
+);
+
+/// Writes x.R^-1 mod L as 32 byte little endian number.
+void
+sc25519_mont_to32bytes(
+    uint8_t             r[32],
+    const sc25519_mont* x
+);
+
+/// r = x.y.R^-1 mod L, i.e. the Montgomery representation of the product.
+/// x.value and y.value shall be smaller than L, as returned by the functions
+/// above, such that the product is smaller than L.2^256.
+void
+sc25519_mont_mul(
+    sc25519_mont*       r,
+    const sc25519_mont* x,
+    const sc25519_mont* y
+);
+
+/// r = x.x.R^-1 mod L. x.value shall be smaller than L.
+void
+sc25519_mont_sqr(
+    sc25519_mont*       r,
+    const sc25519_mont* x
+);
+
+/// inversion modulo point group order with the divsteps of Bernstein and Yang
+/// (crypto/numerics/fe25519_invert_safegcd.c). Constant time, the inverse of
+/// zero is zero. result and in are allowed to overlap.
 void sc25519_invert(sc25519 *result, const sc25519* in);
 
+/// r[i] = x[i]^-1 for i = 0 .. n - 1 with a single sc25519_invert, e.g. for
+/// removing the blinding factors of many scalars. r and x shall not overlap.
+/// Constant time. If one of the x[i] is zero, all r[i] are zero.
+void
+sc25519_invert_batch(
+    sc25519       r[],
+    const sc25519 x[],
+    size_t        n
+);
+
+/// Same as sc25519_invert.
 void sc25519_inverse(UN_256bitValue *R, const UN_256bitValue *X);
 
+/// Variable time!
 void sc25519_binary_extended_gcd(UN_256bitValue *R, const UN_256bitValue *X, const UN_256bitValue *Y);
 
 #endif // #ifndef SC25519_HEADER_
@@ -0,0 +1,27 @@
+#ifndef LOCAL_SCRYPT_HEADER_
+#define LOCAL_SCRYPT_HEADER_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../include/crypto_target_config.h"
+
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_NEON)
+
+#define CRYPTO_HAS_SCRYPT_SIMD
+
+/// BlockMix of scrypt, out = BlockMix(in ^ v) for the 2 r blocks of 64 bytes
+/// of in, v may be NULL. The words of the blocks are stored in the diagonal
+/// order of scrypt.c (word 4 i + 5 k mod 16 at position 4 i + k), such that
+/// the four 128 bit vectors of a block are the diagonals of the Salsa20
+/// matrix. All buffers are aligned to 16 bytes, out differs from in and v.
+void
+crypto_scrypt_blockmix_simd(
+    uint32_t*       out,
+    const uint32_t* in,
+    const uint32_t* v,
+    size_t          r
+);
+
+#endif
+
+#endif // #ifndef LOCAL_SCRYPT_HEADER_
@@ -0,0 +1,22 @@
+#ifndef LOCAL_SHA512_HEADER_
+#define LOCAL_SHA512_HEADER_
+
+#include <stdint.h>
+#include "../include/crypto_hash.h"
+
+// Round constants, also used by the assembly and the multi-buffer kernels.
+extern const uint64_t g_sha512_K[80];
+
+#ifdef CRYPTO_HAS_AVX2
+
+/// Compresses one block in[k] into state[k] for each of the four lanes k.
+/// Requires a CPU supporting AVX2, see crypto_cpu_has_avx2().
+void
+crypto_hashblocks_sha512_x4_avx2(
+    uint64_t* const      state[4],
+    const uint8_t* const in[4]
+);
+
+#endif
+
+#endif // #ifndef LOCAL_SHA512_HEADER_
@@ -0,0 +1,118 @@
+#ifndef LOCAL_SIMD_HEADER_
+#define LOCAL_SIMD_HEADER_
+
+#include "../include/crypto_target_config.h"
+
+// Output stage of the multi-block stream kernels (salsa20_simd.c,
+// chacha20_simd.c). Word i of the blocks resides in the lanes of x[i]. The
+// macros transpose the words back to the blocks and write them to
+// c = m ^ keystream, m may be NULL.
+
+#if defined(CRYPTO_HAS_SSE2) || defined(CRYPTO_HAS_AVX2)
+#include <immintrin.h>
+#endif
+
+#ifdef CRYPTO_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef CRYPTO_HAS_SSE2
+
+// Writes words i .. i + 3 of four blocks.
+#define SIMD_SSE2_STORE4(x, i, c, m)                                                                 \
+    {                                                                                                \
+        __m128i t0 = _mm_unpacklo_epi32(x[i], x[(i) + 1]);                                           \
+        __m128i t1 = _mm_unpacklo_epi32(x[(i) + 2], x[(i) + 3]);                                     \
+        __m128i t2 = _mm_unpackhi_epi32(x[i], x[(i) + 1]);                                           \
+        __m128i t3 = _mm_unpackhi_epi32(x[(i) + 2], x[(i) + 3]);                                     \
+        __m128i r[4];                                                                                \
+        int     b;                                                                                   \
+                                                                                                     \
+        r[0] = _mm_unpacklo_epi64(t0, t1);                                                           \
+        r[1] = _mm_unpackhi_epi64(t0, t1);                                                           \
+        r[2] = _mm_unpacklo_epi64(t2, t3);                                                           \
+        r[3] = _mm_unpackhi_epi64(t2, t3);                                                           \
+        for (b = 0; b < 4; b++)                                                                      \
+        {                                                                                            \
+            if (m)                                                                                   \
+            {                                                                                        \
+                r[b] = _mm_xor_si128(r[b], _mm_loadu_si128((const __m128i*)((m) + 64 * b + 4 * (i)))); \
+            }                                                                                        \
+            _mm_storeu_si128((__m128i*)((c) + 64 * b + 4 * (i)), r[b]);                              \
+        }                                                                                            \
+    }
+
+#endif // #ifdef CRYPTO_HAS_SSE2
+
+#ifdef CRYPTO_HAS_NEON
+
+// Writes words i .. i + 3 of four blocks.
+#define SIMD_NEON_STORE4(x, i, c, m)                                                        \
+    {                                                                                       \
+        uint32x4x2_t t0 = vtrnq_u32(x[i], x[(i) + 1]);                                      \
+        uint32x4x2_t t1 = vtrnq_u32(x[(i) + 2], x[(i) + 3]);                                \
+        uint32x4_t   r[4];                                                                  \
+        int          b;                                                                     \
+                                                                                            \
+        r[0] = vcombine_u32(vget_low_u32(t0.val[0]), vget_low_u32(t1.val[0]));              \
+        r[1] = vcombine_u32(vget_low_u32(t0.val[1]), vget_low_u32(t1.val[1]));              \
+        r[2] = vcombine_u32(vget_high_u32(t0.val[0]), vget_high_u32(t1.val[0]));            \
+        r[3] = vcombine_u32(vget_high_u32(t0.val[1]), vget_high_u32(t1.val[1]));            \
+        for (b = 0; b < 4; b++)                                                             \
+        {                                                                                   \
+            uint8x16_t bytes = vreinterpretq_u8_u32(r[b]);                                  \
+                                                                                            \
+            if (m)                                                                          \
+            {                                                                               \
+                bytes = veorq_u8(bytes, vld1q_u8((m) + 64 * b + 4 * (i)));                  \
+            }                                                                               \
+            vst1q_u8((c) + 64 * b + 4 * (i), bytes);                                        \
+        }                                                                                   \
+    }
+
+#endif // #ifdef CRYPTO_HAS_NEON
+
+#ifdef CRYPTO_HAS_AVX2
+
+// 4x4 transpose of words i .. i + 3 within both 128 bit halves: r[b] holds the
+// words of block b in the low half and of block b + 4 in the high half.
+#define SIMD_AVX2_TRANSPOSE4(r, x, i)                               \
+    {                                                               \
+        __m256i t0 = _mm256_unpacklo_epi32(x[i], x[(i) + 1]);       \
+        __m256i t1 = _mm256_unpacklo_epi32(x[(i) + 2], x[(i) + 3]); \
+        __m256i t2 = _mm256_unpackhi_epi32(x[i], x[(i) + 1]);       \
+        __m256i t3 = _mm256_unpackhi_epi32(x[(i) + 2], x[(i) + 3]); \
+                                                                    \
+        r[0] = _mm256_unpacklo_epi64(t0, t1);                       \
+        r[1] = _mm256_unpackhi_epi64(t0, t1);                       \
+        r[2] = _mm256_unpacklo_epi64(t2, t3);                       \
+        r[3] = _mm256_unpackhi_epi64(t2, t3);                       \
+    }
+
+// Writes words i .. i + 7 of eight blocks. Only for functions compiled for AVX2.
+#define SIMD_AVX2_STORE8(x, i, c, m)                                                                        \
+    {                                                                                                       \
+        __m256i r0[4];                                                                                      \
+        __m256i r1[4];                                                                                      \
+        int     b;                                                                                          \
+                                                                                                            \
+        SIMD_AVX2_TRANSPOSE4(r0, x, i);                                                                     \
+        SIMD_AVX2_TRANSPOSE4(r1, x, (i) + 4);                                                               \
+        for (b = 0; b < 4; b++)                                                                             \
+        {                                                                                                   \
+            __m256i lowBlock = _mm256_permute2x128_si256(r0[b], r1[b], 0x20);                               \
+            __m256i highBlock = _mm256_permute2x128_si256(r0[b], r1[b], 0x31);                              \
+                                                                                                            \
+            if (m)                                                                                          \
+            {                                                                                               \
+                lowBlock = _mm256_xor_si256(lowBlock, _mm256_loadu_si256((const __m256i*)((m) + 64 * b + 4 * (i)))); \
+                highBlock = _mm256_xor_si256(highBlock, _mm256_loadu_si256((const __m256i*)((m) + 64 * (b + 4) + 4 * (i)))); \
+            }                                                                                               \
+            _mm256_storeu_si256((__m256i*)((c) + 64 * b + 4 * (i)), lowBlock);                              \
+            _mm256_storeu_si256((__m256i*)((c) + 64 * (b + 4) + 4 * (i)), highBlock);                       \
+        }                                                                                                   \
+    }
+
+#endif // #ifdef CRYPTO_HAS_AVX2
+
+#endif // #ifndef LOCAL_SIMD_HEADER_
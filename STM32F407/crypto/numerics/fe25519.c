@@ -15,6 +15,11 @@
 #include "../include/randombytes.h"
 #include <stdio.h>
 
+#ifndef CRYPTO_HAS_FE25519_RADIX51
+
+// The functions up to fe25519_generateRandomValue() depend on the packed representation.
+// For targets using five limbs of 51 bits, they are found in fe25519_radix51.c.
+
 #ifndef OPTIMIZE_MPY_WITH_121666
 #define OPTIMIZE_MPY_WITH_121666 1
 #endif
@@ -184,7 +189,7 @@ fe25519_iszero(
 
     bitsSetMask = 0;
 
-    for (ctr = 1; ctr < 8; ctr++)
+    for (ctr = 0; ctr < 8; ctr++)
     {
         bitsSetMask |= in->as_uint32_t[ctr];
     }
@@ -619,59 +624,46 @@ fe25519_generateRandomValue(
     randombytes (result->as_uint8_t, 32);
 }
 
-// Algorithm 3.37 from the Handbook of Applied Cryptography
+// Curve constants of curve25519 with A = 486662.
+
+// 1
+const fe25519 fe25519_one =
+{{
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+}};
+
+// -A = -486662
+const fe25519 fe25519_minusA =
+{{
+    0xe7, 0x92, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+}};
+
+// -A / 2 = -243331
+const fe25519 fe25519_minusAdiv2 =
+{{
+    0x6a, 0x49, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+}};
+
+// A^2
+const fe25519 fe25519_Asquare =
+{{
+    0x24, 0x1c, 0xc2, 0x24, 0x37, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+}};
+
+#endif // #ifndef CRYPTO_HAS_FE25519_RADIX51
+
 void
 fe25519_squareroot(
     fe25519*        result,
     const fe25519*  in
 )
 {
-    fe25519 d, b, one;
-    int i;
-    fe25519_cpy(&d, in);
-    fe25519_setone(&one);
-    fe25519_cpy(&b, in);
-    // Compute d=a^((p-1)/4)
+    fe25519 one;
 
-    fe25519_square(&d, &d);
-    fe25519_mul(&b, &d, &b);
-
-    fe25519_square(&d, &d);
-
-    for(i=0;i<250;i++) {
-        fe25519_square(&d, &d);
-        fe25519_mul(&b, &d, &b);
-    }
-
-    fe25519 r;
-    if(fe25519_iseq_vartime(&b, &one)) {
-        // b=1
-        // r=a^((p+3)/8)
-        fe25519_cpy(&d, in);
-        fe25519_setone(result);
-        for(i=0;i<251;i++) {
-            // square and multiply
-            fe25519_square(&d, &d);
-            fe25519_mul(result, result, &d);
-        }
-    } else {
-        // b=p-1
-        // r=2a(4a)^((p-5)/8)
-        fe25519_add(&r, in, in);
-        fe25519_add(result, &r, &r);
-
-        fe25519_cpy(&d, result);
-
-        fe25519_square(&d, &d);
-
-        for(i=0;i<250;i++) {
-            fe25519_square(&d, &d);
-            fe25519_mul(result, result, &d);
-        }
-        fe25519_mul(result, result, &r);
-    }
+    fe25519_setone(&one);
+    fe25519_sqrt_ratio(result, in, &one);
 }
-
-
-
-
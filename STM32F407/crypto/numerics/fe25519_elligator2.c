@@ -0,0 +1,108 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file fe25519_elligator2.c
+
+    Elligator2 map for curve25519 with the non-square 2, i.e.
+    v = -A / (1 + 2.r^2) and x = v if v^3 + A.v^2 + v is a square and
+    x = -v - A otherwise.
+
+    fe25519_elligator2() uses the single exponentiation of
+    fe25519_elligator2_isrt.c. fe25519_elligator2x_useProvidedScratchBuffers()
+    is the textbook variant with an inversion and a Legendre symbol, i.e.
+    two exponentiations. fe25519_elligator2_batch() maps four elements at once
+    in the AVX2 lanes if the CPU supports it.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include "../include/fe25519.h"
+
+void
+fe25519_elligator2x_useProvidedScratchBuffers(
+    fe25519*       x,
+    const fe25519* r,
+    // Scratch buffers
+    fe25519*       t0,
+    fe25519*       t1,
+    fe25519*       t2,
+    fe25519*       t3,
+    fe25519*       v
+    )
+{
+    fe25519_square(t0, r); // t0 = [r]^2
+    fe25519_add(t1, t0, t0); // t1 = [r^2] + [r^2]
+    fe25519_add(x, t1, &fe25519_one); // x = 1 + [2.r^2]
+    fe25519_invert_useProvidedScratchBuffers(t3, x, t0, t1, t2); // t3 = 1 / (1 + 2.r^2)
+    fe25519_mul(v, t3, &fe25519_minusA); // v = [-A] * [1/(1 + 2.r^2)]
+
+    // w = v.(v^2 + A.v + 1)
+    fe25519_sub(t0, v, &fe25519_minusA); // t0 = [v] + A
+    fe25519_mul(t1, t0, v); // t1 = [v + A] * [v]
+    fe25519_add(t0, t1, &fe25519_one); // t0 = [v^2 + A.v] + 1
+    fe25519_mul(x, t0, v); // x = w = [v^2 + A.v + 1] * [v]
+
+    // epsilon = w^((p - 1) / 2) = w^(2^254 - 10)
+    fe25519_pow2523_useProvidedScratchBuffers(t3, x, t0, t1, t2);
+    // t3 is now w ^ (2^252 - 3)
+    fe25519_square(t3, t3);
+    fe25519_square(t3, t3);
+    // t3 is now w ^ (2^254 - 12)
+    fe25519_square(t0, x);
+    fe25519_mul(t1, t3, t0); // t1 = epsilon = [w ^ (2^254 - 12)] * [w^2]
+
+    fe25519_sub(t2, &fe25519_one, t1); // t2 = 1 - [epsilon]
+    fe25519_mul(t0, t1, v); // t0 = [epsilon] * [v]
+    fe25519_mul(t3, &fe25519_minusAdiv2, t2); // t3 = [-A/2] * [1 - epsilon]
+    fe25519_add(x, t0, t3); // x = [epsilon.v] + [-A/2.(1 - epsilon)]
+}
+
+void
+fe25519_elligator2_useProvidedScratchBuffers(
+    fe25519*       x,
+    const fe25519* r,
+    // Scratch buffers
+    fe25519*       t0,
+    fe25519*       t1,
+    fe25519*       t2,
+    fe25519*       t3,
+    fe25519*       v
+    )
+{
+    fe25519_elligator2_isrt_useProvidedScratchBuffers(x, r, t0, t1, t2, t3, v);
+}
+
+void
+fe25519_elligator2(
+    fe25519*       x,
+    const fe25519* r)
+{
+    fe25519_elligator2_isrt(x, r);
+}
+
+void
+fe25519_elligator2_batch(
+    fe25519*       x,
+    const fe25519* r,
+    size_t         n
+    )
+{
+    size_t i = 0;
+
+#ifdef CRYPTO_HAS_AVX2
+    if (crypto_cpu_has_avx2())
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            fe25519_elligator2_x4_avx2(&x[i], &r[i]);
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        fe25519_elligator2_isrt(&x[i], &r[i]);
+    }
+}
@@ -13,11 +13,10 @@
 
     License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
   ============================================================================*/
-#include "../local_includes/fe25519.h"
-#include "../local_includes/simple_randombytes.h"
+#include "../include/fe25519.h"
 
 // s = (c.d^2)^((p-3)/2)
-void
+static void
 fe25519_elligator2s_useProvidedScratchBuffers(
     fe25519*       r,
     const fe25519* x,
@@ -0,0 +1,149 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file fe25519_elligator2_x4_avx2.c
+
+    Four Elligator2 maps in the lanes of the AVX2 registers, with the
+    formulas and the single exponentiation of fe25519_elligator2_isrt.c.
+    Compiled with function level target attributes, the caller checks for
+    AVX2 support at runtime.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include "../include/fe25519x4_avx2.h"
+
+#ifdef CRYPTO_HAS_AVX2
+
+// r = a^(2^n)
+static AVX2_FUNCTION void
+fe25519x4_square_n(
+    fe25519x4*       r,
+    const fe25519x4* a,
+    int              n
+)
+{
+    fe25519x4_square(r, a);
+    while (--n)
+    {
+        fe25519x4_square(r, r);
+    }
+}
+
+// r = x^(2^252 - 3), same addition chain as fe25519_pow2523().
+static AVX2_FUNCTION void
+fe25519x4_pow2523(
+    fe25519x4*       r,
+    const fe25519x4* x
+)
+{
+    fe25519x4 z2, z9, z2_5_0, z2_10_0, z2_20_0, z2_50_0, z2_100_0, t;
+
+    fe25519x4_square(&z2, x);
+    fe25519x4_square_n(&t, &z2, 2);
+    fe25519x4_mul(&z9, &t, x);
+    fe25519x4_mul(&t, &z9, &z2);          // z11
+    fe25519x4_square(&t, &t);             // z22
+    fe25519x4_mul(&z2_5_0, &t, &z9);      // 2^5 - 2^0
+
+    fe25519x4_square_n(&t, &z2_5_0, 5);
+    fe25519x4_mul(&z2_10_0, &t, &z2_5_0);
+    fe25519x4_square_n(&t, &z2_10_0, 10);
+    fe25519x4_mul(&z2_20_0, &t, &z2_10_0);
+    fe25519x4_square_n(&t, &z2_20_0, 20);
+    fe25519x4_mul(&t, &t, &z2_20_0);      // 2^40 - 2^0
+    fe25519x4_square_n(&t, &t, 10);
+    fe25519x4_mul(&z2_50_0, &t, &z2_10_0);
+    fe25519x4_square_n(&t, &z2_50_0, 50);
+    fe25519x4_mul(&z2_100_0, &t, &z2_50_0);
+    fe25519x4_square_n(&t, &z2_100_0, 100);
+    fe25519x4_mul(&t, &t, &z2_100_0);     // 2^200 - 2^0
+    fe25519x4_square_n(&t, &t, 50);
+    fe25519x4_mul(&t, &t, &z2_50_0);      // 2^250 - 2^0
+    fe25519x4_square_n(&t, &t, 2);
+    fe25519x4_mul(r, &t, x);              // 2^252 - 3
+}
+
+// Loads x[k] into lane k.
+static AVX2_FUNCTION void
+fe25519x4_load(
+    fe25519x4*     r,
+    const fe25519* x0,
+    const fe25519* x1,
+    const fe25519* x2,
+    const fe25519* x3
+)
+{
+    uint8_t packed[4][32];
+    fe25519 t;
+
+    fe25519_cpy(&t, x0);
+    fe25519_pack(packed[0], &t);
+    fe25519_cpy(&t, x1);
+    fe25519_pack(packed[1], &t);
+    fe25519_cpy(&t, x2);
+    fe25519_pack(packed[2], &t);
+    fe25519_cpy(&t, x3);
+    fe25519_pack(packed[3], &t);
+    fe25519x4_unpack(r, (const uint8_t (*)[32])packed);
+}
+
+AVX2_FUNCTION void
+fe25519_elligator2_x4_avx2(
+    fe25519*       x,
+    const fe25519* r
+)
+{
+    fe25519x4 one, Asquare, minusA, minusAdiv2;
+    fe25519x4 d, a, b, c, s, eps, t0, t1, t2, t3, v;
+    uint8_t   packed[4][32];
+    int       k;
+
+    fe25519x4_load(&one, &fe25519_one, &fe25519_one, &fe25519_one, &fe25519_one);
+    fe25519x4_load(&Asquare, &fe25519_Asquare, &fe25519_Asquare, &fe25519_Asquare, &fe25519_Asquare);
+    fe25519x4_load(&minusA, &fe25519_minusA, &fe25519_minusA, &fe25519_minusA, &fe25519_minusA);
+    fe25519x4_load(&minusAdiv2, &fe25519_minusAdiv2, &fe25519_minusAdiv2, &fe25519_minusAdiv2, &fe25519_minusAdiv2);
+    fe25519x4_load(&t3, &r[0], &r[1], &r[2], &r[3]);
+
+    // Limbs stay < 2^27 for the multiplications: sums are formed of carried
+    // values only.
+    fe25519x4_square(&t2, &t3);           // r^2
+    fe25519x4_add(&t0, &t2, &t2);         // 2.r^2
+    fe25519x4_add(&d, &t0, &one);         // d = 1 + 2.r^2
+
+    fe25519x4_mul(&t2, &Asquare, &t0);    // A^2.2.r^2
+    fe25519x4_square(&t1, &d);            // d^2
+    fe25519x4_sub(&t0, &t1, &t2);         // d^2 - A^2.2.r^2
+    fe25519x4_mul(&a, &t0, &minusA);      // a = -A.(d^2 - A^2.2.r^2)
+    fe25519x4_mul(&b, &d, &t1);           // b = d^3
+    fe25519x4_mul(&c, &a, &b);            // c = a.b
+
+    fe25519x4_mul(&t2, &c, &d);           // c.d
+    fe25519x4_mul(&v, &d, &t2);           // c.d^2
+
+    // s = (c.d^2)^(2^254 - 11)
+    fe25519x4_pow2523(&s, &v);
+    fe25519x4_square_n(&s, &s, 2);
+    fe25519x4_mul(&s, &s, &v);
+
+    fe25519x4_mul(&eps, &s, &v);          // epsilon = (c.d^2)^((p - 1) / 2)
+    fe25519x4_mul(&t3, &s, &eps);
+    fe25519x4_mul(&t1, &t3, &t2);         // 1/d = s.epsilon.c.d
+    fe25519x4_mul(&v, &t1, &minusA);      // v = -A/d
+
+    fe25519x4_sub(&t1, &one, &eps);       // 1 - epsilon
+    fe25519x4_mul(&t2, &eps, &v);         // epsilon.v
+    fe25519x4_mul(&t3, &minusAdiv2, &t1); // -A/2.(1 - epsilon)
+    fe25519x4_add(&t0, &t2, &t3);
+    fe25519x4_carry(t0.v);
+
+    fe25519x4_pack(packed, &t0);
+    for (k = 0; k < 4; k++)
+    {
+        fe25519_unpack(&x[k], packed[k]);
+    }
+}
+
+#endif // #ifdef CRYPTO_HAS_AVX2
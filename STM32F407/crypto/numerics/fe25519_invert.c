@@ -21,11 +21,73 @@ fe25519_invert(
     const fe25519* x
 )
 {   
+#ifdef CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+    fe25519_invert_safegcd(r, x);
+#else
     fe25519 t0;
     fe25519 t1;
     fe25519 t2;
     
     fe25519_invert_useProvidedScratchBuffers (r,x,&t0,&t1,&t2);
+#endif
+}
+
+// Montgomery's trick: out[i] = 1 / in[i] for i = 0 .. n-1 using one inversion
+// and 3 (n - 1) multiplications. Zero inputs are replaced by one for the
+// products and yield zero outputs, such that the remaining outputs are not
+// affected. Constant time. out and in are allowed to overlap!
+void
+fe25519_batch_invert(
+    fe25519*       out,
+    const fe25519* in,
+    size_t         n,
+    fe25519*       scratch
+)
+{
+    fe25519 one;
+    fe25519 zero;
+    fe25519 acc;
+    fe25519 t;
+    size_t  i;
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    fe25519_setone(&one);
+    fe25519_setzero(&zero);
+
+    // scratch[i] = in[0] * ... * in[i]
+    fe25519_cpy(&scratch[0], &in[0]);
+    fe25519_cmov(&scratch[0], &one, fe25519_iszero_01(&in[0]));
+    for (i = 1; i < n; i++)
+    {
+        fe25519_cpy(&t, &in[i]);
+        fe25519_cmov(&t, &one, fe25519_iszero_01(&in[i]));
+        fe25519_mul(&scratch[i], &scratch[i - 1], &t);
+    }
+
+    fe25519_invert(&acc, &scratch[n - 1]);
+
+    // acc = 1 / (in[0] * ... * in[i])
+    for (i = n - 1; i > 0; i--)
+    {
+        int isZero = fe25519_iszero_01(&in[i]);
+
+        fe25519_cpy(&t, &in[i]);
+        fe25519_cmov(&t, &one, isZero);
+        fe25519_mul(&scratch[i], &acc, &scratch[i - 1]);
+        fe25519_mul(&acc, &acc, &t);
+        fe25519_cpy(&out[i], &scratch[i]);
+        fe25519_cmov(&out[i], &zero, isZero);
+    }
+    {
+        int isZero = fe25519_iszero_01(&in[0]);
+
+        fe25519_cpy(&out[0], &acc);
+        fe25519_cmov(&out[0], &zero, isZero);
+    }
 }
 
 // Use this function if optimizing for stack consumption.
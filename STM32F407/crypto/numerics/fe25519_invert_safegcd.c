@@ -0,0 +1,381 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file fe25519_invert_safegcd.c
+
+    Constant time inversion modulo 2^255 - 19 and modulo the group order L
+    (sc25519_invert) based on the divsteps of
+    D. J. Bernstein and B.-Y. Yang, "Fast constant-time gcd computation and
+    modular inversion", using the "half delta" variant and the limb layout
+    of the libsecp256k1 implementation (P. Wuille).
+
+    590 divsteps are sufficient for 256 bit inputs. They are executed in
+    batches of N divsteps operating on the low bits of f and g only. The
+    resulting 2x2 transition matrix, scaled by 2^N, is then applied to the
+    full length values f, g and to the Bezout coefficients d, e.
+
+    Two versions are provided:
+    - 64 bit hosts (__int128 available): signed 62 bit limbs, 10 batches of 59 divsteps.
+    - portable 32 bit version: signed 30 bit limbs, 20 batches of 30 divsteps.
+      CRYPTO_NO_SAFEGCD_INT128 selects it also on 64 bit hosts, so that the
+      host tests cover the version running on the Cortex M4.
+
+    The input and output is converted by fe25519_pack and fe25519_unpack so that
+    this file is independent of the representation chosen for fe25519. Only the
+    modulus and its inverse modulo 2^62 or 2^30 differ between fe25519 and sc25519.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/fe25519.h"
+#include "../include/sc25519.h"
+
+// Note that the implementation relies on arithmetic right shifts of negative
+// signed values, which is the case for all compilers supported (GCC, CLANG).
+
+#if defined(__SIZEOF_INT128__) && !defined(CRYPTO_NO_SAFEGCD_INT128)
+
+typedef __int128 int128_t;
+
+#define SAFEGCD_LIMBS 5
+#define SAFEGCD_LIMB_BITS 62
+#define SAFEGCD_BATCHES 10
+#define SAFEGCD_DIVSTEPS_PER_BATCH 59
+
+typedef int64_t  safegcd_limb_t;
+typedef uint64_t safegcd_ulimb_t;
+typedef int128_t safegcd_accu_t;
+
+#define SAFEGCD_MODULUS_INV_25519 0x39435e50d79435e5ULL
+#define SAFEGCD_MODULUS_INV_ORDER 0x2d4ae25cedab81e5ULL
+
+// 2^255 - 19 = -19 + 2^7 * 2^(4 * 62)
+#define SAFEGCD_MODULUS_25519 { -19, 0, 0, 0, 128 }
+// L = 2^252 + 27742317777372353535851937790883648493
+#define SAFEGCD_MODULUS_ORDER { 0x1812631a5cf5d3edLL, 0x137be77a8bde7359LL, 1, 0, 16 }
+
+// The transition matrix is scaled by 2^62 in total, 2^59 from the divsteps and 2^3 initially.
+#define SAFEGCD_MATRIX_INITIAL_SCALE 8
+
+#else
+
+#define SAFEGCD_LIMBS 9
+#define SAFEGCD_LIMB_BITS 30
+#define SAFEGCD_BATCHES 20
+#define SAFEGCD_DIVSTEPS_PER_BATCH 30
+
+typedef int32_t  safegcd_limb_t;
+typedef uint32_t safegcd_ulimb_t;
+typedef int64_t  safegcd_accu_t;
+
+#define SAFEGCD_MODULUS_INV_25519 0x179435e5UL
+#define SAFEGCD_MODULUS_INV_ORDER 0x2dab81e5UL
+
+// 2^255 - 19 = -19 + 2^15 * 2^(8 * 30)
+#define SAFEGCD_MODULUS_25519 { -19, 0, 0, 0, 0, 0, 0, 0, 32768 }
+// L = 2^252 + 27742317777372353535851937790883648493
+#define SAFEGCD_MODULUS_ORDER { 0x1cf5d3edL, 0x20498c69L, 0x2f79cd65L, 0x37be77a8L, 20, 0, 0, 0, 4096 }
+
+#define SAFEGCD_MATRIX_INITIAL_SCALE 1
+
+#endif
+
+#define SAFEGCD_LIMB_MASK ((safegcd_ulimb_t)(((safegcd_ulimb_t)-1) >> ((8 * sizeof(safegcd_limb_t)) - SAFEGCD_LIMB_BITS)))
+#define SAFEGCD_SIGN_SHIFT ((8 * sizeof(safegcd_limb_t)) - 1)
+
+/// Odd modulus m in signed limbs and m^-1 mod 2^SAFEGCD_LIMB_BITS.
+typedef struct
+{
+    safegcd_limb_t  limbs[SAFEGCD_LIMBS];
+    safegcd_ulimb_t inv;
+} safegcd_modulus;
+
+static const safegcd_modulus safegcd_modulus_25519 = { SAFEGCD_MODULUS_25519, SAFEGCD_MODULUS_INV_25519 };
+static const safegcd_modulus safegcd_modulus_order = { SAFEGCD_MODULUS_ORDER, SAFEGCD_MODULUS_INV_ORDER };
+
+/// Transition matrix [[u, v], [q, r]] of one batch of divsteps.
+typedef struct
+{
+    safegcd_limb_t u;
+    safegcd_limb_t v;
+    safegcd_limb_t q;
+    safegcd_limb_t r;
+} safegcd_matrix;
+
+// Executes SAFEGCD_DIVSTEPS_PER_BATCH divsteps on the low bits f0 and g0 of f and g.
+// zeta is -(delta + 1/2). Constant time. Intermediate values are kept unsigned
+// modulo 2^32 or 2^64 respectively so that left shifts of negative values are defined.
+static safegcd_limb_t
+safegcd_divsteps(
+    safegcd_limb_t  zeta,
+    safegcd_ulimb_t f0,
+    safegcd_ulimb_t g0,
+    safegcd_matrix* t
+)
+{
+    safegcd_ulimb_t u = SAFEGCD_MATRIX_INITIAL_SCALE, v = 0, q = 0, r = SAFEGCD_MATRIX_INITIAL_SCALE;
+    safegcd_ulimb_t f = f0, g = g0;
+    safegcd_ulimb_t x, y, z;
+    volatile safegcd_ulimb_t c1, c2;
+    safegcd_ulimb_t mask1, mask2;
+    int i;
+
+    for (i = 0; i < SAFEGCD_DIVSTEPS_PER_BATCH; i++)
+    {
+        // mask1: zeta < 0, mask2: g is odd.
+        c1 = (safegcd_ulimb_t)(zeta >> SAFEGCD_SIGN_SHIFT);
+        mask1 = c1;
+        c2 = g & 1;
+        mask2 = -c2;
+
+        // Conditionally negated versions of f, u, v.
+        x = (f ^ mask1) - mask1;
+        y = (u ^ mask1) - mask1;
+        z = (v ^ mask1) - mask1;
+
+        // If g is odd: g += x, q += y, r += z.
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+
+        // If zeta < 0 and g is odd: zeta = -zeta - 2, (f, u, v) += (g, q, r). Otherwise zeta = zeta - 1.
+        mask1 &= mask2;
+        zeta = (zeta ^ (safegcd_limb_t)mask1) - 1;
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+
+    t->u = (safegcd_limb_t)u;
+    t->v = (safegcd_limb_t)v;
+    t->q = (safegcd_limb_t)q;
+    t->r = (safegcd_limb_t)r;
+    return zeta;
+}
+
+// [d, e] = t * [d, e] / 2^SAFEGCD_LIMB_BITS modulo m.
+// Input and output values are in the range (-2m, m). Constant time.
+static void
+safegcd_update_de(
+    safegcd_limb_t         d[SAFEGCD_LIMBS],
+    safegcd_limb_t         e[SAFEGCD_LIMBS],
+    const safegcd_matrix*  t,
+    const safegcd_modulus* m
+)
+{
+    const safegcd_limb_t u = t->u, v = t->v, q = t->q, r = t->r;
+    safegcd_limb_t       md, me, sd, se;
+    safegcd_accu_t       cd, ce;
+    int                  i;
+
+    // Start with [md, me] = 0, add [u, q] if d is negative and [v, r] if e is negative.
+    // This keeps the result within (-2m, m).
+    sd = d[SAFEGCD_LIMBS - 1] >> SAFEGCD_SIGN_SHIFT;
+    se = e[SAFEGCD_LIMBS - 1] >> SAFEGCD_SIGN_SHIFT;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+
+    cd = (safegcd_accu_t)u * d[0] + (safegcd_accu_t)v * e[0];
+    ce = (safegcd_accu_t)q * d[0] + (safegcd_accu_t)r * e[0];
+
+    // Correct md and me such that t * [d, e] + m * [md, me] is divisible by 2^SAFEGCD_LIMB_BITS.
+    md -= (safegcd_limb_t)((m->inv * (safegcd_ulimb_t)cd + (safegcd_ulimb_t)md) & SAFEGCD_LIMB_MASK);
+    me -= (safegcd_limb_t)((m->inv * (safegcd_ulimb_t)ce + (safegcd_ulimb_t)me) & SAFEGCD_LIMB_MASK);
+
+    cd += (safegcd_accu_t)m->limbs[0] * md;
+    ce += (safegcd_accu_t)m->limbs[0] * me;
+    cd >>= SAFEGCD_LIMB_BITS;
+    ce >>= SAFEGCD_LIMB_BITS;
+
+    for (i = 1; i < SAFEGCD_LIMBS; i++)
+    {
+        cd += (safegcd_accu_t)u * d[i] + (safegcd_accu_t)v * e[i];
+        ce += (safegcd_accu_t)q * d[i] + (safegcd_accu_t)r * e[i];
+        cd += (safegcd_accu_t)m->limbs[i] * md;
+        ce += (safegcd_accu_t)m->limbs[i] * me;
+        d[i - 1] = (safegcd_limb_t)((safegcd_ulimb_t)cd & SAFEGCD_LIMB_MASK);
+        e[i - 1] = (safegcd_limb_t)((safegcd_ulimb_t)ce & SAFEGCD_LIMB_MASK);
+        cd >>= SAFEGCD_LIMB_BITS;
+        ce >>= SAFEGCD_LIMB_BITS;
+    }
+    d[SAFEGCD_LIMBS - 1] = (safegcd_limb_t)cd;
+    e[SAFEGCD_LIMBS - 1] = (safegcd_limb_t)ce;
+}
+
+// [f, g] = t * [f, g] / 2^SAFEGCD_LIMB_BITS. The division is exact.
+static void
+safegcd_update_fg(
+    safegcd_limb_t        f[SAFEGCD_LIMBS],
+    safegcd_limb_t        g[SAFEGCD_LIMBS],
+    const safegcd_matrix* t
+)
+{
+    const safegcd_limb_t u = t->u, v = t->v, q = t->q, r = t->r;
+    safegcd_accu_t       cf, cg;
+    int                  i;
+
+    cf = (safegcd_accu_t)u * f[0] + (safegcd_accu_t)v * g[0];
+    cg = (safegcd_accu_t)q * f[0] + (safegcd_accu_t)r * g[0];
+    cf >>= SAFEGCD_LIMB_BITS;
+    cg >>= SAFEGCD_LIMB_BITS;
+
+    for (i = 1; i < SAFEGCD_LIMBS; i++)
+    {
+        cf += (safegcd_accu_t)u * f[i] + (safegcd_accu_t)v * g[i];
+        cg += (safegcd_accu_t)q * f[i] + (safegcd_accu_t)r * g[i];
+        f[i - 1] = (safegcd_limb_t)((safegcd_ulimb_t)cf & SAFEGCD_LIMB_MASK);
+        g[i - 1] = (safegcd_limb_t)((safegcd_ulimb_t)cg & SAFEGCD_LIMB_MASK);
+        cf >>= SAFEGCD_LIMB_BITS;
+        cg >>= SAFEGCD_LIMB_BITS;
+    }
+    f[SAFEGCD_LIMBS - 1] = (safegcd_limb_t)cf;
+    g[SAFEGCD_LIMBS - 1] = (safegcd_limb_t)cg;
+}
+
+// Propagates the carries such that all limbs but the most significant one are
+// in [0, 2^SAFEGCD_LIMB_BITS).
+static void
+safegcd_propagate(
+    safegcd_limb_t r[SAFEGCD_LIMBS]
+)
+{
+    int i;
+
+    for (i = 0; i < (SAFEGCD_LIMBS - 1); i++)
+    {
+        r[i + 1] += r[i] >> SAFEGCD_LIMB_BITS;
+        r[i] &= (safegcd_limb_t)SAFEGCD_LIMB_MASK;
+    }
+}
+
+// Maps r from (-2m, m) to [0, m) and negates it if sign is negative. Constant time.
+static void
+safegcd_normalize(
+    safegcd_limb_t         r[SAFEGCD_LIMBS],
+    safegcd_limb_t         sign,
+    const safegcd_modulus* m
+)
+{
+    volatile safegcd_limb_t condAdd, condNegate;
+    int i;
+
+    // (-2m, m) => (-m, m)
+    condAdd = r[SAFEGCD_LIMBS - 1] >> SAFEGCD_SIGN_SHIFT;
+    for (i = 0; i < SAFEGCD_LIMBS; i++)
+    {
+        r[i] += m->limbs[i] & condAdd;
+    }
+
+    condNegate = sign >> SAFEGCD_SIGN_SHIFT;
+    for (i = 0; i < SAFEGCD_LIMBS; i++)
+    {
+        r[i] = (r[i] ^ condNegate) - condNegate;
+    }
+    safegcd_propagate(r);
+
+    // (-m, m) => [0, m)
+    condAdd = r[SAFEGCD_LIMBS - 1] >> SAFEGCD_SIGN_SHIFT;
+    for (i = 0; i < SAFEGCD_LIMBS; i++)
+    {
+        r[i] += m->limbs[i] & condAdd;
+    }
+    safegcd_propagate(r);
+}
+
+// bytes = bytes^-1 mod m, little endian. bytes shall be smaller than 2^256.
+// The inverse of 0 is 0.
+static void
+safegcd_invert(
+    uint8_t                bytes[32],
+    const safegcd_modulus* m
+)
+{
+    safegcd_limb_t d[SAFEGCD_LIMBS];
+    safegcd_limb_t e[SAFEGCD_LIMBS];
+    safegcd_limb_t f[SAFEGCD_LIMBS];
+    safegcd_limb_t g[SAFEGCD_LIMBS];
+    safegcd_limb_t zeta = -1; // delta = 1/2
+    safegcd_matrix t;
+    int            i, bit;
+
+    // Split the input into limbs of SAFEGCD_LIMB_BITS bits.
+    for (i = 0; i < SAFEGCD_LIMBS; i++)
+    {
+        d[i] = 0;
+        e[i] = 0;
+        f[i] = m->limbs[i];
+        g[i] = 0;
+    }
+    e[0] = 1;
+
+    for (bit = 0; bit < 256; bit += 8)
+    {
+        g[bit / SAFEGCD_LIMB_BITS] |= (safegcd_limb_t)(((safegcd_ulimb_t)bytes[bit >> 3] << (bit % SAFEGCD_LIMB_BITS)) & SAFEGCD_LIMB_MASK);
+        if (((bit % SAFEGCD_LIMB_BITS) + 8) > SAFEGCD_LIMB_BITS)
+        {
+            g[(bit / SAFEGCD_LIMB_BITS) + 1] |= (safegcd_limb_t)(bytes[bit >> 3] >> (SAFEGCD_LIMB_BITS - (bit % SAFEGCD_LIMB_BITS)));
+        }
+    }
+
+    for (i = 0; i < SAFEGCD_BATCHES; i++)
+    {
+        zeta = safegcd_divsteps(zeta, (safegcd_ulimb_t)f[0], (safegcd_ulimb_t)g[0], &t);
+        safegcd_update_de(d, e, &t, m);
+        safegcd_update_fg(f, g, &t);
+    }
+
+    // Now g == 0 and f == +-1 (or f == m for x == 0, yielding d == 0).
+    safegcd_normalize(d, f[SAFEGCD_LIMBS - 1], m);
+
+    for (i = 0; i < 32; i++)
+    {
+        bytes[i] = 0;
+    }
+    for (bit = 0; bit < 256; bit += 8)
+    {
+        safegcd_ulimb_t b = (safegcd_ulimb_t)d[bit / SAFEGCD_LIMB_BITS] >> (bit % SAFEGCD_LIMB_BITS);
+
+        if (((bit % SAFEGCD_LIMB_BITS) + 8) > SAFEGCD_LIMB_BITS)
+        {
+            b |= (safegcd_ulimb_t)d[(bit / SAFEGCD_LIMB_BITS) + 1] << (SAFEGCD_LIMB_BITS - (bit % SAFEGCD_LIMB_BITS));
+        }
+        bytes[bit >> 3] = (uint8_t)b;
+    }
+}
+
+// Note, that r and x are allowed to overlap!
+void
+fe25519_invert_safegcd(
+    fe25519*       r,
+    const fe25519* x
+)
+{
+    uint8_t bytes[32];
+    fe25519 tmp;
+
+    fe25519_cpy(&tmp, x);
+    fe25519_pack(bytes, &tmp);
+    safegcd_invert(bytes, &safegcd_modulus_25519);
+    fe25519_unpack(r, bytes);
+}
+
+// Note, that r and x are allowed to overlap!
+void
+sc25519_invert(
+    sc25519*       r,
+    const sc25519* x
+)
+{
+    uint8_t bytes[32];
+
+    sc25519_to32bytes(bytes, x);
+    safegcd_invert(bytes, &safegcd_modulus_order);
+    sc25519_from32bytes(r, bytes);
+}
@@ -10,7 +10,7 @@
 
     License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
   ============================================================================*/
-#include "../local_includes/fe25519.h"
+#include "../include/fe25519.h"
 
 void
 fe25519_pow2523(
@@ -113,3 +113,76 @@ fe25519_pow2523_useProvidedScratchBuffers(
     /* 2^252 - 2^2 */ fe25519_square(t0, t0);
     /* 2^252 - 3 */ fe25519_mul(r, t0, x);
 }
+
+const uint8_t fe25519_sqrtMinusOne_packed[32] =
+{
+    0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b
+};
+
+int32_t
+fe25519_iszero_01(
+    const fe25519* x
+)
+{
+    fe25519  t;
+    uint32_t nonzero;
+
+    fe25519_cpy(&t, x);
+    nonzero = (uint32_t)fe25519_iszero(&t);
+    return (int32_t)(1 ^ ((nonzero | (0 - nonzero)) >> 31));
+}
+
+int32_t
+fe25519_iseq(
+    const fe25519* a,
+    const fe25519* b
+)
+{
+    fe25519 t;
+
+    fe25519_sub(&t, a, b);
+    return fe25519_iszero_01(&t);
+}
+
+// Candidate r = u.v^3.(u.v^7)^((p - 5) / 8). Then v.r^2 is one of u, -u, sqrt(-1).u
+// or -sqrt(-1).u. In the second and fourth case, r.sqrt(-1) is the square root.
+int32_t
+fe25519_sqrt_ratio(
+    fe25519*       r,
+    const fe25519* u,
+    const fe25519* v
+)
+{
+    fe25519 v3, t, check, minusU, sqrtMinusOne;
+    fe25519 t0, t1, t2;
+    int32_t correct, flipped, flippedTimesI;
+
+    fe25519_square(&v3, v);
+    fe25519_mul(&v3, &v3, v);      // v^3
+    fe25519_square(&t, &v3);
+    fe25519_mul(&t, &t, v);        // v^7
+    fe25519_mul(&t, &t, u);        // u.v^7
+
+    fe25519_pow2523_useProvidedScratchBuffers(&t, &t, &t0, &t1, &t2);
+
+    fe25519_mul(&t, &t, &v3);
+    fe25519_mul(&t, &t, u);        // r = u.v^3.(u.v^7)^((p - 5) / 8)
+
+    fe25519_square(&check, &t);
+    fe25519_mul(&check, &check, v);
+
+    fe25519_neg(&minusU, u);
+    fe25519_unpack(&sqrtMinusOne, fe25519_sqrtMinusOne_packed);
+
+    correct = fe25519_iseq(&check, u);
+    flipped = fe25519_iseq(&check, &minusU);
+    fe25519_mul(&t0, &minusU, &sqrtMinusOne);
+    flippedTimesI = fe25519_iseq(&check, &t0);
+
+    fe25519_mul(&t0, &t, &sqrtMinusOne);
+    fe25519_cmov(&t, &t0, flipped | flippedTimesI);
+
+    fe25519_cpy(r, &t);
+    return correct | flipped;
+}
@@ -0,0 +1,473 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file fe25519_radix51.c
+
+    modulo 2^255 - 19 arithmetic for 64 bit hosts using five limbs of 51 bits
+    and 64x64 => 128 bit products.
+
+    Limbs are not carried after additions (lazy carries). The bounds are:
+     - fe25519_mul() and fe25519_square() accept limbs < 2^58.
+     - fe25519_sub() accepts subtrahends with limbs < 2^54.
+     - All other operations return limbs < 2^52, fe25519_add() returns the
+       limb-wise sum of its inputs.
+    I.e. sums of up to four results of other operations may be subtracted and
+    sums of up to 64 results may be multiplied without intermediate carries.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/fe25519.h"
+#include "../include/randombytes.h"
+
+#ifdef CRYPTO_HAS_FE25519_RADIX51
+
+typedef unsigned __int128 uint128_t;
+
+#define FE25519_MASK51 ((((uint64_t)1) << 51) - 1)
+
+// 16 * (2^255 - 19) in radix 2^51. Added before subtracting so that all limbs stay positive.
+#define FE25519_16P_LIMB0 ((((uint64_t)1) << 55) - 304)
+#define FE25519_16P_LIMBN ((((uint64_t)1) << 55) - 16)
+
+static uint64_t
+load_littleendian64(
+    const uint8_t* x
+)
+{
+    uint64_t r = 0;
+    int      ctr;
+
+    for (ctr = 7; ctr >= 0; ctr--)
+    {
+        r = (r << 8) | x[ctr];
+    }
+    return r;
+}
+
+static void
+store_littleendian64(
+    uint8_t* x,
+    uint64_t u
+)
+{
+    int ctr;
+
+    for (ctr = 0; ctr < 8; ctr++)
+    {
+        x[ctr] = (uint8_t)u;
+        u >>= 8;
+    }
+}
+
+/// Carry propagation for 64 bit limbs. Result limbs are < 2^51 except for
+/// limb #0 which is < 2^51 + 19 * 2^13 (about 2^51 + 2^17), as the carry out of
+/// limb #4 is multiplied by 19.
+FORCE_INLINE static void
+fe25519_carry(
+    fe25519* out,
+    uint64_t h0,
+    uint64_t h1,
+    uint64_t h2,
+    uint64_t h3,
+    uint64_t h4
+)
+{
+    h1 += h0 >> 51; h0 &= FE25519_MASK51;
+    h2 += h1 >> 51; h1 &= FE25519_MASK51;
+    h3 += h2 >> 51; h2 &= FE25519_MASK51;
+    h4 += h3 >> 51; h3 &= FE25519_MASK51;
+    h0 += 19 * (h4 >> 51); h4 &= FE25519_MASK51;
+
+    out->limbs[0] = h0;
+    out->limbs[1] = h1;
+    out->limbs[2] = h2;
+    out->limbs[3] = h3;
+    out->limbs[4] = h4;
+}
+
+/// Carry propagation for the 128 bit column sums of a multiplication.
+/// Result limbs are < 2^51 except for limb #1 which is < 2^51 + 2^29.
+FORCE_INLINE static void
+fe25519_carryWide(
+    fe25519*  out,
+    uint128_t r0,
+    uint128_t r1,
+    uint128_t r2,
+    uint128_t r3,
+    uint128_t r4
+)
+{
+    uint64_t h0, h1, h2, h3, h4;
+
+    r1 += r0 >> 51; h0 = ((uint64_t)r0) & FE25519_MASK51;
+    r2 += r1 >> 51; h1 = ((uint64_t)r1) & FE25519_MASK51;
+    r3 += r2 >> 51; h2 = ((uint64_t)r2) & FE25519_MASK51;
+    r4 += r3 >> 51; h3 = ((uint64_t)r3) & FE25519_MASK51;
+    h4 = ((uint64_t)r4) & FE25519_MASK51;
+
+    r0 = (r4 >> 51) * 19 + h0;
+    h0 = ((uint64_t)r0) & FE25519_MASK51;
+    h1 += (uint64_t)(r0 >> 51);
+
+    out->limbs[0] = h0;
+    out->limbs[1] = h1;
+    out->limbs[2] = h2;
+    out->limbs[3] = h3;
+    out->limbs[4] = h4;
+}
+
+void
+fe25519_unpack(
+    fe25519*            out,
+    const uint8_t in[32]
+)
+{
+    out->limbs[0] = load_littleendian64(in) & FE25519_MASK51;
+    out->limbs[1] = (load_littleendian64(in + 6) >> 3) & FE25519_MASK51;
+    out->limbs[2] = (load_littleendian64(in + 12) >> 6) & FE25519_MASK51;
+    out->limbs[3] = (load_littleendian64(in + 19) >> 1) & FE25519_MASK51;
+    out->limbs[4] = (load_littleendian64(in + 24) >> 12) & FE25519_MASK51; // clears bit #255
+}
+
+void
+fe25519_pack(
+    uint8_t out[32],
+    fe25519*      in
+)
+{
+    const uint64_t* h = in->limbs;
+
+    fe25519_reduceCompletely(in);
+
+    store_littleendian64(out, h[0] | (h[1] << 51));
+    store_littleendian64(out + 8, (h[1] >> 13) | (h[2] << 38));
+    store_littleendian64(out + 16, (h[2] >> 26) | (h[3] << 25));
+    store_littleendian64(out + 24, (h[3] >> 39) | (h[4] << 12));
+}
+
+void
+fe25519_reduceCompletely(
+    fe25519* inout
+)
+{
+    uint64_t* h = inout->limbs;
+    uint64_t  q;
+
+    // Two carry passes: Afterwards the value is smaller than 2^255 + 19 and
+    // all limbs but #0 are below 2^51.
+    fe25519_carry(inout, h[0], h[1], h[2], h[3], h[4]);
+    fe25519_carry(inout, h[0], h[1], h[2], h[3], h[4]);
+
+    // q = 1 if the value is >= 2^255 - 19, i.e. if value + 19 overflows 2^255.
+    q = (h[0] + 19) >> 51;
+    q = (h[1] + q) >> 51;
+    q = (h[2] + q) >> 51;
+    q = (h[3] + q) >> 51;
+    q = (h[4] + q) >> 51;
+
+    // Subtract q * (2^255 - 19) by adding 19 q and dropping bit #255.
+    h[0] += 19 * q;
+    h[1] += h[0] >> 51; h[0] &= FE25519_MASK51;
+    h[2] += h[1] >> 51; h[1] &= FE25519_MASK51;
+    h[3] += h[2] >> 51; h[2] &= FE25519_MASK51;
+    h[4] += h[3] >> 51; h[3] &= FE25519_MASK51;
+    h[4] &= FE25519_MASK51;
+}
+
+void
+fe25519_cpy(
+    fe25519*       result,
+    const fe25519* in
+)
+{
+    uint8_t ctr;
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        result->limbs[ctr] = in->limbs[ctr];
+    }
+}
+
+void
+fe25519_cmov(
+    fe25519*       result,
+    const fe25519* in,
+    int            condition
+)
+{
+    uint64_t mask = -(uint64_t)(uint8_t)condition;
+    uint8_t  ctr;
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        result->limbs[ctr] ^= mask & (in->limbs[ctr] ^ result->limbs[ctr]);
+    }
+}
+
+void
+fe25519_cswap(
+    fe25519* in1,
+    fe25519* in2,
+    int      condition
+)
+{
+    uint64_t mask = -(uint64_t)(uint8_t)condition;
+    uint8_t  ctr;
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        uint64_t temp = mask & (in1->limbs[ctr] ^ in2->limbs[ctr]);
+
+        in1->limbs[ctr] ^= temp;
+        in2->limbs[ctr] ^= temp;
+    }
+}
+
+void
+fe25519_setzero(
+    fe25519* out
+)
+{
+    uint8_t ctr;
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        out->limbs[ctr] = 0;
+    }
+}
+
+void
+fe25519_setone(
+    fe25519* out
+)
+{
+    fe25519_setzero(out);
+    out->limbs[0] = 1;
+}
+
+int32_t
+fe25519_iseq_vartime(
+    fe25519* in1,
+    fe25519* in2
+)
+{
+    uint8_t ctr;
+
+    fe25519_reduceCompletely(in1);
+    fe25519_reduceCompletely(in2);
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        if (in1->limbs[ctr] != in2->limbs[ctr])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int32_t
+fe25519_iszero(
+    fe25519* in
+)
+{
+    uint64_t bitsSetMask = 0;
+    uint8_t  ctr;
+
+    fe25519_reduceCompletely(in);
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        bitsSetMask |= in->limbs[ctr];
+    }
+    return (int32_t)(uint32_t)(bitsSetMask | (bitsSetMask >> 32));
+}
+
+int32_t
+fe25519_getparity(
+    fe25519* in
+)
+{
+    fe25519_reduceCompletely(in);
+    return (int32_t)(in->limbs[0] & 1);
+}
+
+void
+fe25519_add(
+    fe25519*       out,
+    const fe25519* baseValue,
+    const fe25519* valueToAdd
+)
+{
+    uint8_t ctr;
+
+    for (ctr = 0; ctr < 5; ctr++)
+    {
+        out->limbs[ctr] = baseValue->limbs[ctr] + valueToAdd->limbs[ctr];
+    }
+}
+
+void
+fe25519_sub(
+    fe25519*       out,
+    const fe25519* baseValue,
+    const fe25519* valueToSubstract
+)
+{
+    const uint64_t* a = baseValue->limbs;
+    const uint64_t* b = valueToSubstract->limbs;
+
+    fe25519_carry(out,
+                  (a[0] + FE25519_16P_LIMB0) - b[0],
+                  (a[1] + FE25519_16P_LIMBN) - b[1],
+                  (a[2] + FE25519_16P_LIMBN) - b[2],
+                  (a[3] + FE25519_16P_LIMBN) - b[3],
+                  (a[4] + FE25519_16P_LIMBN) - b[4]);
+}
+
+void
+fe25519_neg(
+    fe25519*       out,
+    const fe25519* valueToNegate
+)
+{
+    const uint64_t* b = valueToNegate->limbs;
+
+    fe25519_carry(out,
+                  FE25519_16P_LIMB0 - b[0],
+                  FE25519_16P_LIMBN - b[1],
+                  FE25519_16P_LIMBN - b[2],
+                  FE25519_16P_LIMBN - b[3],
+                  FE25519_16P_LIMBN - b[4]);
+}
+
+void
+fe25519_mpyWith_uint16(
+    fe25519*       inOut,
+    const uint16_t   valU16
+)
+{
+    const uint64_t* a = inOut->limbs;
+
+    fe25519_carryWide(inOut,
+                      ((uint128_t)a[0]) * valU16,
+                      ((uint128_t)a[1]) * valU16,
+                      ((uint128_t)a[2]) * valU16,
+                      ((uint128_t)a[3]) * valU16,
+                      ((uint128_t)a[4]) * valU16);
+}
+
+/// Note that out and are allowed to overlap!
+void
+fe25519_mpyWith121666(
+    fe25519*       out,
+    const fe25519* in
+)
+{
+    const uint64_t* a = in->limbs;
+
+    fe25519_carryWide(out,
+                      ((uint128_t)a[0]) * 121666,
+                      ((uint128_t)a[1]) * 121666,
+                      ((uint128_t)a[2]) * 121666,
+                      ((uint128_t)a[3]) * 121666,
+                      ((uint128_t)a[4]) * 121666);
+}
+
+void
+fe25519_mul(
+    fe25519*       result,
+    const fe25519* in1,
+    const fe25519* in2
+)
+{
+    const uint64_t* a = in1->limbs;
+    const uint64_t* b = in2->limbs;
+    uint64_t        b1_19 = 19 * b[1];
+    uint64_t        b2_19 = 19 * b[2];
+    uint64_t        b3_19 = 19 * b[3];
+    uint64_t        b4_19 = 19 * b[4];
+    uint128_t       r0, r1, r2, r3, r4;
+
+    // Limbs of weight 2^255 and above are folded back with factor 19.
+    r0 = ((uint128_t)a[0]) * b[0] + ((uint128_t)a[1]) * b4_19 + ((uint128_t)a[2]) * b3_19
+       + ((uint128_t)a[3]) * b2_19 + ((uint128_t)a[4]) * b1_19;
+    r1 = ((uint128_t)a[0]) * b[1] + ((uint128_t)a[1]) * b[0] + ((uint128_t)a[2]) * b4_19
+       + ((uint128_t)a[3]) * b3_19 + ((uint128_t)a[4]) * b2_19;
+    r2 = ((uint128_t)a[0]) * b[2] + ((uint128_t)a[1]) * b[1] + ((uint128_t)a[2]) * b[0]
+       + ((uint128_t)a[3]) * b4_19 + ((uint128_t)a[4]) * b3_19;
+    r3 = ((uint128_t)a[0]) * b[3] + ((uint128_t)a[1]) * b[2] + ((uint128_t)a[2]) * b[1]
+       + ((uint128_t)a[3]) * b[0] + ((uint128_t)a[4]) * b4_19;
+    r4 = ((uint128_t)a[0]) * b[4] + ((uint128_t)a[1]) * b[3] + ((uint128_t)a[2]) * b[2]
+       + ((uint128_t)a[3]) * b[1] + ((uint128_t)a[4]) * b[0];
+
+    fe25519_carryWide(result, r0, r1, r2, r3, r4);
+}
+
+void
+fe25519_square(
+    fe25519*       result,
+    const fe25519* in
+)
+{
+    const uint64_t* a = in->limbs;
+    uint64_t        a0_2 = 2 * a[0];
+    uint64_t        a1_2 = 2 * a[1];
+    uint64_t        a1_38 = 38 * a[1];
+    uint64_t        a2_38 = 38 * a[2];
+    uint64_t        a3_38 = 38 * a[3];
+    uint64_t        a3_19 = 19 * a[3];
+    uint64_t        a4_19 = 19 * a[4];
+    uint128_t       r0, r1, r2, r3, r4;
+
+    r0 = ((uint128_t)a[0]) * a[0] + ((uint128_t)a1_38) * a[4] + ((uint128_t)a2_38) * a[3];
+    r1 = ((uint128_t)a0_2) * a[1] + ((uint128_t)a2_38) * a[4] + ((uint128_t)a3_19) * a[3];
+    r2 = ((uint128_t)a0_2) * a[2] + ((uint128_t)a[1]) * a[1] + ((uint128_t)a3_38) * a[4];
+    r3 = ((uint128_t)a0_2) * a[3] + ((uint128_t)a1_2) * a[2] + ((uint128_t)a4_19) * a[4];
+    r4 = ((uint128_t)a0_2) * a[4] + ((uint128_t)a1_2) * a[3] + ((uint128_t)a[2]) * a[2];
+
+    fe25519_carryWide(result, r0, r1, r2, r3, r4);
+}
+
+void
+fe25519_generateRandomValue(
+    fe25519*       result
+)
+{
+    uint8_t bytes[32];
+
+    randombytes (bytes, 32);
+    fe25519_unpack(result, bytes);
+}
+
+// Curve constants of curve25519 with A = 486662.
+
+// 1
+const fe25519 fe25519_one =
+{{
+    0x0000000000001ULL, 0x0000000000000ULL, 0x0000000000000ULL, 0x0000000000000ULL, 0x0000000000000ULL
+}};
+
+// -A = -486662
+const fe25519 fe25519_minusA =
+{{
+    0x7fffffff892e7ULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL
+}};
+
+// -A / 2 = -243331
+const fe25519 fe25519_minusAdiv2 =
+{{
+    0x7fffffffc496aULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL, 0x7ffffffffffffULL
+}};
+
+// A^2
+const fe25519 fe25519_Asquare =
+{{
+    0x0003724c21c24ULL, 0x0000000000000ULL, 0x0000000000000ULL, 0x0000000000000ULL, 0x0000000000000ULL
+}};
+
+#endif // #ifdef CRYPTO_HAS_FE25519_RADIX51
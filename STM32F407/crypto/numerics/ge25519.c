@@ -0,0 +1,830 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file ge25519.c
+
+    Group operations on the twisted edwards curve equivalent to curve25519.
+    Formulas follow the ref10 implementation of ed25519
+    (Authors: D. J. Bernstein, N. Duif, T. Lange, P. Schwabe, B.-Y. Yang).
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include <string.h>
+#include "../include/ge25519.h"
+
+// d = -121665 / 121666
+static const UN_256bitValue ge25519_ecd =
+{{
+    0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+    0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52
+}};
+
+// 2 * d
+static const UN_256bitValue ge25519_ec2d =
+{{
+    0x59, 0xf1, 0xb2, 0x26, 0x94, 0x9b, 0xd6, 0xeb, 0x56, 0xb1, 0x83, 0x82, 0x9a, 0x14, 0xe0, 0x00,
+    0x30, 0xd1, 0xf3, 0xee, 0xf2, 0x80, 0x8e, 0x19, 0xe7, 0xfc, 0xdf, 0x56, 0xdc, 0xd9, 0x06, 0x24
+}};
+
+// Base point B = (x, 4/5) with positive x, and t = x * y.
+static const UN_256bitValue ge25519_base_x =
+{{
+    0x1a, 0xd5, 0x25, 0x8f, 0x60, 0x2d, 0x56, 0xc9, 0xb2, 0xa7, 0x25, 0x95, 0x60, 0xc7, 0x2c, 0x69,
+    0x5c, 0xdc, 0xd6, 0xfd, 0x31, 0xe2, 0xa4, 0xc0, 0xfe, 0x53, 0x6e, 0xcd, 0xd3, 0x36, 0x69, 0x21
+}};
+
+static const UN_256bitValue ge25519_base_y =
+{{
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+}};
+
+static const UN_256bitValue ge25519_base_t =
+{{
+    0xa3, 0xdd, 0xb7, 0xa5, 0xb3, 0x8a, 0xde, 0x6d, 0xf5, 0x52, 0x51, 0x77, 0x80, 0x9f, 0xf0, 0x20,
+    0x7d, 0xe3, 0xab, 0x64, 0x8e, 0x4e, 0xea, 0x66, 0x65, 0x76, 0x8b, 0xd7, 0x0f, 0x5f, 0x87, 0x67
+}};
+
+// 2^255 - 19, little endian, for rejecting non-canonical encodings.
+static const uint8_t ge25519_prime[32] =
+{
+    0xed, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+};
+
+void
+ge25519_setneutral(
+    ge25519_p3* r
+)
+{
+    fe25519_setzero(&r->x);
+    fe25519_setone(&r->y);
+    fe25519_setone(&r->z);
+    fe25519_setzero(&r->t);
+}
+
+void
+ge25519_p3_to_p2(
+    ge25519_p2*       r,
+    const ge25519_p3* p
+)
+{
+    fe25519_cpy(&r->x, &p->x);
+    fe25519_cpy(&r->y, &p->y);
+    fe25519_cpy(&r->z, &p->z);
+}
+
+void
+ge25519_p1p1_to_p2(
+    ge25519_p2*         r,
+    const ge25519_p1p1* p
+)
+{
+    fe25519_mul(&r->x, &p->x, &p->t);
+    fe25519_mul(&r->y, &p->y, &p->z);
+    fe25519_mul(&r->z, &p->z, &p->t);
+}
+
+void
+ge25519_p1p1_to_p3(
+    ge25519_p3*         r,
+    const ge25519_p1p1* p
+)
+{
+    fe25519_mul(&r->x, &p->x, &p->t);
+    fe25519_mul(&r->y, &p->y, &p->z);
+    fe25519_mul(&r->z, &p->z, &p->t);
+    fe25519_mul(&r->t, &p->x, &p->y);
+}
+
+// "dbl-2008-hwcd" formulas: 4S + 0M.
+void
+ge25519_dbl_p1p1(
+    ge25519_p1p1*     r,
+    const ge25519_p2* p
+)
+{
+    fe25519 t0;
+
+    fe25519_square(&r->x, &p->x);      // XX = X1^2
+    fe25519_square(&r->z, &p->y);      // YY = Y1^2
+    fe25519_square(&r->t, &p->z);
+    fe25519_add(&r->t, &r->t, &r->t);  // B = 2 * Z1^2
+    fe25519_add(&r->y, &p->x, &p->y);
+    fe25519_square(&t0, &r->y);        // AA = (X1 + Y1)^2
+    fe25519_add(&r->y, &r->z, &r->x);  // Y3 = YY + XX
+    fe25519_sub(&r->z, &r->z, &r->x);  // Z3 = YY - XX
+    fe25519_sub(&r->x, &t0, &r->y);    // X3 = AA - Y3
+    fe25519_sub(&r->t, &r->t, &r->z);  // T3 = B - Z3
+}
+
+// "madd-2008-hwcd-3" formulas with the affine operand in niels form: 7M
+// including the conversion of the result to p3.
+void
+ge25519_mixadd_p1p1(
+    ge25519_p1p1*        r,
+    const ge25519_p3*    p,
+    const ge25519_niels* q
+)
+{
+    fe25519 t0;
+
+    fe25519_sub(&r->z, &p->y, &p->x);
+    fe25519_mul(&r->z, &r->z, &q->ysubx); // A = (Y1 - X1) * (y2 - x2)
+    fe25519_add(&r->t, &p->y, &p->x);
+    fe25519_mul(&r->t, &r->t, &q->xaddy); // B = (Y1 + X1) * (y2 + x2)
+    fe25519_mul(&t0, &p->t, &q->t2d);     // C = T1 * 2 * d * x2 * y2
+    fe25519_sub(&r->x, &r->t, &r->z);     // X3 = B - A
+    fe25519_add(&r->y, &r->t, &r->z);     // Y3 = B + A
+    fe25519_add(&r->z, &p->z, &p->z);     // D = 2 * Z1
+    fe25519_sub(&r->t, &r->z, &t0);       // T3 = D - C
+    fe25519_add(&r->z, &r->z, &t0);       // Z3 = D + C
+}
+
+void
+ge25519_p3_to_cached(
+    ge25519_cached*   r,
+    const ge25519_p3* p
+)
+{
+    fe25519 ec2d;
+
+    fe25519_unpack(&ec2d, ge25519_ec2d.as_uint8_t);
+    fe25519_add(&r->xaddy, &p->y, &p->x);
+    fe25519_sub(&r->ysubx, &p->y, &p->x);
+    fe25519_cpy(&r->z, &p->z);
+    fe25519_mul(&r->t2d, &p->t, &ec2d);
+}
+
+// "add-2008-hwcd-3" formulas: 8M including the conversion of the result to p3.
+void
+ge25519_add_p1p1(
+    ge25519_p1p1*         r,
+    const ge25519_p3*     p,
+    const ge25519_cached* q
+)
+{
+    fe25519 t0;
+
+    fe25519_sub(&r->z, &p->y, &p->x);
+    fe25519_mul(&r->z, &r->z, &q->ysubx); // A = (Y1 - X1) * (Y2 - X2)
+    fe25519_add(&r->t, &p->y, &p->x);
+    fe25519_mul(&r->t, &r->t, &q->xaddy); // B = (Y1 + X1) * (Y2 + X2)
+    fe25519_mul(&t0, &p->t, &q->t2d);     // C = T1 * 2 * d * T2
+    fe25519_sub(&r->x, &r->t, &r->z);     // X3 = B - A
+    fe25519_add(&r->y, &r->t, &r->z);     // Y3 = B + A
+    fe25519_mul(&r->z, &p->z, &q->z);
+    fe25519_add(&r->z, &r->z, &r->z);     // D = 2 * Z1 * Z2
+    fe25519_sub(&r->t, &r->z, &t0);       // T3 = D - C
+    fe25519_add(&r->z, &r->z, &t0);       // Z3 = D + C
+}
+
+// Same as ge25519_add_p1p1 with -q = (Y - X, Y + X, Z, -2.d.T).
+void
+ge25519_sub_p1p1(
+    ge25519_p1p1*         r,
+    const ge25519_p3*     p,
+    const ge25519_cached* q
+)
+{
+    fe25519 t0;
+
+    fe25519_sub(&r->z, &p->y, &p->x);
+    fe25519_mul(&r->z, &r->z, &q->xaddy);
+    fe25519_add(&r->t, &p->y, &p->x);
+    fe25519_mul(&r->t, &r->t, &q->ysubx);
+    fe25519_mul(&t0, &p->t, &q->t2d);
+    fe25519_sub(&r->x, &r->t, &r->z);
+    fe25519_add(&r->y, &r->t, &r->z);
+    fe25519_mul(&r->z, &p->z, &q->z);
+    fe25519_add(&r->z, &r->z, &r->z);
+    fe25519_add(&r->t, &r->z, &t0);
+    fe25519_sub(&r->z, &r->z, &t0);
+}
+
+void
+ge25519_setbase(
+    ge25519_p3* r
+)
+{
+    fe25519_unpack(&r->x, ge25519_base_x.as_uint8_t);
+    fe25519_unpack(&r->y, ge25519_base_y.as_uint8_t);
+    fe25519_setone(&r->z);
+    fe25519_unpack(&r->t, ge25519_base_t.as_uint8_t);
+}
+
+void
+ge25519_pack(
+    uint8_t           r[32],
+    const ge25519_p3* p
+)
+{
+    fe25519 zi;
+    fe25519 tx;
+    fe25519 ty;
+
+    fe25519_invert(&zi, &p->z);
+    fe25519_mul(&tx, &p->x, &zi);
+    fe25519_mul(&ty, &p->y, &zi);
+    fe25519_pack(r, &ty);
+    r[31] ^= (uint8_t)(fe25519_getparity(&tx) << 7);
+}
+
+int
+ge25519_unpackneg_vartime(
+    ge25519_p3*   r,
+    const uint8_t p[32]
+)
+{
+    fe25519 u;
+    fe25519 v;
+    uint8_t sign = p[31] >> 7;
+    int     i;
+
+    // Reject y >= 2^255 - 19.
+    for (i = 31; i >= 0; i--)
+    {
+        uint8_t y = (i == 31) ? (uint8_t)(p[31] & 0x7f) : p[i];
+
+        if (y != ge25519_prime[i])
+        {
+            if (y > ge25519_prime[i])
+            {
+                return -1;
+            }
+            break;
+        }
+    }
+    if (i < 0)
+    {
+        return -1;
+    }
+
+    fe25519_unpack(&r->y, p);
+    fe25519_setone(&r->z);
+
+    // x^2 = (y^2 - 1) / (d.y^2 + 1)
+    fe25519_unpack(&v, ge25519_ecd.as_uint8_t);
+    fe25519_square(&u, &r->y);
+    fe25519_mul(&v, &v, &u);
+    fe25519_sub(&u, &u, &r->z);
+    fe25519_add(&v, &v, &r->z);
+    if (!fe25519_sqrt_ratio(&r->x, &u, &v))
+    {
+        return -1;
+    }
+
+    // x = 0 has no negative counterpart.
+    fe25519_cpy(&u, &r->x);
+    if ((fe25519_iszero(&u) == 0) && sign)
+    {
+        return -1;
+    }
+
+    // Select the root with the opposite of the encoded sign.
+    if (fe25519_getparity(&r->x) == sign)
+    {
+        fe25519_neg(&r->x, &r->x);
+    }
+    fe25519_mul(&r->t, &r->x, &r->y);
+    return 0;
+}
+
+int
+ge25519_is_small_order_vartime(
+    const ge25519_p3* p
+)
+{
+    ge25519_p1p1 t;
+    ge25519_p2   q;
+    fe25519      y;
+    int          i;
+
+    // 8 p by three doublings.
+    ge25519_p3_to_p2(&q, p);
+    for (i = 0; i < 3; i++)
+    {
+        ge25519_dbl_p1p1(&t, &q);
+        ge25519_p1p1_to_p2(&q, &t);
+    }
+
+    // Neutral element: X = 0 and Y = Z.
+    fe25519_sub(&y, &q.y, &q.z);
+    return (fe25519_iszero(&q.x) == 0) && (fe25519_iszero(&y) == 0);
+}
+
+// Sliding window width of the variable point in ge25519_double_scalarmult_vartime.
+#define GE25519_POINT_SLIDE_WIDTH 5
+
+#if (GE25519_BASE_TABLE_WINDOWS == 0)
+#define GE25519_BASE_SLIDE_WIDTH 5
+#endif
+
+// Calculates r[i] = (2 i + 1) * p for i = 0 .. count - 1.
+static void
+ge25519_odd_multiples_cached(
+    ge25519_cached    r[],
+    const ge25519_p3* p,
+    unsigned int      count
+)
+{
+    ge25519_cached p2;
+    ge25519_p1p1   t;
+    ge25519_p3     u;
+    ge25519_p2     v;
+    unsigned int   i;
+
+    ge25519_p3_to_p2(&v, p);
+    ge25519_dbl_p1p1(&t, &v);
+    ge25519_p1p1_to_p3(&u, &t);
+    ge25519_p3_to_cached(&p2, &u);
+
+    ge25519_p3_to_cached(&r[0], p);
+    u = *p;
+    for (i = 1; i < count; i++)
+    {
+        ge25519_add_p1p1(&t, &u, &p2);
+        ge25519_p1p1_to_p3(&u, &t);
+        ge25519_p3_to_cached(&r[i], &u);
+    }
+}
+
+// t = r + d * P for the odd digit d, multiples[i] = (2 i + 1) * P.
+static void
+ge25519_add_odd_digit_vartime(
+    ge25519_p1p1*         t,
+    const ge25519_p3*     r,
+    const ge25519_cached  multiples[],
+    signed char           d
+)
+{
+    if (d > 0)
+    {
+        ge25519_add_p1p1(t, r, &multiples[d >> 1]);
+    }
+    else
+    {
+        ge25519_sub_p1p1(t, r, &multiples[(-d) >> 1]);
+    }
+}
+
+#if (GE25519_BASE_TABLE_WINDOWS > 0)
+
+// t = r + d * B for the odd digit d, with d * B taken from ge25519_base_odd_multiples.
+static void
+ge25519_add_base_odd_digit_vartime(
+    ge25519_p1p1*     t,
+    const ge25519_p3* r,
+    signed char       d
+)
+{
+    const ge25519_niels_packed* entry = &ge25519_base_odd_multiples[((d < 0) ? -d : d) >> 1];
+    ge25519_niels               n;
+
+    fe25519_unpack(&n.t2d, entry->t2d.as_uint8_t);
+    if (d > 0)
+    {
+        fe25519_unpack(&n.ysubx, entry->ysubx.as_uint8_t);
+        fe25519_unpack(&n.xaddy, entry->xaddy.as_uint8_t);
+    }
+    else
+    {
+        // -(x, y) = (-x, y): swap y - x with y + x and negate 2.d.x.y.
+        fe25519_unpack(&n.ysubx, entry->xaddy.as_uint8_t);
+        fe25519_unpack(&n.xaddy, entry->ysubx.as_uint8_t);
+        fe25519_neg(&n.t2d, &n.t2d);
+    }
+    ge25519_mixadd_p1p1(t, r, &n);
+}
+
+#endif
+
+// Straus' method: one chain of doublings for both scalars in sliding window
+// NAF form. About 253 doublings, 256 / (w + 1) additions per scalar and
+// 2^(w-2) - 1 additions for the precomputation of the odd multiples of p1.
+void
+ge25519_double_scalarmult_vartime(
+    ge25519_p3*       r,
+    const ge25519_p3* p1,
+    const sc25519*    s1,
+    const sc25519*    s2
+)
+{
+    signed char    slide1[SC25519_SLIDE_SIZE];
+    signed char    slide2[SC25519_SLIDE_SIZE];
+    ge25519_cached multiples1[1 << (GE25519_POINT_SLIDE_WIDTH - 2)];
+#if (GE25519_BASE_TABLE_WINDOWS == 0)
+    ge25519_cached multiples2[1 << (GE25519_BASE_SLIDE_WIDTH - 2)];
+    ge25519_p3     base;
+#endif
+    ge25519_p1p1   t;
+    ge25519_p2     u;
+    int            i;
+
+    sc25519_slide(slide1, s1, GE25519_POINT_SLIDE_WIDTH);
+    sc25519_slide(slide2, s2, GE25519_BASE_SLIDE_WIDTH);
+
+    // Skip the leading zero digits.
+    for (i = SC25519_SLIDE_SIZE - 1; (i >= 0) && (slide1[i] == 0) && (slide2[i] == 0); i--)
+    {
+    }
+    ge25519_setneutral(r);
+    if (i < 0)
+    {
+        return;
+    }
+
+    ge25519_odd_multiples_cached(multiples1, p1, 1 << (GE25519_POINT_SLIDE_WIDTH - 2));
+#if (GE25519_BASE_TABLE_WINDOWS == 0)
+    ge25519_setbase(&base);
+    ge25519_odd_multiples_cached(multiples2, &base, 1 << (GE25519_BASE_SLIDE_WIDTH - 2));
+#endif
+
+    ge25519_p3_to_p2(&u, r);
+    for (; i >= 0; i--)
+    {
+        ge25519_dbl_p1p1(&t, &u);
+
+        if (slide1[i])
+        {
+            ge25519_p1p1_to_p3(r, &t);
+            ge25519_add_odd_digit_vartime(&t, r, multiples1, slide1[i]);
+        }
+        if (slide2[i])
+        {
+            ge25519_p1p1_to_p3(r, &t);
+#if (GE25519_BASE_TABLE_WINDOWS > 0)
+            ge25519_add_base_odd_digit_vartime(&t, r, slide2[i]);
+#else
+            ge25519_add_odd_digit_vartime(&t, r, multiples2, slide2[i]);
+#endif
+        }
+        ge25519_p1p1_to_p2(&u, &t);
+    }
+    ge25519_p1p1_to_p3(r, &t);
+}
+
+// The buckets live on the stack, 2^(GE25519_MSM_MAX_WINDOW - 1) points.
+#ifndef GE25519_MSM_MAX_WINDOW
+#ifdef CORTEX_M4
+#define GE25519_MSM_MAX_WINDOW 6
+#else
+#define GE25519_MSM_MAX_WINDOW 7
+#endif
+#endif
+
+// Signed digit w of s in radix 2^c (Booth recoding), in the range
+// -2^(c-1) .. 2^(c-1): d_w = bits [w.c, w.c + c) + bit (w.c - 1) - 2^c . bit (w.c + c - 1).
+static int
+ge25519_msm_digit(
+    const sc25519* s,
+    unsigned int   w,
+    unsigned int   c
+)
+{
+    unsigned int pos = w * c;
+    uint32_t     bits;
+    int          d;
+
+    // Gather c + 1 bits starting at pos - 1. Bits at and above 256 are zero.
+    bits = 0;
+    {
+        unsigned int i;
+
+        for (i = 0; i <= c; i++)
+        {
+            unsigned int bit = pos + i - 1;
+
+            if ((pos + i >= 1) && (bit < 256))
+            {
+                bits |= (uint32_t)((s->as_uint8_t[bit >> 3] >> (bit & 7)) & 1) << i;
+            }
+        }
+    }
+    d = (int)((bits >> 1) & ((1u << c) - 1)) + (int)(bits & 1);
+    d -= (int)((bits >> c) & 1) << c;
+    return d;
+}
+
+// Number of windows of width c covering 253 bit scalars, such that the
+// most significant bit of the last window is zero.
+static unsigned int
+ge25519_msm_windows(
+    unsigned int c
+)
+{
+    return (253 + c) / c;
+}
+
+void
+ge25519_multi_scalarmult_vartime(
+    ge25519_p3*       r,
+    const ge25519_p3  p[],
+    const sc25519     s[],
+    size_t            n,
+    ge25519_cached    scratch[]
+)
+{
+    ge25519_p3     buckets[1 << (GE25519_MSM_MAX_WINDOW - 1)];
+    uint8_t        used[1 << (GE25519_MSM_MAX_WINDOW - 1)];
+    ge25519_p3     running;
+    ge25519_cached c;
+    ge25519_p1p1   t;
+    ge25519_p2     u;
+    unsigned int   width = 2;
+    unsigned int   w;
+    unsigned int   i;
+    size_t         j;
+    int            first = 1;
+
+    // Choose the window width minimizing windows * (n + buckets).
+    for (i = 3; i <= GE25519_MSM_MAX_WINDOW; i++)
+    {
+        if (ge25519_msm_windows(i) * (n + (1u << (i - 1))) <
+            ge25519_msm_windows(width) * (n + (1u << (width - 1))))
+        {
+            width = i;
+        }
+    }
+
+    for (j = 0; j < n; j++)
+    {
+        ge25519_p3_to_cached(&scratch[j], &p[j]);
+    }
+
+    ge25519_setneutral(r);
+
+    for (w = ge25519_msm_windows(width); w-- > 0;)
+    {
+        unsigned int nbuckets = 1u << (width - 1);
+        int          runningUsed = 0;
+
+        if (!first)
+        {
+            ge25519_p3_to_p2(&u, r);
+            for (i = 1; i < width; i++)
+            {
+                ge25519_dbl_p1p1(&t, &u);
+                ge25519_p1p1_to_p2(&u, &t);
+            }
+            ge25519_dbl_p1p1(&t, &u);
+            ge25519_p1p1_to_p3(r, &t);
+        }
+
+        // Sort the points into the buckets of their digit.
+        memset(used, 0, sizeof(used));
+        for (j = 0; j < n; j++)
+        {
+            int          d = ge25519_msm_digit(&s[j], w, width);
+            unsigned int b = (unsigned int)((d < 0) ? -d : d) - 1;
+
+            if (d == 0)
+            {
+                continue;
+            }
+            if (!used[b])
+            {
+                buckets[b] = p[j];
+                if (d < 0)
+                {
+                    fe25519_neg(&buckets[b].x, &buckets[b].x);
+                    fe25519_neg(&buckets[b].t, &buckets[b].t);
+                }
+                used[b] = 1;
+            }
+            else
+            {
+                if (d > 0)
+                {
+                    ge25519_add_p1p1(&t, &buckets[b], &scratch[j]);
+                }
+                else
+                {
+                    ge25519_sub_p1p1(&t, &buckets[b], &scratch[j]);
+                }
+                ge25519_p1p1_to_p3(&buckets[b], &t);
+            }
+        }
+
+        // r += sum (b + 1) * buckets[b] = sum over b of (buckets[nbuckets - 1] + ... + buckets[b])
+        for (i = nbuckets; i-- > 0;)
+        {
+            if (used[i])
+            {
+                if (!runningUsed)
+                {
+                    running = buckets[i];
+                    runningUsed = 1;
+                }
+                else
+                {
+                    ge25519_p3_to_cached(&c, &buckets[i]);
+                    ge25519_add_p1p1(&t, &running, &c);
+                    ge25519_p1p1_to_p3(&running, &t);
+                }
+            }
+            if (runningUsed)
+            {
+                ge25519_p3_to_cached(&c, &running);
+                ge25519_add_p1p1(&t, r, &c);
+                ge25519_p1p1_to_p3(r, &t);
+                first = 0;
+            }
+        }
+    }
+}
+
+// Returns 1 if b == c and 0 otherwise. Constant time.
+static uint8_t
+ge25519_equal(
+    uint8_t b,
+    uint8_t c
+)
+{
+    uint32_t x = (uint32_t)(b ^ c);
+
+    x -= 1;
+    return (uint8_t)(x >> 31);
+}
+
+#if (GE25519_BASE_TABLE_WINDOWS > 0)
+
+#define GE25519_BASE_TABLE_DIGITS_PER_WINDOW (SC25519_WINDOW4_SIZE / GE25519_BASE_TABLE_WINDOWS)
+
+// Loads b * (window base point) for -8 <= b <= 8 from the table.
+// The whole window is scanned irrespective of the value of b.
+static void
+ge25519_select_base_multiple(
+    ge25519_niels* r,
+    uint8_t        window,
+    signed char    b
+)
+{
+    ge25519_niels_packed packed;
+    fe25519              minusT2d;
+    uint8_t              bnegative = isNegative(b);
+    uint8_t              babs = (uint8_t)(b - (((-bnegative) & b) << 1));
+    uint8_t              ctr;
+
+    // Start with the neutral element (1, 1, 0).
+    setone_256bitvalue(&packed.ysubx);
+    setone_256bitvalue(&packed.xaddy);
+    setzero_256bitvalue(&packed.t2d);
+
+    for (ctr = 0; ctr < 8; ctr++)
+    {
+        const ge25519_niels_packed* entry = &ge25519_base_multiples[window][ctr];
+        uint8_t                     hit = ge25519_equal(babs, (uint8_t)(ctr + 1));
+
+        conditionalMove_256bitValue(&packed.ysubx, &entry->ysubx, hit);
+        conditionalMove_256bitValue(&packed.xaddy, &entry->xaddy, hit);
+        conditionalMove_256bitValue(&packed.t2d, &entry->t2d, hit);
+    }
+
+    fe25519_unpack(&r->ysubx, packed.ysubx.as_uint8_t);
+    fe25519_unpack(&r->xaddy, packed.xaddy.as_uint8_t);
+    fe25519_unpack(&r->t2d, packed.t2d.as_uint8_t);
+
+    // -(x, y) = (-x, y): swap y - x with y + x and negate 2.d.x.y.
+    fe25519_cswap(&r->ysubx, &r->xaddy, bnegative);
+    fe25519_neg(&minusT2d, &r->t2d);
+    fe25519_cmov(&r->t2d, &minusT2d, bnegative);
+}
+
+// Fixed-base comb. With W windows and G = 64 / W signed radix-16 digits per window,
+// s = sum_{j < W} sum_{k < G} d[j * G + k] * 16^(j * G + k)
+// is evaluated as Horner scheme over k, such that only 4 * (G - 1) doublings
+// are required in addition to the 64 mixed additions.
+void
+ge25519_scalarmult_base(
+    ge25519_p3*    r,
+    const sc25519* s
+)
+{
+    signed char   digits[SC25519_WINDOW4_SIZE];
+    ge25519_p1p1  t;
+    ge25519_p2    u;
+    ge25519_niels n;
+    int           pos;
+    uint8_t       window;
+
+    sc25519_window4(digits, s);
+
+    ge25519_setneutral(r);
+
+    for (pos = GE25519_BASE_TABLE_DIGITS_PER_WINDOW - 1; pos >= 0; pos--)
+    {
+        if (pos != (GE25519_BASE_TABLE_DIGITS_PER_WINDOW - 1))
+        {
+            // r = 16 * r
+            ge25519_p3_to_p2(&u, r);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p3(r, &t);
+        }
+
+        for (window = 0; window < GE25519_BASE_TABLE_WINDOWS; window++)
+        {
+            ge25519_select_base_multiple(&n, window,
+                                         digits[window * GE25519_BASE_TABLE_DIGITS_PER_WINDOW + pos]);
+            ge25519_mixadd_p1p1(&t, r, &n);
+            ge25519_p1p1_to_p3(r, &t);
+        }
+    }
+}
+
+#else // #if (GE25519_BASE_TABLE_WINDOWS > 0)
+
+// Calculates r[i] = (i + 1) * p for i = 0 .. 7.
+static void
+ge25519_multiples_cached(
+    ge25519_cached    r[8],
+    const ge25519_p3* p
+)
+{
+    ge25519_p1p1 t;
+    ge25519_p3   u;
+    ge25519_p2   v;
+    uint8_t      i;
+
+    ge25519_p3_to_cached(&r[0], p);
+    ge25519_p3_to_p2(&v, p);
+    ge25519_dbl_p1p1(&t, &v);
+    ge25519_p1p1_to_p3(&u, &t);
+    ge25519_p3_to_cached(&r[1], &u);
+    for (i = 2; i < 8; i++)
+    {
+        ge25519_add_p1p1(&t, &u, &r[0]);
+        ge25519_p1p1_to_p3(&u, &t);
+        ge25519_p3_to_cached(&r[i], &u);
+    }
+}
+
+// Without the table, the multiples of B are computed in RAM and the signed
+// 4 bit windows are processed with 252 doublings and 64 additions.
+// The table entries are selected in constant time.
+void
+ge25519_scalarmult_base(
+    ge25519_p3*    r,
+    const sc25519* s
+)
+{
+    signed char    digits[SC25519_WINDOW4_SIZE];
+    ge25519_cached multiples[8];
+    ge25519_cached c;
+    ge25519_p3     base;
+    ge25519_p1p1   t;
+    ge25519_p2     u;
+    fe25519        minusT2d;
+    int            i;
+    uint8_t        ctr;
+
+    sc25519_window4(digits, s);
+    ge25519_setbase(&base);
+    ge25519_multiples_cached(multiples, &base);
+
+    ge25519_setneutral(r);
+
+    for (i = SC25519_WINDOW4_SIZE - 1; i >= 0; i--)
+    {
+        uint8_t bnegative = isNegative(digits[i]);
+        uint8_t babs = (uint8_t)(digits[i] - (((-bnegative) & digits[i]) << 1));
+
+        if (i != (SC25519_WINDOW4_SIZE - 1))
+        {
+            ge25519_p3_to_p2(&u, r);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p2(&u, &t);
+            ge25519_dbl_p1p1(&t, &u); ge25519_p1p1_to_p3(r, &t);
+        }
+
+        // Start with the neutral element (1, 1, 1, 0).
+        fe25519_setone(&c.xaddy);
+        fe25519_setone(&c.ysubx);
+        fe25519_setone(&c.z);
+        fe25519_setzero(&c.t2d);
+        for (ctr = 0; ctr < 8; ctr++)
+        {
+            uint8_t hit = ge25519_equal(babs, (uint8_t)(ctr + 1));
+
+            fe25519_cmov(&c.xaddy, &multiples[ctr].xaddy, hit);
+            fe25519_cmov(&c.ysubx, &multiples[ctr].ysubx, hit);
+            fe25519_cmov(&c.z, &multiples[ctr].z, hit);
+            fe25519_cmov(&c.t2d, &multiples[ctr].t2d, hit);
+        }
+        fe25519_cswap(&c.xaddy, &c.ysubx, bnegative);
+        fe25519_neg(&minusT2d, &c.t2d);
+        fe25519_cmov(&c.t2d, &minusT2d, bnegative);
+
+        ge25519_add_p1p1(&t, r, &c);
+        ge25519_p1p1_to_p3(r, &t);
+    }
+}
+
+#endif // #if (GE25519_BASE_TABLE_WINDOWS > 0)
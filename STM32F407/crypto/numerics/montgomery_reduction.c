@@ -0,0 +1,126 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file montgomery_reduction.c
+
+    Word-wise Montgomery reduction (REDC) of a 512 bit value modulo a 256 bit
+    prime with R = 2^256, as used for the sc25519_mont arithmetic.
+
+    Two versions are provided:
+    - 64 bit hosts (__int128 available): four iterations on 64 bit words.
+      -prime^-1 mod 2^64 is obtained from the 32 bit m0inverse of the
+      constants table by one Newton step.
+    - portable 32 bit version: eight iterations on 32 bit words.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/montgomery_reduction.h"
+
+// Fixme: This code won't work on big endian targets.
+
+#ifdef __SIZEOF_INT128__
+
+/// Calculates in * 2^-256 modulo the prime. The result is found in the upper
+/// 256 bits of in and is smaller than two times the prime if in is smaller than
+/// prime * 2^256.
+void
+montgomery_partialReduce(
+    UN_512bitValue*                 in,
+    const STMontgomeryConstants256* pTable
+)
+{
+    const uint64_t* prime = pTable->prime.as_uint64_t;
+    uint64_t        m0inverse = pTable->m0inverse;
+    int             i, j;
+
+    // -prime^-1 mod 2^32 => -prime^-1 mod 2^64
+    m0inverse *= 2 + prime[0] * m0inverse;
+
+    for (i = 0; i < 4; i++)
+    {
+        uint64_t          m = in->as_uint64_t[i] * m0inverse;
+        unsigned __int128 accu = 0;
+
+        // in += m * prime * 2^(64 i), clearing word i.
+        for (j = 0; j < 4; j++)
+        {
+            accu += (unsigned __int128)m * prime[j] + in->as_uint64_t[i + j];
+            in->as_uint64_t[i + j] = (uint64_t)accu;
+            accu >>= 64;
+        }
+        for (j = i + 4; j < 8; j++)
+        {
+            accu += in->as_uint64_t[j];
+            in->as_uint64_t[j] = (uint64_t)accu;
+            accu >>= 64;
+        }
+    }
+}
+
+#else
+
+/// Calculates in * 2^-256 modulo the prime. The result is found in the upper
+/// 256 bits of in and is smaller than two times the prime if in is smaller than
+/// prime * 2^256.
+void
+montgomery_partialReduce(
+    UN_512bitValue*                 in,
+    const STMontgomeryConstants256* pTable
+)
+{
+    const uint32_t* prime = pTable->prime.as_uint32_t;
+    int             i, j;
+
+    for (i = 0; i < 8; i++)
+    {
+        uint32_t m = in->as_uint32_t[i] * pTable->m0inverse;
+        uint64_t accu = 0;
+
+        // in += m * prime * 2^(32 i), clearing word i.
+        for (j = 0; j < 8; j++)
+        {
+            accu += (uint64_t)m * prime[j] + in->as_uint32_t[i + j];
+            in->as_uint32_t[i + j] = (uint32_t)accu;
+            accu >>= 32;
+        }
+        for (j = i + 8; j < 16; j++)
+        {
+            accu += in->as_uint32_t[j];
+            in->as_uint32_t[j] = (uint32_t)accu;
+            accu >>= 32;
+        }
+    }
+}
+
+#endif
+
+/// Calculates out = in * 2^-256 modulo the prime, fully reduced. in is used as
+/// temporary buffer and shall be smaller than prime * 2^256. Constant time.
+void
+montgomery_reduce(
+    UN_256bitValue*                 out,
+    UN_512bitValue*                 in,
+    const STMontgomeryConstants256* pTable
+)
+{
+    UN_256bitValue tmp;
+    int64_t        accu = 0;
+    uint8_t        ctr;
+
+    montgomery_partialReduce(in, pTable);
+
+    // Subtract the prime if the result is not negative.
+    for (ctr = 0; ctr < 8; ctr++)
+    {
+        accu += in->as_uint32_t[8 + ctr];
+        accu -= pTable->prime.as_uint32_t[ctr];
+        tmp.as_uint32_t[ctr] = (uint32_t)accu;
+        accu >>= 32;
+    }
+    cpy_256bitvalue(out, &in->as_256_bitValue[1]);
+    conditionalMove_256bitValue(out, &tmp, (uint8_t)((~accu) & 1));
+}
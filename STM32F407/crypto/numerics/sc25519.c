@@ -22,8 +22,9 @@ static const UN_288bitValue sc25519_scalar =
 
 #define uint32_scalar sc25519_scalar.as_uint32_t
 
-#else
+#endif
 
+// kSquare = 2^512 mod L, prime = L, m0inverse = -L^-1 mod 2^32.
 static const UNMontgomeryConstants256 sc25519_scalarMontgomeryPrecalc = {{
  0x01,  0x0f,  0x9c,  0x44,  0xe3,  0x11,  0x06,  0xa4, 
  0x47,  0x93,  0x85,  0x68,  0xa7,  0x1b,  0x0e,  0xd0, 
@@ -36,8 +37,8 @@ static const UNMontgomeryConstants256 sc25519_scalarMontgomeryPrecalc = {{
  0x1b,  0x7e,  0x54,  0x12
 }};
 
+#if (REDUCTION_TYPE == MONTGOMERY_REDUCTION)
 #define uint32_scalar sc25519_scalarMontgomeryPrecalc.constants.prime.as_uint32_t
-
 #endif
 
 static int32_t
@@ -169,6 +170,25 @@ sc25519_from64bytes(
     }
 }
 
+int
+sc25519_is_canonical_vartime(
+    const uint8_t s[32]
+)
+{
+    // Fixme: This code won't work on big endian targets.
+    const uint8_t* order = (const uint8_t*)uint32_scalar;
+    int            i;
+
+    for (i = 31; i >= 0; i--)
+    {
+        if (s[i] != order[i])
+        {
+            return s[i] < order[i];
+        }
+    }
+    return 0;
+}
+
 void
 sc25519_to32bytes(
     uint8_t  r[32],
@@ -356,6 +376,141 @@ sc25519_sqr(
 
 #endif
 
+/* Adds c to the 512 bit product, such that only one reduction is required. */
+void
+sc25519_muladd(
+    sc25519*       r,
+    const sc25519* x,
+    const sc25519* y,
+    const sc25519* c
+)
+{
+    UN_512bitValue temp;
+    UN_512bitValue addend;
+
+    multiply256x256(&temp, x, y);
+
+    cpy_256bitvalue(&addend.as_256_bitValue[0], c);
+    setzero_256bitvalue(&addend.as_256_bitValue[1]);
+    bigint_add(temp.as_uint32_t, addend.as_uint32_t, 16);
+
+    sc25519_reduce(&temp);
+    cpy_256bitvalue(r, &temp.as_256_bitValue[0]);
+}
+
+void
+sc25519_to_mont(
+    sc25519_mont*  r,
+    const sc25519* x
+)
+{
+    UN_512bitValue tmp;
+
+    multiply256x256(&tmp, x, &sc25519_scalarMontgomeryPrecalc.constants.kSquare);
+    montgomery_reduce(&r->value, &tmp, &sc25519_scalarMontgomeryPrecalc.constants);
+}
+
+void
+sc25519_from_mont(
+    sc25519*            r,
+    const sc25519_mont* x
+)
+{
+    UN_512bitValue tmp;
+
+    cpy_256bitvalue(&tmp.as_256_bitValue[0], &x->value);
+    setzero_256bitvalue(&tmp.as_256_bitValue[1]);
+    montgomery_reduce(r, &tmp, &sc25519_scalarMontgomeryPrecalc.constants);
+}
+
+void
+sc25519_mont_from32bytes(
+    sc25519_mont* r,
+    const uint8_t x[32]
+)
+{
+    sc25519 tmp;
+    uint8_t ctr;
+
+    for (ctr = 0; ctr < 32; ctr++)
+    {
+        // Fixme: This code won't work on big endian targets.
+        tmp.as_uint8_t[ctr] = x[ctr];
+    }
+    sc25519_to_mont(r, &tmp);
+}
+
+void
+sc25519_mont_to32bytes(
+    uint8_t             r[32],
+    const sc25519_mont* x
+)
+{
+    sc25519 tmp;
+
+    sc25519_from_mont(&tmp, x);
+    sc25519_to32bytes(r, &tmp);
+}
+
+void
+sc25519_mont_mul(
+    sc25519_mont*       r,
+    const sc25519_mont* x,
+    const sc25519_mont* y
+)
+{
+    UN_512bitValue tmp;
+
+    multiply256x256(&tmp, &x->value, &y->value);
+    montgomery_reduce(&r->value, &tmp, &sc25519_scalarMontgomeryPrecalc.constants);
+}
+
+void
+sc25519_mont_sqr(
+    sc25519_mont*       r,
+    const sc25519_mont* x
+)
+{
+    UN_512bitValue tmp;
+
+    square256(&tmp, &x->value);
+    montgomery_reduce(&r->value, &tmp, &sc25519_scalarMontgomeryPrecalc.constants);
+}
+
+/// Montgomery's trick: one sc25519_invert and 3 (n - 1) multiplications.
+void
+sc25519_invert_batch(
+    sc25519       r[],
+    const sc25519 x[],
+    size_t        n
+)
+{
+    sc25519 inv;
+    size_t  i;
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    // r[i] = x[0] * ... * x[i]
+    cpy_256bitvalue(&r[0], &x[0]);
+    for (i = 1; i < n; i++)
+    {
+        sc25519_mul(&r[i], &r[i - 1], &x[i]);
+    }
+
+    sc25519_invert(&inv, &r[n - 1]);
+
+    // inv = (x[0] * ... * x[i])^-1
+    for (i = n - 1; i > 0; i--)
+    {
+        sc25519_mul(&r[i], &inv, &r[i - 1]);
+        sc25519_mul(&inv, &inv, &x[i]);
+    }
+    cpy_256bitvalue(&r[0], &inv);
+}
+
 /// convert the scalar s to a representation of 64 or 72 signed chars containing
 /// 4 bits each. (NAF-Form with values -8 .. + 8).
 /// This is done for speedup of the fixed-window scalar multiplication
@@ -389,6 +544,81 @@ sc25519_window4(
     r[SC25519_WINDOW4_SIZE - 1] += carry;
 }
 
+/// r[i] = bit i of s1 + 2 * bit i of s2 for i = 0 .. 254.
+void
+sc25519_2interleave1(
+    uint8_t  r[255],
+    const sc25519* s1,
+    const sc25519* s2
+)
+{
+    int i;
+
+    for (i = 0; i < 255; i++)
+    {
+        r[i] = (uint8_t)(((s1->as_uint8_t[i >> 3] >> (i & 7)) & 1) |
+                         (((s2->as_uint8_t[i >> 3] >> (i & 7)) & 1) << 1));
+    }
+}
+
+/// Sliding window recoding as in ref10: start with the bits of s and merge
+/// each nonzero digit with the following w digits as long as the result stays
+/// within -(2^(w-1) - 1) .. 2^(w-1) - 1. Not constant time.
+void
+sc25519_slide(
+    signed char    r[SC25519_SLIDE_SIZE],
+    const sc25519* s,
+    uint8_t        w
+)
+{
+    int limit = (1 << (w - 1)) - 1;
+    int i;
+    int b;
+    int k;
+
+    for (i = 0; i < SC25519_SLIDE_SIZE; i++)
+    {
+        r[i] = (signed char)((s->as_uint8_t[i >> 3] >> (i & 7)) & 1);
+    }
+
+    for (i = 0; i < SC25519_SLIDE_SIZE; i++)
+    {
+        if (!r[i])
+        {
+            continue;
+        }
+        for (b = 1; (b < w) && (i + b < SC25519_SLIDE_SIZE); b++)
+        {
+            if (!r[i + b])
+            {
+                continue;
+            }
+            if (r[i] + (r[i + b] << b) <= limit)
+            {
+                r[i] = (signed char)(r[i] + (r[i + b] << b));
+                r[i + b] = 0;
+            }
+            else if (r[i] - (r[i + b] << b) >= -limit)
+            {
+                r[i] = (signed char)(r[i] - (r[i + b] << b));
+                for (k = i + b; k < SC25519_SLIDE_SIZE; k++)
+                {
+                    if (!r[k])
+                    {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+}
+
 // Returns 0 if x>y, returns 1 otherwise
  int greaterThan(const UN_256bitValue* x, const UN_256bitValue* y) {
     // int i;
@@ -454,16 +684,7 @@ void sc25519_binary_extended_gcd(UN_256bitValue *R, const UN_256bitValue *X, con
     cpy_256bitvalue(R, &D);
 }
 
-// Attention: Variable time execution due to the extended GCD algorithm!
+// Kept for compatibility, constant time by now.
 void sc25519_inverse(UN_256bitValue *R, const UN_256bitValue *X) {
-    UN_256bitValue order = {{
-        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
-        0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10 
-    }};
-    sc25519_binary_extended_gcd(R, &order, X);
-    // In case R < 0, add order until positive
-    while((R->as_uint32_t[7] & 0x80000000) != 0)
-        bigint_add(R->as_uint32_t, order.as_uint32_t, 8);
+    sc25519_invert(R, X);
 }
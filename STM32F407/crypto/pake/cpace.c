@@ -0,0 +1,376 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file cpace.c
+
+    CPace with X25519 and SHA-512 and the AuCPace augmentation.
+
+    - Generator: g = Elligator2(SHA-512(lv_cat(DSI, PRS, zero padding, CI,
+      sid))[0 .. 31]), the padding filling the first hash block.
+    - Shares: Y = X25519(y, g) for a random scalar y.
+    - ISK = SHA-512(lv_cat(DSI || "_ISK", sid, K) || lv_cat(Ya, ADa) ||
+      lv_cat(Yb, ADb)) with K = X25519(y, Ypeer) and a the initiator.
+    - AuCPace: PRS = X25519(x, W) on the server and X25519(w, X) on the
+      client with W = X25519(w, B) and X = X25519(x, B).
+
+    lv_cat prepends the LEB128 encoded length to each of its arguments. The
+    ISK hash is started when the generator is derived, such that sid need not
+    be stored in the session.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_pake.h"
+#include "../include/cpacedefs.h"
+#include "../include/crypto_scalarmult.h"
+#include "../include/fe25519.h"
+#include "../include/randombytes.h"
+
+static const uint8_t cpace_dsi[] = "CPace255";
+static const uint8_t cpace_dsiIsk[] = "CPace255_ISK";
+
+// Input block size of SHA-512, filled by DSI, PRS and the zero padding.
+#define CPACE_S_IN_BYTES 128
+
+static uint64_t
+cpace_clock(
+    const crypto_cpace_session* session
+)
+{
+    return session->clock ? session->clock() : 0;
+}
+
+// Number of bytes of the LEB128 encoding of len.
+static size_t
+cpace_leb128(
+    uint8_t out[10],
+    size_t  len
+)
+{
+    size_t n = 0;
+
+    do
+    {
+        out[n] = (uint8_t)(len & 0x7f);
+        len >>= 7;
+        if (len)
+        {
+            out[n] |= 0x80;
+        }
+        n++;
+    } while (len);
+    return n;
+}
+
+// Hashes prepend_len(data).
+static void
+cpace_hash_lv(
+    crypto_hash_sha512_state* hs,
+    const uint8_t*            data,
+    size_t                    len
+)
+{
+    uint8_t leb128[10];
+
+    crypto_hash_sha512_update(hs, leb128, cpace_leb128(leb128, len));
+    crypto_hash_sha512_update(hs, data, len);
+}
+
+static int
+cpace_iszero(
+    const uint8_t* x
+)
+{
+    uint8_t acc = 0;
+    int     i;
+
+    for (i = 0; i < crypto_cpace_BYTES; i++)
+    {
+        acc |= x[i];
+    }
+    return acc == 0;
+}
+
+static void
+cpace_fail(
+    crypto_cpace_session* session
+)
+{
+    crypto_pake_clock clock = session->clock;
+    uint32_t          role = session->role;
+    uint64_t          cycles[crypto_cpace_PHASES];
+
+    // Keeps the timings for the analysis of failed handshakes.
+    memcpy(cycles, session->cycles, sizeof(cycles));
+    memset(session, 0, sizeof(*session));
+    session->state = crypto_cpace_STATE_FAILED;
+    session->role = role;
+    session->clock = clock;
+    memcpy(session->cycles, cycles, sizeof(cycles));
+}
+
+size_t
+crypto_pake_arena_init(crypto_pake_arena *arena,void *memory,size_t size,crypto_pake_clock clock)
+{
+    uintptr_t address = (uintptr_t)memory;
+    size_t    skip = (size_t)((sizeof(uint64_t) - (address % sizeof(uint64_t))) % sizeof(uint64_t));
+
+    arena->clock = clock;
+    arena->sessions = (crypto_cpace_session*)(void*)((uint8_t*)memory + skip);
+    arena->capacity = (size < skip) ? 0 : (size - skip) / sizeof(crypto_cpace_session);
+    memset(arena->sessions, 0, arena->capacity * sizeof(crypto_cpace_session));
+    return arena->capacity;
+}
+
+crypto_cpace_session*
+crypto_pake_session_open(crypto_pake_arena *arena,uint32_t role)
+{
+    size_t i;
+
+    for (i = 0; i < arena->capacity; i++)
+    {
+        crypto_cpace_session* session = &arena->sessions[i];
+
+        if (session->state == crypto_cpace_STATE_FREE)
+        {
+            memset(session, 0, sizeof(*session));
+            session->state = crypto_cpace_STATE_OPEN;
+            session->role = role;
+            session->clock = arena->clock;
+            return session;
+        }
+    }
+    return NULL;
+}
+
+void
+crypto_pake_session_close(crypto_pake_arena *arena,crypto_cpace_session *session)
+{
+    if ((session >= arena->sessions) && (session < arena->sessions + arena->capacity))
+    {
+        memset(session, 0, sizeof(*session));
+    }
+}
+
+// Generator and start of the ISK hash for the given PRS.
+static void
+cpace_generator(
+    crypto_cpace_session* session,
+    const uint8_t*        prs,
+    size_t                prslen,
+    const uint8_t*        ci,
+    size_t                cilen,
+    const uint8_t*        sid,
+    size_t                sidlen
+)
+{
+    static const uint8_t     zeros[CPACE_S_IN_BYTES] = { 0 };
+    crypto_hash_sha512_state hs;
+    uint8_t                  hash[crypto_hash_sha512_BYTES];
+    uint8_t                  leb128[10];
+    size_t                   used, zpadlen = 0;
+    fe25519                  r, u;
+
+    // len_zpad = max(0, s_in_bytes - 1 - len(prepend_len(PRS)) - len(prepend_len(DSI)))
+    used = 1 + cpace_leb128(leb128, prslen) + prslen + 1 + sizeof(cpace_dsi) - 1;
+    if (used < CPACE_S_IN_BYTES)
+    {
+        zpadlen = CPACE_S_IN_BYTES - used;
+    }
+
+    crypto_hash_sha512_init(&hs);
+    cpace_hash_lv(&hs, cpace_dsi, sizeof(cpace_dsi) - 1);
+    cpace_hash_lv(&hs, prs, prslen);
+    cpace_hash_lv(&hs, zeros, zpadlen);
+    cpace_hash_lv(&hs, ci, cilen);
+    cpace_hash_lv(&hs, sid, sidlen);
+    crypto_hash_sha512_final(&hs, hash);
+
+    fe25519_unpack(&r, hash); // clears bit #255
+    fe25519_elligator2(&u, &r);
+    fe25519_pack(session->g, &u);
+
+    crypto_hash_sha512_init(&session->isk);
+    cpace_hash_lv(&session->isk, cpace_dsiIsk, sizeof(cpace_dsiIsk) - 1);
+    cpace_hash_lv(&session->isk, sid, sidlen);
+
+    memset(hash, 0, sizeof(hash));
+    memset(&r, 0, sizeof(r));
+    memset(&u, 0, sizeof(u));
+}
+
+int
+crypto_cpace_generator(crypto_cpace_session *session,const uint8_t *prs,size_t prslen,
+                       const uint8_t *ci,size_t cilen,const uint8_t *sid,size_t sidlen)
+{
+    uint64_t start = cpace_clock(session);
+
+    if (session->state != crypto_cpace_STATE_OPEN)
+    {
+        return -1;
+    }
+    cpace_generator(session, prs, prslen, ci, cilen, sid, sidlen);
+    session->state = crypto_cpace_STATE_GENERATOR;
+    session->cycles[crypto_cpace_PHASE_GENERATOR] = cpace_clock(session) - start;
+    return 0;
+}
+
+int
+crypto_aucpace_generator(crypto_cpace_session *session,const uint8_t *ci,size_t cilen,
+                         const uint8_t *sid,size_t sidlen)
+{
+    uint64_t start = cpace_clock(session);
+
+    if (session->state != crypto_cpace_STATE_AUGMENTED)
+    {
+        return -1;
+    }
+    cpace_generator(session, session->prs, sizeof(session->prs), ci, cilen, sid, sidlen);
+    memset(session->prs, 0, sizeof(session->prs));
+    session->state = crypto_cpace_STATE_GENERATOR;
+    session->cycles[crypto_cpace_PHASE_GENERATOR] = cpace_clock(session) - start;
+    return 0;
+}
+
+// Share for the scalar y, or for a random one if y is NULL.
+static int
+cpace_share(
+    crypto_cpace_session* session,
+    uint8_t*              Y,
+    const uint8_t*        y
+)
+{
+    uint64_t start = cpace_clock(session);
+
+    if (session->state != crypto_cpace_STATE_GENERATOR)
+    {
+        return -1;
+    }
+    if (y)
+    {
+        memcpy(session->y, y, sizeof(session->y));
+    }
+    else
+    {
+        randombytes(session->y, sizeof(session->y));
+    }
+    crypto_scalarmult_curve25519(session->Y, session->y, session->g);
+    memset(session->g, 0, sizeof(session->g));
+    memcpy(Y, session->Y, crypto_cpace_BYTES);
+    session->state = crypto_cpace_STATE_SHARED;
+    session->cycles[crypto_cpace_PHASE_SHARE] = cpace_clock(session) - start;
+    return 0;
+}
+
+int
+crypto_cpace_share(crypto_cpace_session *session,uint8_t *Y)
+{
+    return cpace_share(session, Y, NULL);
+}
+
+int
+crypto_cpace_share_scalar(
+    crypto_cpace_session* session,
+    uint8_t*              Y,
+    const uint8_t*        y
+)
+{
+    return cpace_share(session, Y, y);
+}
+
+int
+crypto_cpace_finish(crypto_cpace_session *session,uint8_t *isk,const uint8_t *Ypeer,
+                    const uint8_t *ad,size_t adlen,const uint8_t *adPeer,size_t adPeerlen)
+{
+    uint64_t start = cpace_clock(session);
+    uint8_t  K[crypto_cpace_BYTES];
+
+    if (session->state != crypto_cpace_STATE_SHARED)
+    {
+        return -1;
+    }
+
+    crypto_scalarmult_curve25519(K, session->y, Ypeer);
+    if (cpace_iszero(K))
+    {
+        cpace_fail(session);
+        session->cycles[crypto_cpace_PHASE_FINISH] = cpace_clock(session) - start;
+        return -1;
+    }
+
+    cpace_hash_lv(&session->isk, K, sizeof(K));
+    if (session->role == crypto_cpace_INITIATOR)
+    {
+        cpace_hash_lv(&session->isk, session->Y, crypto_cpace_BYTES);
+        cpace_hash_lv(&session->isk, ad, adlen);
+        cpace_hash_lv(&session->isk, Ypeer, crypto_cpace_BYTES);
+        cpace_hash_lv(&session->isk, adPeer, adPeerlen);
+    }
+    else
+    {
+        cpace_hash_lv(&session->isk, Ypeer, crypto_cpace_BYTES);
+        cpace_hash_lv(&session->isk, adPeer, adPeerlen);
+        cpace_hash_lv(&session->isk, session->Y, crypto_cpace_BYTES);
+        cpace_hash_lv(&session->isk, ad, adlen);
+    }
+    crypto_hash_sha512_final(&session->isk, isk);
+
+    memset(K, 0, sizeof(K));
+    memset(session->y, 0, sizeof(session->y));
+    session->state = crypto_cpace_STATE_DONE;
+    session->cycles[crypto_cpace_PHASE_FINISH] = cpace_clock(session) - start;
+    return 0;
+}
+
+int
+crypto_aucpace_verifier(uint8_t *W,const uint8_t *w)
+{
+    return crypto_scalarmult_base_curve25519(W, w);
+}
+
+int
+crypto_aucpace_server_augment(crypto_cpace_session *session,uint8_t *X,const uint8_t *W)
+{
+    uint64_t start = cpace_clock(session);
+    uint8_t  x[crypto_cpace_BYTES];
+
+    if (session->state != crypto_cpace_STATE_OPEN)
+    {
+        return -1;
+    }
+
+    randombytes(x, sizeof(x));
+    crypto_scalarmult_base_curve25519(X, x);
+    crypto_scalarmult_curve25519(session->prs, x, W);
+    memset(x, 0, sizeof(x));
+
+    session->state = crypto_cpace_STATE_AUGMENTED;
+    session->cycles[crypto_cpace_PHASE_AUGMENT] = cpace_clock(session) - start;
+    return 0;
+}
+
+int
+crypto_aucpace_client_augment(crypto_cpace_session *session,const uint8_t *w,const uint8_t *X)
+{
+    uint64_t start = cpace_clock(session);
+
+    if (session->state != crypto_cpace_STATE_OPEN)
+    {
+        return -1;
+    }
+
+    crypto_scalarmult_curve25519(session->prs, w, X);
+    if (cpace_iszero(session->prs))
+    {
+        cpace_fail(session);
+        session->cycles[crypto_cpace_PHASE_AUGMENT] = cpace_clock(session) - start;
+        return -1;
+    }
+
+    session->state = crypto_cpace_STATE_AUGMENTED;
+    session->cycles[crypto_cpace_PHASE_AUGMENT] = cpace_clock(session) - start;
+    return 0;
+}
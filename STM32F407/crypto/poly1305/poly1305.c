@@ -0,0 +1,460 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file poly1305.c
+
+    Poly1305 one-time authenticator (NaCl crypto_onetimeauth, RFC 8439).
+
+    Two representations of the accumulator modulo 2^130 - 5 are provided:
+    - CRYPTO_HAS_POLY1305_RADIX44 (64 bit hosts): three limbs of 44, 44 and
+      42 bits with 64x64 => 128 bit products.
+    - otherwise five limbs of 26 bits with 32x32 => 64 bit products. The
+      block loop is replaced by crypto/asm/cortex_m4_poly1305_update_state.S
+      with CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_onetimeauth.h"
+
+static uint32_t load_littleendian(const uint8_t * x)
+{
+    return (uint32_t)(x[0]) | (((uint32_t)(x[1])) << 8) | (((uint32_t)(x[2])) << 16) | (((uint32_t)(x[3])) << 24);
+}
+
+static void store_littleendian(uint8_t * x, uint32_t u)
+{
+    x[0] = (uint8_t)u;
+    u >>= 8;
+    x[1] = (uint8_t)u;
+    u >>= 8;
+    x[2] = (uint8_t)u;
+    u >>= 8;
+    x[3] = (uint8_t)u;
+}
+
+#ifdef CRYPTO_HAS_POLY1305_RADIX44
+
+#define MASK44 0xfffffffffffULL
+#define MASK42 0x3ffffffffffULL
+
+static uint64_t load_littleendian64(const uint8_t * x)
+{
+    return (uint64_t)load_littleendian(x) | ((uint64_t)load_littleendian(x + 4) << 32);
+}
+
+static void poly1305_init_r(crypto_onetimeauth_poly1305_state *state, const uint8_t * k)
+{
+    uint64_t t0 = load_littleendian64(k);
+    uint64_t t1 = load_littleendian64(k + 8);
+
+    // r &= 0x0ffffffc0ffffffc0ffffffc0fffffff
+    state->r[0] = t0 & 0xffc0fffffffULL;
+    state->r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffULL;
+    state->r[2] = (t1 >> 24) & 0x00ffffffc0fULL;
+
+    state->h[0] = 0;
+    state->h[1] = 0;
+    state->h[2] = 0;
+}
+
+// h = (h + m_i + hibit) * r for nblocks blocks of 16 bytes.
+static void poly1305_blocks(crypto_onetimeauth_poly1305_state *state, const uint8_t * m, size_t nblocks, uint64_t hibit)
+{
+    const uint64_t r0 = state->r[0];
+    const uint64_t r1 = state->r[1];
+    const uint64_t r2 = state->r[2];
+    // 2^132 = 4 * 5 modulo 2^130 - 5
+    const uint64_t s1 = r1 * (5 << 2);
+    const uint64_t s2 = r2 * (5 << 2);
+    uint64_t h0 = state->h[0];
+    uint64_t h1 = state->h[1];
+    uint64_t h2 = state->h[2];
+
+    hibit <<= 40;
+
+    while (nblocks--)
+    {
+        unsigned __int128 d0, d1, d2;
+        uint64_t t0 = load_littleendian64(m);
+        uint64_t t1 = load_littleendian64(m + 8);
+        uint64_t c;
+
+        h0 += t0 & MASK44;
+        h1 += ((t0 >> 44) | (t1 << 20)) & MASK44;
+        h2 += ((t1 >> 24) & MASK42) | hibit;
+
+        d0 = (unsigned __int128)h0 * r0 + (unsigned __int128)h1 * s2 + (unsigned __int128)h2 * s1;
+        d1 = (unsigned __int128)h0 * r1 + (unsigned __int128)h1 * r0 + (unsigned __int128)h2 * s2;
+        d2 = (unsigned __int128)h0 * r2 + (unsigned __int128)h1 * r1 + (unsigned __int128)h2 * r0;
+
+        c = (uint64_t)(d0 >> 44);
+        h0 = (uint64_t)d0 & MASK44;
+        d1 += c;
+        c = (uint64_t)(d1 >> 44);
+        h1 = (uint64_t)d1 & MASK44;
+        d2 += c;
+        c = (uint64_t)(d2 >> 42);
+        h2 = (uint64_t)d2 & MASK42;
+        h0 += c * 5;
+        c = h0 >> 44;
+        h0 &= MASK44;
+        h1 += c;
+
+        m += crypto_onetimeauth_poly1305_BLOCKBYTES;
+    }
+
+    state->h[0] = h0;
+    state->h[1] = h1;
+    state->h[2] = h2;
+}
+
+// out = (h mod 2^130 - 5) + pad mod 2^128, constant time.
+static void poly1305_finish(crypto_onetimeauth_poly1305_state *state, uint8_t * out)
+{
+    uint64_t h0 = state->h[0];
+    uint64_t h1 = state->h[1];
+    uint64_t h2 = state->h[2];
+    uint64_t g0, g1, g2, c, mask, t0, t1;
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        c = h1 >> 44;
+        h1 &= MASK44;
+        h2 += c;
+        c = h2 >> 42;
+        h2 &= MASK42;
+        h0 += c * 5;
+        c = h0 >> 44;
+        h0 &= MASK44;
+        h1 += c;
+    }
+
+    // g = h - (2^130 - 5), select g if it is not negative.
+    g0 = h0 + 5;
+    c = g0 >> 44;
+    g0 &= MASK44;
+    g1 = h1 + c;
+    c = g1 >> 44;
+    g1 &= MASK44;
+    g2 = h2 + c - (1ULL << 42);
+
+    mask = (g2 >> 63) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+
+    t0 = (uint64_t)state->pad[0] | ((uint64_t)state->pad[1] << 32);
+    t1 = (uint64_t)state->pad[2] | ((uint64_t)state->pad[3] << 32);
+    h0 += t0 & MASK44;
+    c = h0 >> 44;
+    h0 &= MASK44;
+    h1 += (((t0 >> 44) | (t1 << 20)) & MASK44) + c;
+    c = h1 >> 44;
+    h1 &= MASK44;
+    h2 += ((t1 >> 24) & MASK42) + c;
+
+    t0 = h0 | (h1 << 44);
+    t1 = (h1 >> 20) | (h2 << 24);
+    store_littleendian(out + 0, (uint32_t)t0);
+    store_littleendian(out + 4, (uint32_t)(t0 >> 32));
+    store_littleendian(out + 8, (uint32_t)t1);
+    store_littleendian(out + 12, (uint32_t)(t1 >> 32));
+}
+
+#else // #ifdef CRYPTO_HAS_POLY1305_RADIX44
+
+#define MASK26 0x3ffffff
+
+static void poly1305_init_r(crypto_onetimeauth_poly1305_state *state, const uint8_t * k)
+{
+    // r &= 0x0ffffffc0ffffffc0ffffffc0fffffff
+    state->r[0] = load_littleendian(k + 0) & 0x3ffffff;
+    state->r[1] = (load_littleendian(k + 3) >> 2) & 0x3ffff03;
+    state->r[2] = (load_littleendian(k + 6) >> 4) & 0x3ffc0ff;
+    state->r[3] = (load_littleendian(k + 9) >> 6) & 0x3f03fff;
+    state->r[4] = (load_littleendian(k + 12) >> 8) & 0x00fffff;
+
+    memset(state->h, 0, sizeof(state->h));
+}
+
+#ifdef CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE
+
+// Block loop of poly1305_blocks in crypto/asm/cortex_m4_poly1305_update_state.S.
+// m shall be 32 bit aligned, hibit is 1 << 24 or 0 and nblocks is not zero.
+extern void
+poly1305_update_state_asm(
+    uint32_t       h[5],
+    const uint32_t r[5],
+    const uint8_t* m,
+    uint32_t       nblocks,
+    uint32_t       hibit
+);
+
+// h = (h + m_i + hibit) * r for nblocks blocks of 16 bytes.
+static void poly1305_blocks(crypto_onetimeauth_poly1305_state *state, const uint8_t * m, size_t nblocks, uint32_t hibit)
+{
+    hibit <<= 24;
+
+    if (((uintptr_t)m & 3) == 0)
+    {
+        if (nblocks)
+        {
+            poly1305_update_state_asm(state->h, state->r, m, (uint32_t)nblocks, hibit);
+        }
+        return;
+    }
+
+    while (nblocks--)
+    {
+        uint32_t block[crypto_onetimeauth_poly1305_BLOCKBYTES / sizeof(uint32_t)];
+
+        memcpy(block, m, sizeof(block));
+        poly1305_update_state_asm(state->h, state->r, (const uint8_t *)block, 1, hibit);
+        m += crypto_onetimeauth_poly1305_BLOCKBYTES;
+    }
+}
+
+#else
+
+// h = (h + m_i + hibit) * r for nblocks blocks of 16 bytes.
+static void poly1305_blocks(crypto_onetimeauth_poly1305_state *state, const uint8_t * m, size_t nblocks, uint32_t hibit)
+{
+    const uint32_t r0 = state->r[0];
+    const uint32_t r1 = state->r[1];
+    const uint32_t r2 = state->r[2];
+    const uint32_t r3 = state->r[3];
+    const uint32_t r4 = state->r[4];
+    // 2^130 = 5 modulo 2^130 - 5
+    const uint32_t s1 = r1 * 5;
+    const uint32_t s2 = r2 * 5;
+    const uint32_t s3 = r3 * 5;
+    const uint32_t s4 = r4 * 5;
+    uint32_t h0 = state->h[0];
+    uint32_t h1 = state->h[1];
+    uint32_t h2 = state->h[2];
+    uint32_t h3 = state->h[3];
+    uint32_t h4 = state->h[4];
+
+    hibit <<= 24;
+
+    while (nblocks--)
+    {
+        uint64_t d0, d1, d2, d3, d4;
+        uint32_t c;
+
+        h0 += load_littleendian(m + 0) & MASK26;
+        h1 += (load_littleendian(m + 3) >> 2) & MASK26;
+        h2 += (load_littleendian(m + 6) >> 4) & MASK26;
+        h3 += (load_littleendian(m + 9) >> 6) & MASK26;
+        h4 += (load_littleendian(m + 12) >> 8) | hibit;
+
+        d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+        d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+        d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+        d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+        d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+        c = (uint32_t)(d0 >> 26);
+        h0 = (uint32_t)d0 & MASK26;
+        d1 += c;
+        c = (uint32_t)(d1 >> 26);
+        h1 = (uint32_t)d1 & MASK26;
+        d2 += c;
+        c = (uint32_t)(d2 >> 26);
+        h2 = (uint32_t)d2 & MASK26;
+        d3 += c;
+        c = (uint32_t)(d3 >> 26);
+        h3 = (uint32_t)d3 & MASK26;
+        d4 += c;
+        c = (uint32_t)(d4 >> 26);
+        h4 = (uint32_t)d4 & MASK26;
+        h0 += c * 5;
+        c = h0 >> 26;
+        h0 &= MASK26;
+        h1 += c;
+
+        m += crypto_onetimeauth_poly1305_BLOCKBYTES;
+    }
+
+    state->h[0] = h0;
+    state->h[1] = h1;
+    state->h[2] = h2;
+    state->h[3] = h3;
+    state->h[4] = h4;
+}
+
+#endif // #ifdef CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE
+
+// out = (h mod 2^130 - 5) + pad mod 2^128, constant time.
+static void poly1305_finish(crypto_onetimeauth_poly1305_state *state, uint8_t * out)
+{
+    uint32_t h0 = state->h[0];
+    uint32_t h1 = state->h[1];
+    uint32_t h2 = state->h[2];
+    uint32_t h3 = state->h[3];
+    uint32_t h4 = state->h[4];
+    uint32_t g0, g1, g2, g3, g4, c, mask;
+    uint64_t f;
+
+    c = h1 >> 26;
+    h1 &= MASK26;
+    h2 += c;
+    c = h2 >> 26;
+    h2 &= MASK26;
+    h3 += c;
+    c = h3 >> 26;
+    h3 &= MASK26;
+    h4 += c;
+    c = h4 >> 26;
+    h4 &= MASK26;
+    h0 += c * 5;
+    c = h0 >> 26;
+    h0 &= MASK26;
+    h1 += c;
+
+    // g = h - (2^130 - 5), select g if it is not negative.
+    g0 = h0 + 5;
+    c = g0 >> 26;
+    g0 &= MASK26;
+    g1 = h1 + c;
+    c = g1 >> 26;
+    g1 &= MASK26;
+    g2 = h2 + c;
+    c = g2 >> 26;
+    g2 &= MASK26;
+    g3 = h3 + c;
+    c = g3 >> 26;
+    g3 &= MASK26;
+    g4 = h4 + c - (1UL << 26);
+
+    mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+
+    // h mod 2^128
+    h0 = h0 | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+
+    f = (uint64_t)h0 + state->pad[0];
+    store_littleendian(out + 0, (uint32_t)f);
+    f = (uint64_t)h1 + state->pad[1] + (f >> 32);
+    store_littleendian(out + 4, (uint32_t)f);
+    f = (uint64_t)h2 + state->pad[2] + (f >> 32);
+    store_littleendian(out + 8, (uint32_t)f);
+    f = (uint64_t)h3 + state->pad[3] + (f >> 32);
+    store_littleendian(out + 12, (uint32_t)f);
+}
+
+#endif // #ifdef CRYPTO_HAS_POLY1305_RADIX44
+
+int
+crypto_onetimeauth_poly1305_init(crypto_onetimeauth_poly1305_state *state, const uint8_t *k)
+{
+    int i;
+
+    poly1305_init_r(state, k);
+    for (i = 0; i < 4; i++)
+    {
+        state->pad[i] = load_littleendian(k + 16 + 4 * i);
+    }
+    state->leftover = 0;
+
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305_update(crypto_onetimeauth_poly1305_state *state, const uint8_t *in, unsigned long long inlen)
+{
+    if (state->leftover)
+    {
+        unsigned long long want = crypto_onetimeauth_poly1305_BLOCKBYTES - state->leftover;
+
+        if (want > inlen)
+        {
+            want = inlen;
+        }
+        memcpy(state->buffer + state->leftover, in, (size_t)want);
+        state->leftover += (uint32_t)want;
+        in += want;
+        inlen -= want;
+
+        if (state->leftover < crypto_onetimeauth_poly1305_BLOCKBYTES)
+        {
+            return 0;
+        }
+        poly1305_blocks(state, state->buffer, 1, 1);
+        state->leftover = 0;
+    }
+
+    if (inlen >= crypto_onetimeauth_poly1305_BLOCKBYTES)
+    {
+        size_t nblocks = (size_t)(inlen / crypto_onetimeauth_poly1305_BLOCKBYTES);
+
+        poly1305_blocks(state, in, nblocks, 1);
+        in += nblocks * crypto_onetimeauth_poly1305_BLOCKBYTES;
+        inlen -= nblocks * crypto_onetimeauth_poly1305_BLOCKBYTES;
+    }
+
+    if (inlen)
+    {
+        memcpy(state->buffer, in, (size_t)inlen);
+        state->leftover = (uint32_t)inlen;
+    }
+
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305_final(crypto_onetimeauth_poly1305_state *state, uint8_t *out)
+{
+    if (state->leftover)
+    {
+        // The padding byte replaces the 2^128 bit of the last, partial block.
+        state->buffer[state->leftover] = 1;
+        memset(state->buffer + state->leftover + 1, 0, crypto_onetimeauth_poly1305_BLOCKBYTES - state->leftover - 1);
+        poly1305_blocks(state, state->buffer, 1, 0);
+    }
+
+    poly1305_finish(state, out);
+
+    memset(state, 0, sizeof(*state));
+
+    return 0;
+}
+
+int
+crypto_onetimeauth_poly1305(uint8_t *out, const uint8_t *in, unsigned long long inlen, const uint8_t *k)
+{
+    crypto_onetimeauth_poly1305_state state;
+
+    crypto_onetimeauth_poly1305_init(&state, k);
+    crypto_onetimeauth_poly1305_update(&state, in, inlen);
+    return crypto_onetimeauth_poly1305_final(&state, out);
+}
+
+int
+crypto_onetimeauth_poly1305_verify(const uint8_t *h, const uint8_t *in, unsigned long long inlen, const uint8_t *k)
+{
+    uint8_t  correct[crypto_onetimeauth_poly1305_BYTES];
+    uint32_t diff = 0;
+    int      i;
+
+    crypto_onetimeauth_poly1305(correct, in, inlen, k);
+    for (i = 0; i < crypto_onetimeauth_poly1305_BYTES; i++)
+    {
+        diff |= (uint32_t)(h[i] ^ correct[i]);
+    }
+
+    // 0 if diff == 0, -1 otherwise.
+    return (int)(((diff - 1) >> 8) & 1) - 1;
+}
@@ -12,8 +12,8 @@
   ============================================================================*/
 #include "../include/crypto_stream.h"
 #include "../include/crypto_target_config.h"
-#include "../local_includes/bigint.h"
-#include "../local_includes/salsa20defs.h"
+#include "../include/bigint.h"
+#include "../include/salsa20defs.h"
 
 #define ROUNDS 20
 
@@ -33,9 +33,7 @@ static void store_littleendian(uint8_t * x, uint32_t u)
     x[3] = (uint8_t)u;
 }
 
-#ifdef CRYPTO_HAS_ASM_HSALSA20_BLOCK
-
-#else
+#ifndef CRYPTO_HAS_ASM_HSALSA20_BLOCK
 
 #define SALSA_QUARTERROUND(a, b, c, R)                                                                                                     \
     {                                                                                                                                      \
@@ -83,11 +81,18 @@ static struct STSalsa20RoundInOut_ crypto_salsa20_round(struct STSalsa20RoundInO
     return io;
 }
 
-void crypto_core_hsalsa20_block(volatile uint32_t * x)
+static void salsa20_rounds(volatile uint32_t * state, int rounds)
 {
+    uint32_t x[16];
     int ctr;
 
-    for (ctr = ROUNDS; ctr > 0; ctr -= 2)
+    // The rounds work on a non-volatile copy, so that the state stays in registers.
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        x[ctr] = state[ctr];
+    }
+
+    for (ctr = rounds; ctr > 0; ctr -= 2)
     {
         STSalsa20RoundInOut io;
 
@@ -101,10 +106,25 @@ void crypto_core_hsalsa20_block(volatile uint32_t * x)
         SALSA20_R(io, x, 11, 10, 9, 8);
         SALSA20_R(io, x, 12, 15, 14, 13);
     }
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        state[ctr] = x[ctr];
+    }
+}
+
+void crypto_core_hsalsa20_block(volatile uint32_t * state)
+{
+    salsa20_rounds(state, ROUNDS);
+}
+
+void crypto_core_salsa208_block(volatile uint32_t * state)
+{
+    salsa20_rounds(state, 8);
 }
 #endif
 
-void crypto_core_salsa20_transform(uint32_t * inOut)
+static void crypto_core_salsa20_transform(uint32_t * inOut)
 {
     uint32_t x[16];
     int ctr;
@@ -123,7 +143,7 @@ void crypto_core_salsa20_transform(uint32_t * inOut)
 }
 
 
-int crypto_core_salsa20_aligned(uint32_t * out, const uint32_t * in, const uint32_t * k, const uint32_t * c)
+static int crypto_core_salsa20_aligned(uint32_t * out, const uint32_t * in, const uint32_t * k, const uint32_t * c)
 {
     out[0]  = c[0];
     out[1]  = k[0];
@@ -265,6 +285,43 @@ int crypto_core_hsalsa20(uint8_t * out, const uint8_t * in, const uint8_t * k, c
 
 const UN_128bitValue g_salsa20_sigma = {{'e', 'x', 'p', 'a', 'n', 'd', ' ', '3', '2', '-', 'b', 'y', 't', 'e', ' ', 'k'}};
 
+#ifdef CRYPTO_HAS_SALSA20_SIMD
+
+// Processes the leading blocks with the multi-block vector kernels. in holds the
+// nonce and the little endian block counter, which is advanced. Returns the
+// number of bytes processed.
+static unsigned int salsa20_xor_simd(uint8_t * c, const uint8_t * m, unsigned int len, uint8_t * in, const uint8_t * k)
+{
+    uint32_t j[16];
+    unsigned int done;
+
+    j[0]  = g_salsa20_sigma.as_uint32_t[0];
+    j[1]  = load_littleendian(k + 0);
+    j[2]  = load_littleendian(k + 4);
+    j[3]  = load_littleendian(k + 8);
+    j[4]  = load_littleendian(k + 12);
+    j[5]  = g_salsa20_sigma.as_uint32_t[1];
+    j[6]  = load_littleendian(in + 0);
+    j[7]  = load_littleendian(in + 4);
+    j[8]  = load_littleendian(in + 8);
+    j[9]  = load_littleendian(in + 12);
+    j[10] = g_salsa20_sigma.as_uint32_t[2];
+    j[11] = load_littleendian(k + 16);
+    j[12] = load_littleendian(k + 20);
+    j[13] = load_littleendian(k + 24);
+    j[14] = load_littleendian(k + 28);
+    j[15] = g_salsa20_sigma.as_uint32_t[3];
+
+    done = crypto_stream_salsa20_xor_simd(c, m, len, j);
+
+    store_littleendian(in + 8, j[8]);
+    store_littleendian(in + 12, j[9]);
+
+    return done;
+}
+
+#endif
+
 int crypto_stream_salsa20(uint8_t * c, unsigned clen, const uint8_t * n, const uint8_t * k)
 {
     UN_128bitValue in;
@@ -293,6 +350,15 @@ int crypto_stream_salsa20(uint8_t * c, unsigned clen, const uint8_t * n, const u
         in.as_uint8_t[i] = 0;
     }
 
+#ifdef CRYPTO_HAS_SALSA20_SIMD
+    if (clen >= SALSA20_SIMD_MIN_BYTES)
+    {
+        u = salsa20_xor_simd(c, 0, clen, in.as_uint8_t, key.as_uint8_t);
+        clen -= u;
+        c += u;
+    }
+#endif
+
     while (clen >= 64)
     {
         crypto_core_salsa20_aligned((uint32_t *)c, in.as_uint32_t, key.as_uint32_t, g_salsa20_sigma.as_uint32_t);
@@ -345,6 +411,16 @@ int crypto_stream_salsa20_xor(uint8_t * c, const uint8_t * m, unsigned mlen, con
         in[i] = 0;
     }
 
+#ifdef CRYPTO_HAS_SALSA20_SIMD
+    if (mlen >= SALSA20_SIMD_MIN_BYTES)
+    {
+        u = salsa20_xor_simd(c, m, mlen, in, k);
+        mlen -= u;
+        c += u;
+        m += u;
+    }
+#endif
+
     while (mlen >= 64)
     {
         crypto_core_salsa20(block, in, k, g_salsa20_sigma.as_uint8_t);
@@ -378,25 +454,82 @@ int crypto_stream_salsa20_xor(uint8_t * c, const uint8_t * m, unsigned mlen, con
     return 0;
 }
 
-int crypto_stream_salsa20_xor_chunked_init(salsa20_xor_chunked *context, const uint8_t *n,const uint8_t *k)
+// c = m ^ keystream for len bytes, word-wise if all buffers are 32 bit aligned.
+static void salsa20_xor_keystream(uint8_t * c, const uint8_t * m, const uint8_t * keystream, unsigned int len)
 {
-    uint32_t i;
+    unsigned int i = 0;
 
-    for (i = 0; i < 32; ++i)
+    if (((uintptr_t)c | (uintptr_t)m | (uintptr_t)keystream) % sizeof(uint32_t) == 0)
+    {
+        for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t))
+        {
+            *(uint32_t *)(c + i) = *(const uint32_t *)(m + i) ^ *(const uint32_t *)(keystream + i);
+        }
+    }
+
+    for (; i < len; ++i)
+    {
+        c[i] = m[i] ^ keystream[i];
+    }
+}
+
+// Computes the keystream block for the counter of the context into context->block
+// and advances the counter. j is the input block of salsa20_chunked_input.
+static void salsa20_chunked_block(salsa20_xor_chunked *context, uint32_t * j)
+{
+    int ctr;
+
+    j[8] = (uint32_t)context->counter;
+    j[9] = (uint32_t)(context->counter >> 32);
+
+    for (ctr = 0; ctr < 16; ctr++)
     {
-        ((uint8_t *)(context->key))[i] = k[i];
+        context->block[ctr] = j[ctr];
     }
 
+    crypto_core_hsalsa20_block(context->block);
+
+    for (ctr = 0; ctr < 16; ctr++)
+    {
+        context->block[ctr] += j[ctr];
+    }
+
+    context->counter++;
+}
+
+static void salsa20_chunked_input(const salsa20_xor_chunked *context, uint32_t * j)
+{
+    j[0]  = g_salsa20_sigma.as_uint32_t[0];
+    j[1]  = context->key[0];
+    j[2]  = context->key[1];
+    j[3]  = context->key[2];
+    j[4]  = context->key[3];
+    j[5]  = g_salsa20_sigma.as_uint32_t[1];
+    j[6]  = context->nonce[0];
+    j[7]  = context->nonce[1];
+    j[10] = g_salsa20_sigma.as_uint32_t[2];
+    j[11] = context->key[4];
+    j[12] = context->key[5];
+    j[13] = context->key[6];
+    j[14] = context->key[7];
+    j[15] = g_salsa20_sigma.as_uint32_t[3];
+}
+
+int crypto_stream_salsa20_xor_chunked_init(salsa20_xor_chunked *context, const uint8_t *n,const uint8_t *k)
+{
+    uint32_t i;
+
     for (i = 0; i < 8; ++i)
     {
-        ((uint8_t *)(context->in))[i] = n[i];
+        context->key[i] = load_littleendian(k + 4 * i);
     }
 
-    for (i = 8; i < 16; ++i)
+    for (i = 0; i < 2; ++i)
     {
-        ((uint8_t *)(context->in))[i] = 0;
+        context->nonce[i] = load_littleendian(n + 4 * i);
     }
 
+    context->counter = 0;
     context->chunk_bytes_left = 0;
 
     return 0;
@@ -404,59 +537,62 @@ int crypto_stream_salsa20_xor_chunked_init(salsa20_xor_chunked *context, const u
 
 int crypto_stream_salsa20_xor_chunked (salsa20_xor_chunked *context, uint8_t *c,const uint8_t *m,unsigned int d)
 {
-    uint32_t i;
-    unsigned int u;
-    UN_512bitValue *block;
-    uint8_t *in;
+    uint32_t j[16];
+    uint8_t *block;
 
     if (!d)
     {
         return 0;
     }
 
-    block = (UN_512bitValue *)(context->block);
-    in = (uint8_t *)(context->in);
+    block = (uint8_t *)(context->block);
 
     if (context->chunk_bytes_left)
     {
         uint32_t e;
-        uint32_t offs;
 
         e = context->chunk_bytes_left;
-        offs = 64 - e;
         if (e > d)
         {
             e = d;
         }
-        
-        for (i = 0; i < e; ++i)
-        {
-            c[i] = m[i] ^ block->as_uint8_t[offs+i];
-        }
-        
+
+        salsa20_xor_keystream(c, m, block + 64 - context->chunk_bytes_left, e);
+
         c += e;
         m += e;
         d -= e;
         context->chunk_bytes_left -= e;
+
+        if (!d)
+        {
+            return 0;
+        }
     }
 
-    while (d >= 64)
+    salsa20_chunked_input(context, j);
+
+#ifdef CRYPTO_HAS_SALSA20_SIMD
+    if (d >= SALSA20_SIMD_MIN_BYTES)
     {
-        crypto_core_salsa20_aligned(block->as_uint32_t, context->in, context->key, g_salsa20_sigma.as_uint32_t);
+        unsigned int u;
 
-        for (i = 0; i < 64; ++i)
-        {
-            c[i] = m[i] ^ block->as_uint8_t[i];
-        }
+        j[8] = (uint32_t)context->counter;
+        j[9] = (uint32_t)(context->counter >> 32);
 
-        u = 1;
+        u = crypto_stream_salsa20_xor_simd(c, m, d, j);
 
-        for (i = 8; i < 16; ++i)
-        {
-            u += (unsigned int)in[i];
-            in[i] = (uint8_t)u;
-            u >>= 8;
-        }
+        context->counter = ((uint64_t)j[9] << 32) | j[8];
+        d -= u;
+        c += u;
+        m += u;
+    }
+#endif
+
+    while (d >= 64)
+    {
+        salsa20_chunked_block(context, j);
+        salsa20_xor_keystream(c, m, block, 64);
 
         d -= 64;
         c += 64;
@@ -465,23 +601,10 @@ int crypto_stream_salsa20_xor_chunked (salsa20_xor_chunked *context, uint8_t *c,
 
     if (d)
     {
-        context->chunk_bytes_left = 64 - d;
-
-        crypto_core_salsa20_aligned(block->as_uint32_t, context->in, context->key, g_salsa20_sigma.as_uint32_t);
-
-        for (i = 0; i < d; ++i)
-        {
-            c[i] = m[i] ^ block->as_uint8_t[i];
-        }
-
-        u = 1;
+        salsa20_chunked_block(context, j);
+        salsa20_xor_keystream(c, m, block, d);
 
-        for (i = 8; i < 16; ++i)
-        {
-            u += (unsigned int)in[i];
-            in[i] = (uint8_t)u;
-            u >>= 8;
-        }
+        context->chunk_bytes_left = 64 - d;
     }
 
     return 0;
@@ -14,6 +14,7 @@
 
 #include "../include/fe25519.h"
 #include "../include/sc25519.h"
+#include "../include/ge25519.h"
 #include "../include/randombytes.h"
 #include "../include/crypto_scalarmult.h"
 
@@ -193,8 +194,12 @@ crypto_scalarmult_curve25519(
 
     curve25519_cswap(&state,state.previousProcessedBit);
 
+#ifdef CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+    fe25519_invert_safegcd(&state.zp, &state.zp);
+#else
     // optimize for stack usage.
     fe25519_invert_useProvidedScratchBuffers (&state.zp, &state.zp, &state.xq, &state.zq, &state.x0);    
+#endif
     fe25519_mul(&state.xp, &state.xp, &state.zp);
     fe25519_reduceCompletely(&state.xp);
 
@@ -209,6 +214,53 @@ const uint8_t g_basePointCurve25519[32] =
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+#if (GE25519_BASE_TABLE_WINDOWS > 0)
+
+// Fixed-base variant: Calculate n * B on the edwards curve using the precomputed
+// comb tables and map the result to the montgomery u-coordinate by use of
+// the birational map u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y).
+int
+crypto_scalarmult_base_curve25519(
+    uint8_t*       q,
+    const uint8_t* n
+)
+{
+    ge25519_p3 P;
+    sc25519    s;
+#ifndef CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+    fe25519    t;
+#endif
+    uint8_t    i;
+
+    for (i = 0; i < 32; i++)
+    {
+        s.as_uint8_t [i] = n[i];
+    }
+
+    s.as_uint8_t [0] &= 248;
+    s.as_uint8_t [31] &= 127;
+    s.as_uint8_t [31] |= 64;
+
+    ge25519_scalarmult_base(&P, &s);
+
+    fe25519_add(&P.x, &P.z, &P.y);
+    fe25519_sub(&P.t, &P.z, &P.y);
+
+#ifdef CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+    fe25519_invert_safegcd(&P.t, &P.t);
+#else
+    // optimize for stack usage.
+    fe25519_invert_useProvidedScratchBuffers (&P.t, &P.t, &P.y, &P.z, &t);
+#endif
+    fe25519_mul(&P.x, &P.x, &P.t);
+
+    fe25519_pack (q, &P.x);
+
+    return 0;
+}
+
+#else
+
 int
 crypto_scalarmult_base_curve25519(
     uint8_t*       q,
@@ -218,3 +270,5 @@ crypto_scalarmult_base_curve25519(
     return crypto_scalarmult_curve25519(q, n, g_basePointCurve25519);
 }
 
+#endif // #if (GE25519_BASE_TABLE_WINDOWS > 0)
+
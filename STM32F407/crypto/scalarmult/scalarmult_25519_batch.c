@@ -0,0 +1,44 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file scalarmult_25519_batch.c
+
+    Batch curve25519 ECDH. Dispatches groups of four to the AVX2 kernel of
+    scalarmult_25519_x4_avx2.c if the CPU supports it.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/fe25519.h"
+#include "../include/crypto_scalarmult.h"
+
+int
+crypto_scalarmult_curve25519_batch(
+    uint8_t       r[][crypto_scalarmult_BYTES],
+    const uint8_t s[][crypto_scalarmult_SCALARBYTES],
+    const uint8_t p[][crypto_scalarmult_BYTES],
+    size_t        n
+)
+{
+    size_t i = 0;
+
+#ifdef CRYPTO_HAS_AVX2
+    if (crypto_cpu_has_avx2())
+    {
+        for (; (i + 4) <= n; i += 4)
+        {
+            crypto_scalarmult_curve25519_x4_avx2(&r[i], &s[i], &p[i]);
+        }
+    }
+#endif
+
+    // Remaining n mod 4 items (or all items if AVX2 is not available).
+    for (; i < n; i++)
+    {
+        crypto_scalarmult_curve25519(r[i], s[i], p[i]);
+    }
+    return 0;
+}
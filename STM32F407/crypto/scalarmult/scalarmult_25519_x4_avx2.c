@@ -0,0 +1,151 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file scalarmult_25519_x4_avx2.c
+
+    Four curve25519 ladders interleaved across the four 64 bit lanes of the
+    AVX2 registers, with the lane-sliced field arithmetic of fe25519x4_avx2.h.
+    Compiled with function level target attributes, the caller checks for
+    AVX2 support at runtime.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/fe25519x4_avx2.h"
+#include "../include/crypto_scalarmult.h"
+
+#ifdef CRYPTO_HAS_AVX2
+
+typedef struct
+{
+    fe25519x4 x0;
+    fe25519x4 xp;
+    fe25519x4 zp;
+    fe25519x4 xq;
+    fe25519x4 zq;
+} ST_curve25519ladderstepWorkingStateX4;
+
+/// Same formulas and temporaries as curve25519_ladderstep() in scalarmult_25519.c.
+static AVX2_INLINE void
+curve25519_ladderstep_x4(
+    ST_curve25519ladderstepWorkingStateX4* pState
+)
+{
+    fe25519x4 t1, t2;
+
+    fe25519x4 *b1 = &pState->xp; fe25519x4 *b2 = &pState->zp;
+    fe25519x4 *b3 = &pState->xq; fe25519x4 *b4 = &pState->zq;
+    fe25519x4 *b5 = &t1; fe25519x4 *b6 = &t2;
+
+    fe25519x4_add(b5, b1, b2); // A = X2+Z2
+    fe25519x4_sub(b6, b1, b2); // B = X2-Z2
+    fe25519x4_add(b1, b3, b4); // C = X3+Z3
+    fe25519x4_sub(b2, b3, b4); // D = X3-Z3
+    fe25519x4_mul(b3, b2, b5); // DA= D*A
+    fe25519x4_mul(b2, b1, b6); // CB= C*B
+    fe25519x4_add(b1, b2, b3); // T0= DA+CB
+    fe25519x4_sub(b4, b3, b2); // T2= DA-CB
+    fe25519x4_square(b3, b1); // X5==T1= T0^2
+    fe25519x4_square(b1, b4); // T3= t2^2
+    fe25519x4_mul(b4, b1, &pState->x0); // Z5=X1*t3
+    fe25519x4_square(b1, b5); // AA=A^2
+    fe25519x4_square(b5, b6); // BB=B^2
+    fe25519x4_sub(b2, b1, b5); // E=AA-BB
+    fe25519x4_mul(b1, b5, b1); // X4= AA*BB
+    fe25519x4_mpyWith121666(b6, b2); // T4 = a24*E
+    fe25519x4_add(b6, b6, b5); // T5 = BB + t4
+    fe25519x4_mul(b2, b6, b2); // Z4 = E*t5
+}
+
+AVX2_FUNCTION void
+crypto_scalarmult_curve25519_x4_avx2(
+    uint8_t       r[4][crypto_scalarmult_BYTES],
+    const uint8_t s[4][crypto_scalarmult_SCALARBYTES],
+    const uint8_t p[4][crypto_scalarmult_BYTES]
+)
+{
+    ST_curve25519ladderstepWorkingStateX4 state;
+    uint8_t                               scalar[4][32];
+    uint8_t                               packed[4][32];
+    fe25519                               z[4];
+    fe25519                               scratch[4];
+    uint64_t                              previousProcessedBit[4] = { 0, 0, 0, 0 };
+    int                                   nextScalarBitToProcess;
+    int                                   i, k;
+
+    for (k = 0; k < 4; k++)
+    {
+        for (i = 0; i < 32; i++)
+        {
+            scalar[k][i] = s[k][i];
+        }
+        scalar[k][0] &= 248;
+        scalar[k][31] &= 127;
+        scalar[k][31] |= 64;
+    }
+
+    fe25519x4_unpack(&state.x0, p);
+
+    for (i = 0; i < 10; i++)
+    {
+        state.xq.v[i] = state.x0.v[i];
+        state.zq.v[i] = _mm256_setzero_si256();
+        state.xp.v[i] = _mm256_setzero_si256();
+        state.zp.v[i] = _mm256_setzero_si256();
+    }
+    state.zq.v[0] = _mm256_set1_epi64x(1);
+    state.xp.v[0] = _mm256_set1_epi64x(1);
+
+    for (nextScalarBitToProcess = 254; nextScalarBitToProcess >= 0; nextScalarBitToProcess--)
+    {
+        uint8_t  byteNo = (uint8_t)(nextScalarBitToProcess >> 3);
+        uint8_t  bitNo = (uint8_t)(nextScalarBitToProcess & 7);
+        uint64_t swap[4];
+        __m256i  mask;
+
+        for (k = 0; k < 4; k++)
+        {
+            uint64_t bit = 1 & (scalar[k][byteNo] >> bitNo);
+
+            swap[k] = bit ^ previousProcessedBit[k];
+            previousProcessedBit[k] = bit;
+        }
+        mask = _mm256_set_epi64x(-(int64_t)swap[3], -(int64_t)swap[2],
+                                 -(int64_t)swap[1], -(int64_t)swap[0]);
+
+        fe25519x4_cswap(&state.xp, &state.xq, mask);
+        fe25519x4_cswap(&state.zp, &state.zq, mask);
+        curve25519_ladderstep_x4(&state);
+    }
+
+    {
+        __m256i mask = _mm256_set_epi64x(-(int64_t)previousProcessedBit[3], -(int64_t)previousProcessedBit[2],
+                                         -(int64_t)previousProcessedBit[1], -(int64_t)previousProcessedBit[0]);
+
+        fe25519x4_cswap(&state.xp, &state.xq, mask);
+        fe25519x4_cswap(&state.zp, &state.zq, mask);
+    }
+
+    // Convert to the scalar representation for the final inversion.
+    fe25519x4_pack(packed, &state.zp);
+    for (k = 0; k < 4; k++)
+    {
+        fe25519_unpack(&z[k], packed[k]);
+    }
+    fe25519_batch_invert(z, z, 4, scratch);
+
+    fe25519x4_pack(packed, &state.xp);
+    for (k = 0; k < 4; k++)
+    {
+        fe25519 x;
+
+        fe25519_unpack(&x, packed[k]);
+        fe25519_mul(&x, &x, &z[k]);
+        fe25519_pack(r[k], &x);
+    }
+}
+
+#endif // #ifdef CRYPTO_HAS_AVX2
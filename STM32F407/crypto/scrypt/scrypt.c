@@ -0,0 +1,377 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file scrypt.c
+
+    scrypt (RFC 7914): B = PBKDF2-HMAC-SHA256(P, S, 1, 128 r p), ROMix of
+    each of the p lanes of 128 r bytes, DK = PBKDF2-HMAC-SHA256(P, B, 1, dkLen).
+
+    ROMix keeps the blocks as 32 bit words in host order. With the SIMD
+    BlockMix (scrypt_simd.c) the words of each 64 byte block are stored in
+    diagonal order, i.e. word 4 i + 5 k mod 16 at position 4 i + k. The order
+    is kept from the conversion of the PBKDF2 output until the final
+    conversion back, XOR and addition do not depend on it. Salsa20/8 is
+    crypto_core_salsa208_block of salsa20.c, the asm loop of the HSalsa20
+    core on the Cortex M4.
+
+    The lanes are distributed among the threads, each thread with its own
+    V and X, Y in the memory of the caller.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_pwhash.h"
+#include "../include/crypto_hash.h"
+#include "../include/crypto_stream.h"
+#include "../include/scryptdefs.h"
+
+#ifdef CRYPTO_HAS_PTHREADS
+#include <pthread.h>
+#endif
+
+#ifdef CRYPTO_HAS_SCRYPT_SIMD
+// Position of word i of a block.
+static const uint8_t scrypt_position[16] = { 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 };
+#define SCRYPT_POSITION(i) scrypt_position[i]
+#else
+#define SCRYPT_POSITION(i) (i)
+#endif
+
+typedef struct
+{
+    crypto_hash_sha256_state inner;
+    crypto_hash_sha256_state outer;
+} scrypt_hmac_state;
+
+typedef struct
+{
+    uint8_t*  B;
+    uint64_t  N;
+    uint32_t  r;
+    uint32_t  p;
+    uint32_t  first;    // first lane of the thread
+    uint32_t  step;     // number of threads
+    uint32_t* V;
+    uint32_t* XY;
+} scrypt_worker;
+
+static uint32_t load_littleendian(const uint8_t * x)
+{
+    return (uint32_t)(x[0]) | (((uint32_t)(x[1])) << 8) | (((uint32_t)(x[2])) << 16) | (((uint32_t)(x[3])) << 24);
+}
+
+static void store_littleendian(uint8_t * x, uint32_t u)
+{
+    x[0] = (uint8_t)u;
+    x[1] = (uint8_t)(u >> 8);
+    x[2] = (uint8_t)(u >> 16);
+    x[3] = (uint8_t)(u >> 24);
+}
+
+static void
+scrypt_hmac_init(
+    scrypt_hmac_state* hmac,
+    const uint8_t*     key,
+    size_t             keylen
+)
+{
+    uint8_t pad[crypto_hash_sha256_BLOCKBYTES];
+    uint8_t hash[crypto_hash_sha256_BYTES];
+    size_t  i;
+
+    if (keylen > crypto_hash_sha256_BLOCKBYTES)
+    {
+        crypto_hash_sha256(hash, key, keylen);
+        key = hash;
+        keylen = sizeof(hash);
+    }
+
+    memset(pad, 0x36, sizeof(pad));
+    for (i = 0; i < keylen; i++)
+    {
+        pad[i] ^= key[i];
+    }
+    crypto_hash_sha256_init(&hmac->inner);
+    crypto_hash_sha256_update(&hmac->inner, pad, sizeof(pad));
+
+    memset(pad, 0x5c, sizeof(pad));
+    for (i = 0; i < keylen; i++)
+    {
+        pad[i] ^= key[i];
+    }
+    crypto_hash_sha256_init(&hmac->outer);
+    crypto_hash_sha256_update(&hmac->outer, pad, sizeof(pad));
+
+    memset(pad, 0, sizeof(pad));
+    memset(hash, 0, sizeof(hash));
+}
+
+// PBKDF2-HMAC-SHA256 with one iteration, the only case needed by scrypt.
+static void
+scrypt_pbkdf2_sha256(
+    uint8_t*       out,
+    size_t         outlen,
+    const uint8_t* passwd,
+    size_t         passwdlen,
+    const uint8_t* salt,
+    size_t         saltlen
+)
+{
+    scrypt_hmac_state        hmac;
+    crypto_hash_sha256_state salted;
+    uint8_t                  t[crypto_hash_sha256_BYTES];
+    uint8_t                  counter[4];
+    uint32_t                 i;
+
+    scrypt_hmac_init(&hmac, passwd, passwdlen);
+    salted = hmac.inner;
+    crypto_hash_sha256_update(&salted, salt, saltlen);
+
+    for (i = 1; outlen > 0; i++)
+    {
+        crypto_hash_sha256_state h = salted;
+        size_t                   n = (outlen < sizeof(t)) ? outlen : sizeof(t);
+
+        // T_i = HMAC(P, S || INT(i))
+        counter[0] = (uint8_t)(i >> 24);
+        counter[1] = (uint8_t)(i >> 16);
+        counter[2] = (uint8_t)(i >> 8);
+        counter[3] = (uint8_t)i;
+        crypto_hash_sha256_update(&h, counter, sizeof(counter));
+        crypto_hash_sha256_final(&h, t);
+        h = hmac.outer;
+        crypto_hash_sha256_update(&h, t, sizeof(t));
+        crypto_hash_sha256_final(&h, t);
+
+        memcpy(out, t, n);
+        out += n;
+        outlen -= n;
+    }
+
+    memset(&hmac, 0, sizeof(hmac));
+    memset(&salted, 0, sizeof(salted));
+    memset(t, 0, sizeof(t));
+}
+
+#ifdef CRYPTO_HAS_SCRYPT_SIMD
+
+#define scrypt_blockmix crypto_scrypt_blockmix_simd
+
+#else
+
+// out = BlockMix(in ^ v), v may be NULL.
+static void
+scrypt_blockmix(
+    uint32_t*       out,
+    const uint32_t* in,
+    const uint32_t* v,
+    size_t          r
+)
+{
+    uint32_t x[16];
+    uint32_t j[16];
+    size_t   i;
+    int      k;
+
+    for (k = 0; k < 16; k++)
+    {
+        x[k] = in[16 * (2 * r - 1) + k] ^ (v ? v[16 * (2 * r - 1) + k] : 0);
+    }
+
+    for (i = 0; i < 2 * r; i++)
+    {
+        // Even blocks to the first half of out, odd blocks to the second.
+        uint32_t* y = out + 16 * ((i >> 1) + (i & 1) * r);
+
+        for (k = 0; k < 16; k++)
+        {
+            j[k] = x[k] ^ in[16 * i + k] ^ (v ? v[16 * i + k] : 0);
+            x[k] = j[k];
+        }
+        crypto_core_salsa208_block(x);
+        for (k = 0; k < 16; k++)
+        {
+            x[k] += j[k];
+            y[k] = x[k];
+        }
+    }
+}
+
+#endif
+
+// ROMix of the lane B of 128 r bytes with V of N blocks and X, Y of two blocks.
+static void
+scrypt_romix(
+    uint8_t*  B,
+    uint64_t  N,
+    size_t    r,
+    uint32_t* V,
+    uint32_t* XY
+)
+{
+    const size_t words = 32 * r;
+    uint32_t*    X = XY;
+    uint32_t*    Y = XY + words;
+    uint32_t*    last;
+    uint64_t     i;
+    size_t       k;
+
+    for (k = 0; k < words; k++)
+    {
+        X[(k & ~(size_t)15) + SCRYPT_POSITION(k & 15)] = load_littleendian(B + 4 * k);
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        memcpy(V + i * words, X, words * sizeof(uint32_t));
+        scrypt_blockmix(Y, X, NULL, r);
+        last = X;
+        X = Y;
+        Y = last;
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        // Integerify: first 64 bits of the last block.
+        const uint32_t* block = X + words - 16;
+        uint64_t        j = ((uint64_t)block[SCRYPT_POSITION(1)] << 32) | block[SCRYPT_POSITION(0)];
+
+        scrypt_blockmix(Y, X, V + (j & (N - 1)) * words, r);
+        last = X;
+        X = Y;
+        Y = last;
+    }
+
+    for (k = 0; k < words; k++)
+    {
+        store_littleendian(B + 4 * k, X[(k & ~(size_t)15) + SCRYPT_POSITION(k & 15)]);
+    }
+}
+
+static void
+scrypt_lanes(
+    const scrypt_worker* worker
+)
+{
+    uint32_t lane;
+
+    for (lane = worker->first; lane < worker->p; lane += worker->step)
+    {
+        scrypt_romix(worker->B + (size_t)lane * 128 * worker->r, worker->N, worker->r, worker->V, worker->XY);
+    }
+}
+
+#ifdef CRYPTO_HAS_PTHREADS
+
+static void*
+scrypt_thread(
+    void* arg
+)
+{
+    scrypt_lanes((const scrypt_worker*)arg);
+    return NULL;
+}
+
+#endif
+
+int
+crypto_pwhash_scryptsalsa208sha256_ll(const uint8_t *passwd,size_t passwdlen,
+                                      const uint8_t *salt,size_t saltlen,
+                                      uint64_t N,uint32_t r,uint32_t p,
+                                      uint8_t *buf,size_t buflen,
+                                      void *memory,size_t memorySize,unsigned int threads)
+{
+    scrypt_worker workers[crypto_pwhash_scryptsalsa208sha256_THREADSMAX];
+    size_t        blockBytes, laneBytes, used;
+    uint8_t*      aligned;
+    uint8_t*      B;
+    unsigned int  t;
+#ifdef CRYPTO_HAS_PTHREADS
+    pthread_t     handles[crypto_pwhash_scryptsalsa208sha256_THREADSMAX];
+    int           started[crypto_pwhash_scryptsalsa208sha256_THREADSMAX];
+#endif
+
+    if ((N < 2) || (N & (N - 1)) || (r == 0) || (p == 0) || ((uint64_t)r * p >= ((uint64_t)1 << 30)))
+    {
+        return -1;
+    }
+
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+    if (threads > p)
+    {
+        threads = p;
+    }
+    if (threads > crypto_pwhash_scryptsalsa208sha256_THREADSMAX)
+    {
+        threads = crypto_pwhash_scryptsalsa208sha256_THREADSMAX;
+    }
+#ifndef CRYPTO_HAS_PTHREADS
+    // The lanes are computed one after the other, one V suffices.
+    threads = 1;
+#endif
+
+    // Memory: alignment, p lanes, and V, X, Y of N + 2 blocks per thread.
+    blockBytes = (size_t)128 * r;
+    if ((N + 2 > (uint64_t)(SIZE_MAX / blockBytes / threads)) || (memorySize < 64))
+    {
+        return -1;
+    }
+    laneBytes = (size_t)(N + 2) * blockBytes;
+    used = (memorySize - 64) / blockBytes;
+    if (used < p || (used - p) / threads < N + 2)
+    {
+        return -1;
+    }
+
+    aligned = (uint8_t*)memory + ((64 - ((uintptr_t)memory % 64)) % 64);
+    B = aligned;
+    for (t = 0; t < threads; t++)
+    {
+        uint8_t* base = aligned + (size_t)p * blockBytes + t * laneBytes;
+
+        workers[t].B = B;
+        workers[t].N = N;
+        workers[t].r = r;
+        workers[t].p = p;
+        workers[t].first = t;
+        workers[t].step = threads;
+        workers[t].V = (uint32_t*)(void*)base;
+        workers[t].XY = (uint32_t*)(void*)(base + (size_t)N * blockBytes);
+    }
+
+    scrypt_pbkdf2_sha256(B, (size_t)p * blockBytes, passwd, passwdlen, salt, saltlen);
+
+#ifdef CRYPTO_HAS_PTHREADS
+    // The caller computes the lanes of worker 0, also those of workers
+    // without a thread.
+    for (t = 1; t < threads; t++)
+    {
+        started[t] = (pthread_create(&handles[t], NULL, scrypt_thread, &workers[t]) == 0);
+    }
+    scrypt_lanes(&workers[0]);
+    for (t = 1; t < threads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(handles[t], NULL);
+        }
+        else
+        {
+            scrypt_lanes(&workers[t]);
+        }
+    }
+#else
+    scrypt_lanes(&workers[0]);
+#endif
+
+    scrypt_pbkdf2_sha256(buf, buflen, passwd, passwdlen, B, (size_t)p * blockBytes);
+
+    memset(aligned, 0, (size_t)p * blockBytes + threads * laneBytes);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file scrypt_simd.c
+
+    BlockMix of scrypt with Salsa20/8 in 128 bit vectors. The blocks of a
+    BlockMix chain depend on each other, so the vectors hold the four
+    diagonals of one Salsa20 matrix instead of several blocks as in
+    salsa20_simd.c. The quarterrounds of the column round then work on whole
+    vectors, and rotating the lanes of three vectors turns the rows into
+    columns for the row round.
+
+    - SSE2 (x86-64) and NEON (AArch64).
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/scryptdefs.h"
+
+#ifdef CRYPTO_HAS_SCRYPT_SIMD
+
+// Column round and row round. x0 .. x3 hold the words
+// (0, 5, 10, 15), (4, 9, 14, 3), (8, 13, 2, 7) and (12, 1, 6, 11).
+#define SCRYPT_DOUBLEROUND(x0, x1, x2, x3)      \
+    x1 = XOR(x1, ROTL(ADD(x0, x3), 7));         \
+    x2 = XOR(x2, ROTL(ADD(x1, x0), 9));         \
+    x3 = XOR(x3, ROTL(ADD(x2, x1), 13));        \
+    x0 = XOR(x0, ROTL(ADD(x3, x2), 18));        \
+    x1 = LANES(x1, 3);                          \
+    x2 = LANES(x2, 2);                          \
+    x3 = LANES(x3, 1);                          \
+    x3 = XOR(x3, ROTL(ADD(x0, x1), 7));         \
+    x2 = XOR(x2, ROTL(ADD(x3, x0), 9));         \
+    x1 = XOR(x1, ROTL(ADD(x2, x3), 13));        \
+    x0 = XOR(x0, ROTL(ADD(x1, x2), 18));        \
+    x1 = LANES(x1, 1);                          \
+    x2 = LANES(x2, 2);                          \
+    x3 = LANES(x3, 3);
+
+#ifdef CRYPTO_HAS_SSE2
+
+#include <immintrin.h>
+
+typedef __m128i scrypt_vector;
+
+#define ADD(a, b) _mm_add_epi32(a, b)
+#define XOR(a, b) _mm_xor_si128(a, b)
+#define ROTL(a, r) _mm_or_si128(_mm_slli_epi32(a, r), _mm_srli_epi32(a, 32 - (r)))
+// Lane k of the result is lane k + n of a.
+#define LANES(a, n) _mm_shuffle_epi32(a, (n) == 1 ? 0x39 : ((n) == 2 ? 0x4e : 0x93))
+#define LOAD(p) _mm_load_si128((const __m128i*)(p))
+#define STORE(p, a) _mm_store_si128((__m128i*)(p), a)
+
+#endif // #ifdef CRYPTO_HAS_SSE2
+
+#ifdef CRYPTO_HAS_NEON
+
+#include <arm_neon.h>
+
+typedef uint32x4_t scrypt_vector;
+
+#define ADD(a, b) vaddq_u32(a, b)
+#define XOR(a, b) veorq_u32(a, b)
+#define ROTL(a, r) vsriq_n_u32(vshlq_n_u32(a, r), a, 32 - (r))
+#define LANES(a, n) vextq_u32(a, a, n)
+#define LOAD(p) vld1q_u32(p)
+#define STORE(p, a) vst1q_u32(p, a)
+
+#endif // #ifdef CRYPTO_HAS_NEON
+
+void
+crypto_scrypt_blockmix_simd(
+    uint32_t*       out,
+    const uint32_t* in,
+    const uint32_t* v,
+    size_t          r
+)
+{
+    const uint32_t* last = in + 16 * (2 * r - 1);
+    scrypt_vector   x0, x1, x2, x3;
+    size_t          i;
+
+    x0 = LOAD(last);
+    x1 = LOAD(last + 4);
+    x2 = LOAD(last + 8);
+    x3 = LOAD(last + 12);
+    if (v)
+    {
+        last = v + 16 * (2 * r - 1);
+        x0 = XOR(x0, LOAD(last));
+        x1 = XOR(x1, LOAD(last + 4));
+        x2 = XOR(x2, LOAD(last + 8));
+        x3 = XOR(x3, LOAD(last + 12));
+    }
+
+    for (i = 0; i < 2 * r; i++)
+    {
+        // Even blocks to the first half of out, odd blocks to the second.
+        uint32_t*     y = out + 16 * ((i >> 1) + (i & 1) * r);
+        scrypt_vector j0, j1, j2, j3;
+        int           k;
+
+        j0 = XOR(x0, LOAD(in + 16 * i));
+        j1 = XOR(x1, LOAD(in + 16 * i + 4));
+        j2 = XOR(x2, LOAD(in + 16 * i + 8));
+        j3 = XOR(x3, LOAD(in + 16 * i + 12));
+        if (v)
+        {
+            j0 = XOR(j0, LOAD(v + 16 * i));
+            j1 = XOR(j1, LOAD(v + 16 * i + 4));
+            j2 = XOR(j2, LOAD(v + 16 * i + 8));
+            j3 = XOR(j3, LOAD(v + 16 * i + 12));
+        }
+        x0 = j0;
+        x1 = j1;
+        x2 = j2;
+        x3 = j3;
+
+        for (k = 0; k < 4; k++)
+        {
+            SCRYPT_DOUBLEROUND(x0, x1, x2, x3)
+        }
+
+        x0 = ADD(x0, j0);
+        x1 = ADD(x1, j1);
+        x2 = ADD(x2, j2);
+        x3 = ADD(x3, j3);
+        STORE(y, x0);
+        STORE(y + 4, x1);
+        STORE(y + 8, x2);
+        STORE(y + 12, x3);
+    }
+}
+
+#endif // #ifdef CRYPTO_HAS_SCRYPT_SIMD
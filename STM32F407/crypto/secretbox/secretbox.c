@@ -0,0 +1,140 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file secretbox.c
+
+    crypto_secretbox_xsalsa20poly1305 (NaCl). Encryption and authentication
+    run in one pass over the message: the chunked Salsa20 stream and Poly1305
+    process the message in stripes of SECRETBOX_STRIPE_BYTES, so that each
+    stripe is still in the cache (or in the on-chip memory) when it is
+    authenticated. Opening checks the authenticator of the whole ciphertext
+    first and decrypts only valid boxes, as NaCl does.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_secretbox.h"
+#include "../include/crypto_onetimeauth.h"
+#include "../include/salsa20defs.h"
+
+// Multiple of the 64 byte Salsa20 block and of the 256 bytes of the multi-block
+// SIMD kernels.
+#define SECRETBOX_STRIPE_BYTES 512
+
+// Sets up the XSalsa20 stream for nonce n and key k and Poly1305 with the first
+// 32 bytes of the keystream. The stream continues with byte 32.
+static void
+secretbox_init(
+    salsa20_xor_chunked*               stream,
+    crypto_onetimeauth_poly1305_state* auth,
+    const uint8_t*                     n,
+    const uint8_t*                     k
+)
+{
+    uint8_t subkey[32];
+    uint8_t authkey[crypto_onetimeauth_poly1305_KEYBYTES];
+
+    crypto_core_hsalsa20(subkey, n, k, g_salsa20_sigma.as_uint8_t);
+    crypto_stream_salsa20_xor_chunked_init(stream, n + 16, subkey);
+
+    memset(authkey, 0, sizeof(authkey));
+    crypto_stream_salsa20_xor_chunked(stream, authkey, authkey, sizeof(authkey));
+    crypto_onetimeauth_poly1305_init(auth, authkey);
+
+    memset(subkey, 0, sizeof(subkey));
+    memset(authkey, 0, sizeof(authkey));
+}
+
+// Length of the stripe starting at pos (which is also the keystream position).
+// The first stripe ends with the first keystream block, so that the following
+// ones are processed by whole blocks.
+static unsigned int
+secretbox_stripe(
+    unsigned long long pos,
+    unsigned long long len
+)
+{
+    unsigned long long remaining = len - pos;
+    unsigned int       stripe = (pos % 64) ? (unsigned int)(64 - pos % 64) : SECRETBOX_STRIPE_BYTES;
+
+    return (remaining > stripe) ? stripe : (unsigned int)remaining;
+}
+
+int
+crypto_secretbox_xsalsa20poly1305(uint8_t *c, const uint8_t *m, unsigned long long mlen, const uint8_t *n, const uint8_t *k)
+{
+    salsa20_xor_chunked               stream;
+    crypto_onetimeauth_poly1305_state auth;
+    unsigned long long                pos;
+
+    if (mlen < crypto_secretbox_xsalsa20poly1305_ZEROBYTES)
+    {
+        return -1;
+    }
+
+    secretbox_init(&stream, &auth, n, k);
+
+    for (pos = crypto_secretbox_xsalsa20poly1305_ZEROBYTES; pos < mlen;)
+    {
+        unsigned int len = secretbox_stripe(pos, mlen);
+
+        crypto_stream_salsa20_xor_chunked(&stream, c + pos, m + pos, len);
+        crypto_onetimeauth_poly1305_update(&auth, c + pos, len);
+        pos += len;
+    }
+
+    crypto_onetimeauth_poly1305_final(&auth, c + crypto_secretbox_xsalsa20poly1305_BOXZEROBYTES);
+    memset(c, 0, crypto_secretbox_xsalsa20poly1305_BOXZEROBYTES);
+    memset(&stream, 0, sizeof(stream));
+
+    return 0;
+}
+
+int
+crypto_secretbox_xsalsa20poly1305_open(uint8_t *m, const uint8_t *c, unsigned long long clen, const uint8_t *n, const uint8_t *k)
+{
+    salsa20_xor_chunked               stream;
+    crypto_onetimeauth_poly1305_state auth;
+    uint8_t                           correct[crypto_onetimeauth_poly1305_BYTES];
+    unsigned long long                pos;
+    uint32_t                          diff = 0;
+    int                               i;
+
+    if (clen < crypto_secretbox_xsalsa20poly1305_ZEROBYTES)
+    {
+        return -1;
+    }
+
+    secretbox_init(&stream, &auth, n, k);
+
+    // The whole ciphertext is authenticated before anything is written to m.
+    crypto_onetimeauth_poly1305_update(&auth, c + crypto_secretbox_xsalsa20poly1305_ZEROBYTES,
+                                       clen - crypto_secretbox_xsalsa20poly1305_ZEROBYTES);
+    crypto_onetimeauth_poly1305_final(&auth, correct);
+    for (i = 0; i < crypto_onetimeauth_poly1305_BYTES; i++)
+    {
+        diff |= (uint32_t)(c[crypto_secretbox_xsalsa20poly1305_BOXZEROBYTES + i] ^ correct[i]);
+    }
+    memset(correct, 0, sizeof(correct));
+
+    if (diff)
+    {
+        memset(&stream, 0, sizeof(stream));
+        return -1;
+    }
+
+    for (pos = crypto_secretbox_xsalsa20poly1305_ZEROBYTES; pos < clen;)
+    {
+        unsigned int len = secretbox_stripe(pos, clen);
+
+        crypto_stream_salsa20_xor_chunked(&stream, m + pos, c + pos, len);
+        pos += len;
+    }
+    memset(&stream, 0, sizeof(stream));
+    memset(m, 0, crypto_secretbox_xsalsa20poly1305_ZEROBYTES);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file sha256.c
+
+    SHA-256 (FIPS 180-4), needed for the PBKDF2-HMAC-SHA256 steps of scrypt.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_hash.h"
+
+static uint32_t load_bigendian(const uint8_t * x)
+{
+    return ((uint32_t)(x[0]) << 24) | ((uint32_t)(x[1]) << 16) | ((uint32_t)(x[2]) << 8) | (uint32_t)(x[3]);
+}
+
+static void store_bigendian(uint8_t * x, uint32_t u)
+{
+    x[0] = (uint8_t)(u >> 24);
+    x[1] = (uint8_t)(u >> 16);
+    x[2] = (uint8_t)(u >> 8);
+    x[3] = (uint8_t)u;
+}
+
+static const uint32_t sha256_iv[8] =
+{
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+};
+
+static const uint32_t sha256_K[64] =
+{
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+    0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+    0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+    0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+    0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+    0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+    0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define SHA256_CH(x, y, z)  (((x) & (y)) ^ (~(x) & (z)))
+#define SHA256_MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA256_SIGMA0(x)    (ROTR32(x, 2) ^ ROTR32(x, 13) ^ ROTR32(x, 22))
+#define SHA256_SIGMA1(x)    (ROTR32(x, 6) ^ ROTR32(x, 11) ^ ROTR32(x, 25))
+#define SHA256_sigma0(x)    (ROTR32(x, 7) ^ ROTR32(x, 18) ^ ((x) >> 3))
+#define SHA256_sigma1(x)    (ROTR32(x, 17) ^ ROTR32(x, 19) ^ ((x) >> 10))
+
+void
+crypto_hashblocks_sha256(
+    uint32_t       state[8],
+    const uint8_t* in,
+    size_t         nblocks
+)
+{
+    uint32_t w[16];
+    uint32_t a, b, c, d, e, f, g, h;
+    int      i;
+
+    while (nblocks--)
+    {
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+        for (i = 0; i < 64; i++)
+        {
+            uint32_t t1, t2;
+
+            // The message schedule is kept in a ring buffer of 16 words.
+            if (i < 16)
+            {
+                w[i] = load_bigendian(in + 4 * i);
+            }
+            else
+            {
+                w[i & 15] += SHA256_sigma1(w[(i - 2) & 15]) + w[(i - 7) & 15] + SHA256_sigma0(w[(i - 15) & 15]);
+            }
+
+            t1 = h + SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + sha256_K[i] + w[i & 15];
+            t2 = SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c);
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        in += crypto_hash_sha256_BLOCKBYTES;
+    }
+}
+
+int
+crypto_hash_sha256_init(crypto_hash_sha256_state *state)
+{
+    memcpy(state->state, sha256_iv, sizeof(sha256_iv));
+    state->count = 0;
+    return 0;
+}
+
+int
+crypto_hash_sha256_update(crypto_hash_sha256_state *state,const uint8_t *in,unsigned long long inlen)
+{
+    size_t used = (size_t)(state->count % crypto_hash_sha256_BLOCKBYTES);
+
+    state->count += inlen;
+
+    if (used != 0)
+    {
+        size_t fill = crypto_hash_sha256_BLOCKBYTES - used;
+
+        if (inlen < fill)
+        {
+            memcpy(state->buffer + used, in, (size_t)inlen);
+            return 0;
+        }
+        memcpy(state->buffer + used, in, fill);
+        crypto_hashblocks_sha256(state->state, state->buffer, 1);
+        in += fill;
+        inlen -= fill;
+    }
+
+    if (inlen >= crypto_hash_sha256_BLOCKBYTES)
+    {
+        size_t nblocks = (size_t)(inlen / crypto_hash_sha256_BLOCKBYTES);
+
+        crypto_hashblocks_sha256(state->state, in, nblocks);
+        in += nblocks * crypto_hash_sha256_BLOCKBYTES;
+        inlen -= (unsigned long long)nblocks * crypto_hash_sha256_BLOCKBYTES;
+    }
+    memcpy(state->buffer, in, (size_t)inlen);
+    return 0;
+}
+
+int
+crypto_hash_sha256_final(crypto_hash_sha256_state *state,uint8_t *out)
+{
+    uint8_t block[2 * crypto_hash_sha256_BLOCKBYTES];
+    size_t  used = (size_t)(state->count % crypto_hash_sha256_BLOCKBYTES);
+    size_t  nblocks;
+    int     i;
+
+    // Padding: 0x80, zeros and the 64 bit big endian length in bits.
+    memcpy(block, state->buffer, used);
+    block[used++] = 0x80;
+    nblocks = (used > crypto_hash_sha256_BLOCKBYTES - 8) ? 2 : 1;
+    memset(block + used, 0, nblocks * crypto_hash_sha256_BLOCKBYTES - 8 - used);
+    store_bigendian(block + nblocks * crypto_hash_sha256_BLOCKBYTES - 8, (uint32_t)(state->count >> 29));
+    store_bigendian(block + nblocks * crypto_hash_sha256_BLOCKBYTES - 4, (uint32_t)(state->count << 3));
+
+    crypto_hashblocks_sha256(state->state, block, nblocks);
+    for (i = 0; i < 8; i++)
+    {
+        store_bigendian(out + 4 * i, state->state[i]);
+    }
+    memset(state, 0, sizeof(*state));
+    memset(block, 0, sizeof(block));
+    return 0;
+}
+
+int
+crypto_hash_sha256(uint8_t *out,const uint8_t *in,unsigned long long inlen)
+{
+    crypto_hash_sha256_state state;
+
+    crypto_hash_sha256_init(&state);
+    crypto_hash_sha256_update(&state, in, inlen);
+    return crypto_hash_sha256_final(&state, out);
+}
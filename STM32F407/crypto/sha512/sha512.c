@@ -0,0 +1,360 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file sha512.c
+
+    SHA-512 (FIPS 180-4). The compression function crypto_hashblocks_sha512
+    is in assembly on the Cortex M4 with CRYPTO_HAS_ASM_SHA512_CORE
+    (crypto/asm/cortex_m4_sha512_blocks.S).
+
+    crypto_hash_sha512_update_final_batch() compresses the blocks of four
+    independent messages at a time in the lanes of the AVX2 registers
+    (sha512_x4_avx2.c), including the padding blocks, as long as all four
+    messages have blocks left.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/sha512defs.h"
+
+static void store_bigendian(uint8_t * x, uint64_t u)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--)
+    {
+        x[i] = (uint8_t)u;
+        u >>= 8;
+    }
+}
+
+static const uint64_t sha512_iv[8] =
+{
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+const uint64_t g_sha512_K[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+#ifndef CRYPTO_HAS_ASM_SHA512_CORE
+
+static uint64_t load_bigendian(const uint8_t * x)
+{
+    return ((uint64_t)(x[0]) << 56) | ((uint64_t)(x[1]) << 48) | ((uint64_t)(x[2]) << 40) | ((uint64_t)(x[3]) << 32)
+         | ((uint64_t)(x[4]) << 24) | ((uint64_t)(x[5]) << 16) | ((uint64_t)(x[6]) << 8) | (uint64_t)(x[7]);
+}
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define SHA512_CH(x, y, z)  (((x) & (y)) ^ (~(x) & (z)))
+#define SHA512_MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA512_SIGMA0(x)    (ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define SHA512_SIGMA1(x)    (ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define SHA512_sigma0(x)    (ROTR64(x, 1) ^ ROTR64(x, 8) ^ ((x) >> 7))
+#define SHA512_sigma1(x)    (ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6))
+
+void
+crypto_hashblocks_sha512(
+    uint64_t       state[8],
+    const uint8_t* in,
+    size_t         nblocks
+)
+{
+    uint64_t w[16];
+    uint64_t a, b, c, d, e, f, g, h;
+    int      i;
+
+    while (nblocks--)
+    {
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+        for (i = 0; i < 80; i++)
+        {
+            uint64_t t1, t2;
+
+            // The message schedule is kept in a ring buffer of 16 words.
+            if (i < 16)
+            {
+                w[i] = load_bigendian(in + 8 * i);
+            }
+            else
+            {
+                w[i & 15] += SHA512_sigma1(w[(i - 2) & 15]) + w[(i - 7) & 15] + SHA512_sigma0(w[(i - 15) & 15]);
+            }
+
+            t1 = h + SHA512_SIGMA1(e) + SHA512_CH(e, f, g) + g_sha512_K[i] + w[i & 15];
+            t2 = SHA512_SIGMA0(a) + SHA512_MAJ(a, b, c);
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        in += crypto_hash_sha512_BLOCKBYTES;
+    }
+}
+
+#endif // #ifndef CRYPTO_HAS_ASM_SHA512_CORE
+
+int
+crypto_hash_sha512_init(crypto_hash_sha512_state *state)
+{
+    memcpy(state->state, sha512_iv, sizeof(sha512_iv));
+    state->count = 0;
+    return 0;
+}
+
+int
+crypto_hash_sha512_update(crypto_hash_sha512_state *state,const uint8_t *in,unsigned long long inlen)
+{
+    size_t used = (size_t)(state->count % crypto_hash_sha512_BLOCKBYTES);
+
+    state->count += inlen;
+
+    if (used != 0)
+    {
+        size_t fill = crypto_hash_sha512_BLOCKBYTES - used;
+
+        if (inlen < fill)
+        {
+            memcpy(state->buffer + used, in, (size_t)inlen);
+            return 0;
+        }
+        memcpy(state->buffer + used, in, fill);
+        crypto_hashblocks_sha512(state->state, state->buffer, 1);
+        in += fill;
+        inlen -= fill;
+    }
+
+    if (inlen >= crypto_hash_sha512_BLOCKBYTES)
+    {
+        size_t nblocks = (size_t)(inlen / crypto_hash_sha512_BLOCKBYTES);
+
+        crypto_hashblocks_sha512(state->state, in, nblocks);
+        in += nblocks * crypto_hash_sha512_BLOCKBYTES;
+        inlen -= (unsigned long long)nblocks * crypto_hash_sha512_BLOCKBYTES;
+    }
+    memcpy(state->buffer, in, (size_t)inlen);
+    return 0;
+}
+
+// Writes the remaining buffered bytes and the padding of state to block.
+// Returns the number of blocks, 1 or 2.
+static size_t
+sha512_pad(
+    const crypto_hash_sha512_state* state,
+    uint8_t                         block[2 * crypto_hash_sha512_BLOCKBYTES]
+)
+{
+    size_t used = (size_t)(state->count % crypto_hash_sha512_BLOCKBYTES);
+    size_t nblocks;
+
+    // Padding: 0x80, zeros and the 128 bit big endian length in bits.
+    memcpy(block, state->buffer, used);
+    block[used++] = 0x80;
+    nblocks = (used > crypto_hash_sha512_BLOCKBYTES - 16) ? 2 : 1;
+    memset(block + used, 0, nblocks * crypto_hash_sha512_BLOCKBYTES - 16 - used);
+    store_bigendian(block + nblocks * crypto_hash_sha512_BLOCKBYTES - 16, state->count >> 61);
+    store_bigendian(block + nblocks * crypto_hash_sha512_BLOCKBYTES - 8, state->count << 3);
+    return nblocks;
+}
+
+static void
+sha512_output(
+    crypto_hash_sha512_state* state,
+    uint8_t*                  out
+)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        store_bigendian(out + 8 * i, state->state[i]);
+    }
+    memset(state, 0, sizeof(*state));
+}
+
+int
+crypto_hash_sha512_final(crypto_hash_sha512_state *state,uint8_t *out)
+{
+    uint8_t block[2 * crypto_hash_sha512_BLOCKBYTES];
+    size_t  nblocks = sha512_pad(state, block);
+
+    crypto_hashblocks_sha512(state->state, block, nblocks);
+    sha512_output(state, out);
+    memset(block, 0, sizeof(block));
+    return 0;
+}
+
+#ifdef CRYPTO_HAS_AVX2
+
+// crypto_hash_sha512_update_final_batch() for four states.
+static void
+sha512_update_final_x4(
+    crypto_hash_sha512_state state[4],
+    uint8_t*                 out,
+    const uint8_t* const     in[4],
+    const unsigned long long inlen[4]
+)
+{
+    uint8_t            pad[4][2 * crypto_hash_sha512_BLOCKBYTES];
+    uint64_t*          lanes[4];
+    const uint8_t*     blocks[4];
+    const uint8_t*     m[4];
+    unsigned long long mlen[4];
+    size_t             nblocks[4];
+    int                k, full;
+
+    for (k = 0; k < 4; k++)
+    {
+        lanes[k] = state[k].state;
+        m[k] = in[k];
+        mlen[k] = inlen[k];
+    }
+
+    // Full blocks while all lanes have one, read from the buffer if bytes are
+    // pending there.
+    for (;;)
+    {
+        full = 1;
+        for (k = 0; k < 4; k++)
+        {
+            full &= (state[k].count % crypto_hash_sha512_BLOCKBYTES) + mlen[k] >= crypto_hash_sha512_BLOCKBYTES;
+        }
+        if (!full)
+        {
+            break;
+        }
+
+        for (k = 0; k < 4; k++)
+        {
+            size_t used = (size_t)(state[k].count % crypto_hash_sha512_BLOCKBYTES);
+            size_t fill = crypto_hash_sha512_BLOCKBYTES - used;
+
+            if (used == 0)
+            {
+                blocks[k] = m[k];
+            }
+            else
+            {
+                memcpy(state[k].buffer + used, m[k], fill);
+                blocks[k] = state[k].buffer;
+            }
+            state[k].count += fill;
+            m[k] += fill;
+            mlen[k] -= fill;
+        }
+        crypto_hashblocks_sha512_x4_avx2(lanes, blocks);
+    }
+
+    // Remaining full blocks of longer messages, then the padding blocks.
+    for (k = 0; k < 4; k++)
+    {
+        crypto_hash_sha512_update(&state[k], m[k], mlen[k]);
+        nblocks[k] = sha512_pad(&state[k], pad[k]);
+        blocks[k] = pad[k];
+    }
+    crypto_hashblocks_sha512_x4_avx2(lanes, blocks);
+
+    if ((nblocks[0] & nblocks[1] & nblocks[2] & nblocks[3]) == 2)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            blocks[k] = pad[k] + crypto_hash_sha512_BLOCKBYTES;
+        }
+        crypto_hashblocks_sha512_x4_avx2(lanes, blocks);
+    }
+    else
+    {
+        for (k = 0; k < 4; k++)
+        {
+            crypto_hashblocks_sha512(lanes[k], pad[k] + crypto_hash_sha512_BLOCKBYTES, nblocks[k] - 1);
+        }
+    }
+
+    for (k = 0; k < 4; k++)
+    {
+        sha512_output(&state[k], out + crypto_hash_sha512_BYTES * k);
+    }
+    memset(pad, 0, sizeof(pad));
+}
+
+#endif // #ifdef CRYPTO_HAS_AVX2
+
+int
+crypto_hash_sha512_update_final_batch(crypto_hash_sha512_state state[],uint8_t *out,
+                                      const uint8_t *const in[],const unsigned long long inlen[],size_t n)
+{
+    size_t i = 0;
+
+#ifdef CRYPTO_HAS_AVX2
+    if (crypto_cpu_has_avx2())
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            sha512_update_final_x4(&state[i], out + crypto_hash_sha512_BYTES * i, &in[i], &inlen[i]);
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        crypto_hash_sha512_update(&state[i], in[i], inlen[i]);
+        crypto_hash_sha512_final(&state[i], out + crypto_hash_sha512_BYTES * i);
+    }
+    return 0;
+}
+
+int
+crypto_hash_sha512_batch(uint8_t *out,const uint8_t *const in[],const unsigned long long inlen[],size_t n)
+{
+    crypto_hash_sha512_state state[4];
+    size_t                   i, k, lanes;
+
+    for (i = 0; i < n; i += lanes)
+    {
+        lanes = (n - i < 4) ? (n - i) : 4;
+        for (k = 0; k < lanes; k++)
+        {
+            crypto_hash_sha512_init(&state[k]);
+        }
+        crypto_hash_sha512_update_final_batch(state, out + crypto_hash_sha512_BYTES * i, &in[i], &inlen[i], lanes);
+    }
+    return 0;
+}
+
+int
+crypto_hash_sha512(uint8_t *out,const uint8_t *in,unsigned long long inlen)
+{
+    crypto_hash_sha512_state state;
+
+    crypto_hash_sha512_init(&state);
+    crypto_hash_sha512_update(&state, in, inlen);
+    return crypto_hash_sha512_final(&state, out);
+}
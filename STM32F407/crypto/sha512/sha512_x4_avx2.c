@@ -0,0 +1,112 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file sha512_x4_avx2.c
+
+    SHA-512 compression of four independent blocks in the four 64 bit lanes
+    of the AVX2 registers, i.e. word i of the four message schedules and
+    working variables reside in one vector. The rotations are composed of
+    two shifts, AVX2 has no 64 bit rotate. Compiled with function level
+    target attributes, the caller checks for AVX2 support at runtime.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+
+#include "../include/sha512defs.h"
+#include "../include/avx2defs.h"
+
+#ifdef CRYPTO_HAS_AVX2
+
+#define ADD(a, b) _mm256_add_epi64(a, b)
+#define XOR(a, b) _mm256_xor_si256(a, b)
+#define ROTR(a, n) _mm256_or_si256(_mm256_srli_epi64(a, n), _mm256_slli_epi64(a, 64 - (n)))
+
+#define SHA512_X4_CH(x, y, z)  XOR(z, _mm256_and_si256(x, XOR(y, z)))
+#define SHA512_X4_MAJ(x, y, z) XOR(y, _mm256_and_si256(XOR(x, y), XOR(y, z)))
+#define SHA512_X4_SIGMA0(x)    XOR(XOR(ROTR(x, 28), ROTR(x, 34)), ROTR(x, 39))
+#define SHA512_X4_SIGMA1(x)    XOR(XOR(ROTR(x, 14), ROTR(x, 18)), ROTR(x, 41))
+#define SHA512_X4_sigma0(x)    XOR(XOR(ROTR(x, 1), ROTR(x, 8)), _mm256_srli_epi64(x, 7))
+#define SHA512_X4_sigma1(x)    XOR(XOR(ROTR(x, 19), ROTR(x, 61)), _mm256_srli_epi64(x, 6))
+
+// Transposes the 4x4 words r[0 .. 3], i.e. word j of r[k] becomes word k of r[j].
+#define SHA512_X4_TRANSPOSE(r)                                  \
+    {                                                           \
+        __m256i t0 = _mm256_unpacklo_epi64(r[0], r[1]);         \
+        __m256i t1 = _mm256_unpackhi_epi64(r[0], r[1]);         \
+        __m256i t2 = _mm256_unpacklo_epi64(r[2], r[3]);         \
+        __m256i t3 = _mm256_unpackhi_epi64(r[2], r[3]);         \
+                                                                \
+        r[0] = _mm256_permute2x128_si256(t0, t2, 0x20);         \
+        r[1] = _mm256_permute2x128_si256(t1, t3, 0x20);         \
+        r[2] = _mm256_permute2x128_si256(t0, t2, 0x31);         \
+        r[3] = _mm256_permute2x128_si256(t1, t3, 0x31);         \
+    }
+
+AVX2_FUNCTION void
+crypto_hashblocks_sha512_x4_avx2(
+    uint64_t* const      state[4],
+    const uint8_t* const in[4]
+)
+{
+    const __m256i bswap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    __m256i       w[16];
+    __m256i       s[8];
+    __m256i       a, b, c, d, e, f, g, h;
+    int           i, k;
+
+    for (i = 0; i < 16; i += 4)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            w[i + k] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(in[k] + 8 * i)), bswap);
+        }
+        SHA512_X4_TRANSPOSE((&w[i]));
+    }
+    for (i = 0; i < 8; i += 4)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            s[i + k] = _mm256_loadu_si256((const __m256i*)(state[k] + i));
+        }
+        SHA512_X4_TRANSPOSE((&s[i]));
+    }
+
+    a = s[0]; b = s[1]; c = s[2]; d = s[3];
+    e = s[4]; f = s[5]; g = s[6]; h = s[7];
+
+    for (i = 0; i < 80; i++)
+    {
+        __m256i t1, t2;
+
+        // The message schedule is kept in a ring buffer of 16 words.
+        if (i >= 16)
+        {
+            w[i & 15] = ADD(ADD(w[i & 15], SHA512_X4_sigma1(w[(i - 2) & 15])),
+                            ADD(w[(i - 7) & 15], SHA512_X4_sigma0(w[(i - 15) & 15])));
+        }
+
+        t1 = ADD(ADD(h, SHA512_X4_SIGMA1(e)), ADD(SHA512_X4_CH(e, f, g), w[i & 15]));
+        t1 = ADD(t1, _mm256_set1_epi64x((long long)g_sha512_K[i]));
+        t2 = ADD(SHA512_X4_SIGMA0(a), SHA512_X4_MAJ(a, b, c));
+        h = g; g = f; f = e; e = ADD(d, t1);
+        d = c; c = b; b = a; a = ADD(t1, t2);
+    }
+
+    s[0] = ADD(s[0], a); s[1] = ADD(s[1], b); s[2] = ADD(s[2], c); s[3] = ADD(s[3], d);
+    s[4] = ADD(s[4], e); s[5] = ADD(s[5], f); s[6] = ADD(s[6], g); s[7] = ADD(s[7], h);
+
+    for (i = 0; i < 8; i += 4)
+    {
+        SHA512_X4_TRANSPOSE((&s[i]));
+        for (k = 0; k < 4; k++)
+        {
+            _mm256_storeu_si256((__m256i*)(state[k] + i), s[i + k]);
+        }
+    }
+}
+
+#endif // #ifdef CRYPTO_HAS_AVX2
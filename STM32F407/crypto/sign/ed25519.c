@@ -0,0 +1,187 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file ed25519.c
+
+    Ed25519 signatures (RFC 8032) on top of the fe25519, sc25519 and ge25519
+    arithmetic of this library. The structure follows the ref10 implementation
+    (Authors: D. J. Bernstein, N. Duif, T. Lange, P. Schwabe, B.-Y. Yang).
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_sign.h"
+#include "../include/crypto_hash.h"
+#include "../include/ge25519.h"
+#include "../include/randombytes.h"
+
+static void
+ed25519_wipe(
+    void*  p,
+    size_t n
+)
+{
+    volatile uint8_t* v = (volatile uint8_t*)p;
+
+    while (n--)
+    {
+        *v++ = 0;
+    }
+}
+
+// Clamped secret scalar a (az[0..31]) and the nonce prefix (az[32..63]).
+static void
+ed25519_expand_secret(
+    uint8_t       az[64],
+    const uint8_t seed[32]
+)
+{
+    crypto_hash_sha512(az, seed, 32);
+    az[0] &= 248;
+    az[31] &= 127;
+    az[31] |= 64;
+}
+
+int
+crypto_sign_ed25519_seed_keypair(uint8_t *pk,uint8_t *sk,const uint8_t *seed)
+{
+    uint8_t    az[64];
+    sc25519    a;
+    ge25519_p3 A;
+
+    ed25519_expand_secret(az, seed);
+    sc25519_from32bytes(&a, az);
+    ge25519_scalarmult_base(&A, &a);
+    ge25519_pack(pk, &A);
+
+    memmove(sk, seed, 32);
+    memmove(sk + 32, pk, 32);
+
+    ed25519_wipe(az, sizeof(az));
+    ed25519_wipe(&a, sizeof(a));
+    return 0;
+}
+
+int
+crypto_sign_ed25519_keypair(uint8_t *pk,uint8_t *sk)
+{
+    uint8_t seed[32];
+
+    randombytes(seed, sizeof(seed));
+    crypto_sign_ed25519_seed_keypair(pk, sk, seed);
+    ed25519_wipe(seed, sizeof(seed));
+    return 0;
+}
+
+int
+crypto_sign_ed25519_detached(uint8_t *sig,const uint8_t *m,unsigned long long mlen,const uint8_t *sk)
+{
+    crypto_hash_sha512_state hs;
+    uint8_t                  az[64];
+    uint8_t                  hash[64];
+    sc25519                  a;
+    sc25519                  r;
+    sc25519                  k;
+    ge25519_p3               R;
+
+    ed25519_expand_secret(az, sk);
+    sc25519_from32bytes(&a, az);
+
+    // r = H(prefix || m)
+    crypto_hash_sha512_init(&hs);
+    crypto_hash_sha512_update(&hs, az + 32, 32);
+    crypto_hash_sha512_update(&hs, m, mlen);
+    crypto_hash_sha512_final(&hs, hash);
+    sc25519_from64bytes(&r, hash);
+
+    ge25519_scalarmult_base(&R, &r);
+    ge25519_pack(sig, &R);
+
+    // k = H(R || A || m). m may overlap with sig + 64 but not with sig.
+    crypto_hash_sha512_init(&hs);
+    crypto_hash_sha512_update(&hs, sig, 32);
+    crypto_hash_sha512_update(&hs, sk + 32, 32);
+    crypto_hash_sha512_update(&hs, m, mlen);
+    crypto_hash_sha512_final(&hs, hash);
+    sc25519_from64bytes(&k, hash);
+
+    // S = r + k * a
+    sc25519_muladd(&k, &k, &a, &r);
+    sc25519_to32bytes(sig + 32, &k);
+
+    ed25519_wipe(az, sizeof(az));
+    ed25519_wipe(&a, sizeof(a));
+    ed25519_wipe(&r, sizeof(r));
+    return 0;
+}
+
+int
+crypto_sign_ed25519_verify_detached(const uint8_t *sig,const uint8_t *m,unsigned long long mlen,const uint8_t *pk)
+{
+    crypto_hash_sha512_state hs;
+    uint8_t                  hash[64];
+    sc25519                  k;
+    sc25519                  s;
+    ge25519_p3               minusA;
+    ge25519_p3               minusR;
+    ge25519_p3               R;
+    ge25519_cached           c;
+    ge25519_p1p1             t;
+
+    if (!sc25519_is_canonical_vartime(sig + 32))
+    {
+        return -1;
+    }
+    if ((ge25519_unpackneg_vartime(&minusA, pk) != 0) ||
+        (ge25519_unpackneg_vartime(&minusR, sig) != 0))
+    {
+        return -1;
+    }
+
+    crypto_hash_sha512_init(&hs);
+    crypto_hash_sha512_update(&hs, sig, 32);
+    crypto_hash_sha512_update(&hs, pk, 32);
+    crypto_hash_sha512_update(&hs, m, mlen);
+    crypto_hash_sha512_final(&hs, hash);
+    sc25519_from64bytes(&k, hash);
+    sc25519_from32bytes(&s, sig + 32);
+
+    // 8 (S * B - k * A - R) == 0, the cofactored equation of RFC 8032 that
+    // crypto_sign_ed25519_verify_batch() checks as well.
+    ge25519_double_scalarmult_vartime(&R, &minusA, &k, &s);
+    ge25519_p3_to_cached(&c, &minusR);
+    ge25519_add_p1p1(&t, &R, &c);
+    ge25519_p1p1_to_p3(&R, &t);
+
+    return ge25519_is_small_order_vartime(&R) ? 0 : -1;
+}
+
+int
+crypto_sign_ed25519(uint8_t *sm,unsigned long long *smlen,const uint8_t *m,unsigned long long mlen,const uint8_t *sk)
+{
+    memmove(sm + crypto_sign_ed25519_BYTES, m, (size_t)mlen);
+    crypto_sign_ed25519_detached(sm, sm + crypto_sign_ed25519_BYTES, mlen, sk);
+    *smlen = mlen + crypto_sign_ed25519_BYTES;
+    return 0;
+}
+
+int
+crypto_sign_ed25519_open(uint8_t *m,unsigned long long *mlen,const uint8_t *sm,unsigned long long smlen,const uint8_t *pk)
+{
+    *mlen = 0;
+    if (smlen < crypto_sign_ed25519_BYTES)
+    {
+        return -1;
+    }
+    if (crypto_sign_ed25519_verify_detached(sm, sm + crypto_sign_ed25519_BYTES,
+                                            smlen - crypto_sign_ed25519_BYTES, pk) != 0)
+    {
+        return -1;
+    }
+    memmove(m, sm + crypto_sign_ed25519_BYTES, (size_t)(smlen - crypto_sign_ed25519_BYTES));
+    *mlen = smlen - crypto_sign_ed25519_BYTES;
+    return 0;
+}
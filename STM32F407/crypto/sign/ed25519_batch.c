@@ -0,0 +1,146 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file ed25519_batch.c
+
+    Batch verification of Ed25519 signatures with one multi-scalar
+    multiplication per chunk of CRYPTO_SIGN_ED25519_BATCH_CHUNK signatures.
+    The hashes H(R || A || m) are computed four at a time with
+    crypto_hash_sha512_update_final_batch().
+
+    The combined equation is multiplied by the cofactor 8, as is the equation
+    of crypto_sign_ed25519_verify_detached(). Signatures with small order
+    components in R or A are therefore treated the same way by both.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/crypto_sign.h"
+#include "../include/crypto_hash.h"
+#include "../include/ge25519.h"
+#include "../include/randombytes.h"
+
+// Computes the scalars of the combined equation for the count signatures
+// idx[0 .. count-1], whose points -R_i, -A_i are stored in points[2 i], points[2 i + 1],
+// and returns 0 if the equation multiplied by the cofactor holds.
+static int
+ed25519_verify_chunk(
+    const uint8_t *const     sig[],
+    const uint8_t *const     m[],
+    const unsigned long long mlen[],
+    const uint8_t *const     pk[],
+    const size_t             idx[],
+    size_t                   count,
+    ge25519_p3               points[],
+    sc25519                  scalars[],
+    ge25519_cached           scratch[]
+)
+{
+    crypto_hash_sha512_state hs[4];
+    uint8_t                  hash[4][64];
+    const uint8_t*           msg[4];
+    unsigned long long       msglen[4];
+    sc25519                  sumS;
+    sc25519                  t;
+    ge25519_p3               r;
+    size_t                   i, j, lanes;
+
+    memset(&sumS, 0, sizeof(sumS));
+
+    for (i = 0; i < count; i += lanes)
+    {
+        // k_i = H(R || A || m) for up to four signatures at once.
+        lanes = (count - i < 4) ? (count - i) : 4;
+        for (j = 0; j < lanes; j++)
+        {
+            size_t k = idx[i + j];
+
+            crypto_hash_sha512_init(&hs[j]);
+            crypto_hash_sha512_update(&hs[j], sig[k], 32);
+            crypto_hash_sha512_update(&hs[j], pk[k], 32);
+            msg[j] = m[k];
+            msglen[j] = mlen[k];
+        }
+        crypto_hash_sha512_update_final_batch(hs, hash[0], msg, msglen, lanes);
+
+        for (j = 0; j < lanes; j++)
+        {
+            size_t   k = idx[i + j];
+            sc25519* z = &scalars[2 * (i + j)];
+
+            // z_i: 128 random bits.
+            memset(z, 0, sizeof(*z));
+            randombytes(z->as_uint8_t, 16);
+
+            // z_i * k_i
+            sc25519_from64bytes(&t, hash[j]);
+            sc25519_mul(&scalars[2 * (i + j) + 1], &t, z);
+
+            // sum z_i * S_i
+            sc25519_from32bytes(&t, sig[k] + 32);
+            sc25519_muladd(&sumS, &t, z, &sumS);
+        }
+    }
+
+    // 8 (-sum z_i (R_i + k_i A_i) + (sum z_i S_i) B) == 0
+    ge25519_setbase(&points[2 * count]);
+    scalars[2 * count] = sumS;
+
+    ge25519_multi_scalarmult_vartime(&r, points, scalars, 2 * count + 1, scratch);
+    return ge25519_is_small_order_vartime(&r) ? 0 : -1;
+}
+
+int
+crypto_sign_ed25519_verify_batch(const uint8_t *const sig[],const uint8_t *const m[],const unsigned long long mlen[],
+                                 const uint8_t *const pk[],size_t n,int valid[])
+{
+    ge25519_p3     points[2 * CRYPTO_SIGN_ED25519_BATCH_CHUNK + 1];
+    sc25519        scalars[2 * CRYPTO_SIGN_ED25519_BATCH_CHUNK + 1];
+    ge25519_cached scratch[2 * CRYPTO_SIGN_ED25519_BATCH_CHUNK + 1];
+    size_t         idx[CRYPTO_SIGN_ED25519_BATCH_CHUNK];
+    size_t         start = 0;
+    int            result = 0;
+
+    while (start < n)
+    {
+        size_t count = 0;
+        size_t i;
+
+        // Signatures with a non-canonical S or undecodable points are
+        // invalid for the single verification as well.
+        for (i = start; (i < n) && (count < CRYPTO_SIGN_ED25519_BATCH_CHUNK); i++)
+        {
+            valid[i] = sc25519_is_canonical_vartime(sig[i] + 32) &&
+                       (ge25519_unpackneg_vartime(&points[2 * count], sig[i]) == 0) &&
+                       (ge25519_unpackneg_vartime(&points[2 * count + 1], pk[i]) == 0);
+            if (valid[i])
+            {
+                idx[count++] = i;
+            }
+            else
+            {
+                result = -1;
+            }
+        }
+        start = i;
+
+        if ((count > 0) &&
+            (ed25519_verify_chunk(sig, m, mlen, pk, idx, count, points, scalars, scratch) != 0))
+        {
+            for (i = 0; i < count; i++)
+            {
+                size_t k = idx[i];
+
+                if (crypto_sign_ed25519_verify_detached(sig[k], m[k], mlen[k], pk[k]) != 0)
+                {
+                    valid[k] = 0;
+                    result = -1;
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -1,34 +1,51 @@
 // 
 // randombytes implementation for STM32F407 hardware
 //
+// The output comes from the generator of randombytes_drbg.c, which is seeded
+// from the TRNG on the first call and reseeded every
+// RANDOMBYTES_DRBG_RESEED_INTERVAL refills. Only then the caller waits for
+// the TRNG, which delivers one word per 40 cycles of its clock.
+//
+
+#include <stdint.h>
+#include <string.h>
+#include <libopencm3/stm32/rng.h>
+#include "../include/randombytes.h"
+
+static randombytes_drbg g_drbg;
+static int              g_seeded = 0;
+
+static void
+randombytes_trng(uint8_t *seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < randombytes_drbg_SEEDBYTES; i += 4)
+    {
+        uint32_t random = rng_get_random_blocking();
+
+        memcpy(seed + i, &random, 4);
+    }
+}
+
+void randombytes(unsigned char *x,unsigned long long xlen)
+{
+    if (!g_seeded || randombytes_drbg_reseed_due(&g_drbg))
+    {
+        uint8_t seed[randombytes_drbg_SEEDBYTES];
+
+        randombytes_trng(seed);
+        if (g_seeded)
+        {
+            randombytes_drbg_reseed(&g_drbg, seed);
+        }
+        else
+        {
+            randombytes_drbg_init(&g_drbg, seed);
+            g_seeded = 1;
+        }
+        memset(seed, 0, sizeof(seed));
+    }
 
-#include <stdint.h>
-#include <libopencm3/stm32/rng.h>
-#include "../include/randombytes.h"
-
-
-void randombytes(unsigned char *x,unsigned long long xlen)
-{
-    union
-    {
-        unsigned char aschar[4];
-        uint32_t asint;
-    } random;
-
-    while (xlen > 4)
-    {
-        random.asint = rng_get_random_blocking();
-        *x++ = random.aschar[0];
-        *x++ = random.aschar[1];
-        *x++ = random.aschar[2];
-        *x++ = random.aschar[3];
-        xlen -= 4;
-    }
-    if (xlen > 0)
-    {
-        for (random.asint = rng_get_random_blocking(); xlen > 0; --xlen)
-        {
-            *x++ = random.aschar[xlen - 1];
-        }
-    }
+    randombytes_drbg_generate(&g_drbg, x, xlen);
 }
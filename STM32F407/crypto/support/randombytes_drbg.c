@@ -0,0 +1,94 @@
+/*                          =======================
+  ============================ C/C++ HEADER FILE =============================
+                            =======================
+
+    \file randombytes_drbg.c
+
+    Fast-key-erasure random number generator on crypto_core_salsa20. A
+    refill computes the Salsa20 blocks 0, 1, ... of the zero nonce under the
+    current key, the first 32 bytes become the next key and the remaining
+    bytes are returned. Returned bytes are erased from the buffer, so a later
+    compromise of the state does not reveal output that was already handed
+    out.
+
+    \Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG
+
+    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+  ============================================================================*/
+#include <string.h>
+#include "../include/randombytes.h"
+#include "../include/crypto_stream.h"
+
+#if (RANDOMBYTES_DRBG_BUFFERBYTES % 64) || (RANDOMBYTES_DRBG_BUFFERBYTES < 128)
+#error "RANDOMBYTES_DRBG_BUFFERBYTES shall be a multiple of 64 and at least 128"
+#endif
+
+static void
+randombytes_drbg_refill(randombytes_drbg *drbg)
+{
+    static const uint8_t zero_nonce[crypto_stream_salsa20_NONCEBYTES] = { 0 };
+
+    // Blocks 0, 1, ... of crypto_core_salsa20, with the multi-block kernels on
+    // hosts.
+    crypto_stream_salsa20(drbg->buffer, RANDOMBYTES_DRBG_BUFFERBYTES, zero_nonce, drbg->key);
+
+    memcpy(drbg->key, drbg->buffer, sizeof(drbg->key));
+    memset(drbg->buffer, 0, sizeof(drbg->key));
+    drbg->position = sizeof(drbg->key);
+    drbg->refills++;
+}
+
+void
+randombytes_drbg_init(randombytes_drbg *drbg, const uint8_t *seed)
+{
+    memset(drbg->key, 0, sizeof(drbg->key));
+    randombytes_drbg_reseed(drbg, seed);
+}
+
+void
+randombytes_drbg_reseed(randombytes_drbg *drbg, const uint8_t *seed)
+{
+    uint32_t i;
+
+    // The refill below passes the combined key through Salsa20, such that
+    // the next key is unpredictable if either the old key or seed is.
+    for (i = 0; i < sizeof(drbg->key); i++)
+    {
+        drbg->key[i] ^= seed[i];
+    }
+    memset(drbg->buffer, 0, sizeof(drbg->buffer));
+    drbg->position = RANDOMBYTES_DRBG_BUFFERBYTES;
+    drbg->refills = 0;
+}
+
+int
+randombytes_drbg_reseed_due(const randombytes_drbg *drbg)
+{
+    return drbg->refills >= RANDOMBYTES_DRBG_RESEED_INTERVAL;
+}
+
+void
+randombytes_drbg_generate(randombytes_drbg *drbg, uint8_t *x, unsigned long long xlen)
+{
+    while (xlen > 0)
+    {
+        uint32_t len;
+
+        if (drbg->position == RANDOMBYTES_DRBG_BUFFERBYTES)
+        {
+            randombytes_drbg_refill(drbg);
+        }
+
+        len = RANDOMBYTES_DRBG_BUFFERBYTES - drbg->position;
+        if (len > xlen)
+        {
+            len = (uint32_t)xlen;
+        }
+
+        memcpy(x, drbg->buffer + drbg->position, len);
+        memset(drbg->buffer + drbg->position, 0, len);
+        drbg->position += len;
+        x += len;
+        xlen -= len;
+    }
+}
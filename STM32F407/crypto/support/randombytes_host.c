@@ -0,0 +1,81 @@
+// 
+// randombytes implementation for Linux hosts using the getrandom system call
+//
+// getrandom() only seeds the generator of randombytes_drbg.c. Each thread has
+// its own generator. A child process after fork() reseeds its copy before the
+// first use, such that parent and child do not return the same bytes.
+//
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/random.h>
+#include "../include/randombytes.h"
+
+static __thread randombytes_drbg g_drbg;
+static __thread int              g_seeded = 0;
+static __thread int              g_forked = 0;
+static pthread_once_t            g_atforkOnce = PTHREAD_ONCE_INIT;
+
+// Runs in the only thread of the child, i.e. the one that called fork().
+static void
+randombytes_atfork_child(void)
+{
+    g_forked = 1;
+}
+
+static void
+randombytes_register_atfork(void)
+{
+    if (pthread_atfork(NULL, NULL, randombytes_atfork_child) != 0)
+    {
+        abort();
+    }
+}
+
+static void
+randombytes_getrandom(unsigned char *x,unsigned long long xlen)
+{
+    while (xlen > 0)
+    {
+        size_t  chunk = (xlen > 256) ? 256 : (size_t)xlen;
+        ssize_t ret = getrandom(x, chunk, 0);
+
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // There is no way to report an error to the caller.
+            abort();
+        }
+        x += ret;
+        xlen -= (unsigned long long)ret;
+    }
+}
+
+void randombytes(unsigned char *x,unsigned long long xlen)
+{
+    if (!g_seeded || g_forked || randombytes_drbg_reseed_due(&g_drbg))
+    {
+        uint8_t seed[randombytes_drbg_SEEDBYTES];
+
+        pthread_once(&g_atforkOnce, randombytes_register_atfork);
+        randombytes_getrandom(seed, sizeof(seed));
+        if (g_seeded)
+        {
+            randombytes_drbg_reseed(&g_drbg, seed);
+        }
+        else
+        {
+            randombytes_drbg_init(&g_drbg, seed);
+            g_seeded = 1;
+        }
+        g_forked = 0;
+        memset(seed, 0, sizeof(seed));
+    }
+
+    randombytes_drbg_generate(&g_drbg, x, xlen);
+}
@@ -0,0 +1,828 @@
+//
+// Host benchmark, counterpart of the cycle count measurement in main.c.
+//
+// Every primitive is measured in SAMPLES samples, each timing a batch of calls.
+// Median and quartiles of the cycles per call (or per byte) are printed as JSON:
+//
+//   { "backend": "x86-64", "counter": "rdtsc", "config": [...], "results": [
+//     { "name": "fe25519_mul", "unit": "cycles/call", "median": 97, "q1": 96, "q3": 98, ... }, ... ] }
+//
+// Cycle counters: rdtsc on x86-64, cntvct_el0 on AArch64. "--perf" uses the
+// core cycle counter of perf_event_open instead (Linux), which is not affected
+// by frequency scaling. If no counter is available, nanoseconds are reported.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "../crypto/include/crypto_hash.h"
+#include "../crypto/include/crypto_hash_to_curve.h"
+#include "../crypto/include/crypto_onetimeauth.h"
+#include "../crypto/include/crypto_pake.h"
+#include "../crypto/include/crypto_pwhash.h"
+#include "../crypto/include/crypto_scalarmult.h"
+#include "../crypto/include/crypto_secretbox.h"
+#include "../crypto/include/crypto_sign.h"
+#include "../crypto/include/crypto_stream.h"
+#include "../crypto/include/fe25519.h"
+#include "../crypto/include/sc25519.h"
+#include "../crypto/include/randombytes.h"
+
+#ifndef CRYPTO_BENCHMARK_BACKEND
+#define CRYPTO_BENCHMARK_BACKEND "unknown"
+#endif
+
+#define SAMPLES 101
+#define SALSA20_BENCHMARK_BYTES 4096
+#define SALSA20_BENCHMARK_CHUNK 1024
+#define SHA512_BENCHMARK_BYTES 4096
+#define SHA512_SHORT_BYTES 96
+#define SIGN_BENCHMARK_BYTES 64
+#define BATCH_SIZE 16
+#define VERIFY_BATCH_SIZE 64
+#define SCRYPT_N 1024
+#define SCRYPT_R 8
+#define SCRYPT_P 4
+
+typedef enum
+{
+    COUNTER_NS,
+    COUNTER_TSC,
+    COUNTER_PERF
+} EN_counter;
+
+static EN_counter g_counter = COUNTER_NS;
+static int        g_perfFd = -1;
+
+static uint64_t
+read_counter(void)
+{
+#ifdef __linux__
+    if (g_counter == COUNTER_PERF)
+    {
+        uint64_t value = 0;
+
+        if (read(g_perfFd, &value, sizeof(value)) != sizeof(value))
+        {
+            return 0;
+        }
+        return value;
+    }
+#endif
+    if (g_counter == COUNTER_TSC)
+    {
+#if defined(__x86_64__)
+        uint32_t lo, hi;
+
+        __asm__ __volatile__ ("lfence\n\trdtsc" : "=a" (lo), "=d" (hi) : : "memory");
+        return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+        uint64_t value;
+
+        __asm__ __volatile__ ("isb\n\tmrs %0, cntvct_el0" : "=r" (value) : : "memory");
+        return value;
+#endif
+    }
+    {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    }
+}
+
+static const char*
+counter_name(void)
+{
+    switch (g_counter)
+    {
+    case COUNTER_PERF:
+        return "perf_event_open";
+    case COUNTER_TSC:
+#if defined(__aarch64__)
+        return "cntvct_el0";
+#else
+        return "rdtsc";
+#endif
+    default:
+        return "clock_gettime_ns";
+    }
+}
+
+// cntvct_el0 runs at a fixed frequency below the core clock.
+static const char*
+counter_unit(void)
+{
+    switch (g_counter)
+    {
+    case COUNTER_PERF:
+        return "cycles";
+    case COUNTER_TSC:
+#if defined(__aarch64__)
+        return "ticks";
+#else
+        return "cycles";
+#endif
+    default:
+        return "ns";
+    }
+}
+
+static void
+select_counter(
+    int usePerf
+)
+{
+#if defined(__x86_64__) || defined(__aarch64__)
+    g_counter = COUNTER_TSC;
+#endif
+
+#ifdef __linux__
+    if (usePerf)
+    {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        g_perfFd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (g_perfFd >= 0)
+        {
+            ioctl(g_perfFd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(g_perfFd, PERF_EVENT_IOC_ENABLE, 0);
+            g_counter = COUNTER_PERF;
+        }
+        else
+        {
+            fprintf(stderr, "perf_event_open failed, using %s\n", counter_name());
+        }
+    }
+#else
+    (void)usePerf;
+#endif
+}
+
+static int
+compare_double(
+    const void* a,
+    const void* b
+)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+typedef void (*FN_benchmark)(unsigned int iterations);
+
+static int g_firstResult = 1;
+
+// Sorts the samples and prints median and quartiles.
+static void
+print_result(
+    const char*  name,
+    const char*  unit,
+    double       samples[SAMPLES],
+    unsigned int iterations
+)
+{
+    qsort(samples, SAMPLES, sizeof(double), compare_double);
+
+    printf("%s    { \"name\": \"%s\", \"unit\": \"%s/%s\", \"median\": %.1f, \"q1\": %.1f, \"q3\": %.1f, "
+           "\"samples\": %d, \"iterations\": %u }",
+           g_firstResult ? "" : ",\n", name, counter_unit(), unit,
+           samples[SAMPLES / 2], samples[SAMPLES / 4], samples[(3 * SAMPLES) / 4],
+           SAMPLES, iterations);
+    g_firstResult = 0;
+}
+
+// Calls fn(iterations) SAMPLES times and reports the counter difference divided by divisor.
+static void
+run_benchmark(
+    const char*  name,
+    const char*  unit,
+    FN_benchmark fn,
+    unsigned int iterations,
+    double       divisor
+)
+{
+    double samples[SAMPLES];
+    int    i;
+
+    // Warm up caches and branch predictors.
+    fn(iterations);
+
+    for (i = 0; i < SAMPLES; i++)
+    {
+        uint64_t start = read_counter();
+
+        fn(iterations);
+        samples[i] = (double)(read_counter() - start) / divisor;
+    }
+    print_result(name, unit, samples, iterations);
+}
+
+static fe25519        g_fe[4];
+static fe25519        g_feBatch[BATCH_SIZE];
+static sc25519        g_sc[3];
+static sc25519_mont   g_scMont[2];
+static UN_512bitValue g_wide;
+static uint8_t        g_sk[BATCH_SIZE][32];
+static uint8_t        g_pk[BATCH_SIZE][32];
+static uint8_t        g_ss[BATCH_SIZE][32];
+static uint8_t        g_stream[SALSA20_BENCHMARK_BYTES];
+static uint8_t        g_hash[crypto_hash_sha512_BYTES];
+static uint8_t        g_signPk[crypto_sign_ed25519_PUBLICKEYBYTES];
+static uint8_t        g_signSk[crypto_sign_ed25519_SECRETKEYBYTES];
+static uint8_t        g_signature[crypto_sign_ed25519_BYTES];
+static const uint8_t* g_batchSig[VERIFY_BATCH_SIZE];
+static const uint8_t* g_batchM[VERIFY_BATCH_SIZE];
+static unsigned long long g_batchMlen[VERIFY_BATCH_SIZE];
+static const uint8_t* g_batchPk[VERIFY_BATCH_SIZE];
+static int            g_batchValid[VERIFY_BATCH_SIZE];
+
+static void
+bench_fe25519_mul(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_mul(&g_fe[0], &g_fe[0], &g_fe[1]);
+    }
+}
+
+static void
+bench_fe25519_square(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_square(&g_fe[0], &g_fe[0]);
+    }
+}
+
+static void
+bench_fe25519_invert(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_invert(&g_fe[0], &g_fe[0]);
+    }
+}
+
+static void
+bench_fe25519_pow2523(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_pow2523(&g_fe[0], &g_fe[0]);
+    }
+}
+
+static void
+bench_fe25519_elligator2(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_elligator2(&g_fe[2], &g_fe[0]);
+        fe25519_add(&g_fe[0], &g_fe[0], &g_fe[2]);
+    }
+}
+
+static void
+bench_fe25519_elligator2x(unsigned int iterations)
+{
+    fe25519 t[5];
+
+    while (iterations--)
+    {
+        fe25519_elligator2x_useProvidedScratchBuffers(&g_fe[2], &g_fe[0], &t[0], &t[1], &t[2], &t[3], &t[4]);
+        fe25519_add(&g_fe[0], &g_fe[0], &g_fe[2]);
+    }
+}
+
+static void
+bench_fe25519_elligator2_batch(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        fe25519_elligator2_batch(g_feBatch, g_feBatch, BATCH_SIZE);
+    }
+}
+
+static const uint8_t g_h2cDst[] = "benchmark-with-curve25519_XMD:SHA-512_ELL2_RO_";
+
+static void
+bench_hash_to_curve(unsigned int iterations)
+{
+    uint8_t u[32], v[32];
+
+    while (iterations--)
+    {
+        crypto_hash_to_curve_curve25519(u, v, g_stream, 32, g_h2cDst, sizeof(g_h2cDst) - 1);
+    }
+}
+
+static void
+bench_encode_to_curve(unsigned int iterations)
+{
+    uint8_t u[32], v[32];
+
+    while (iterations--)
+    {
+        crypto_encode_to_curve_curve25519(u, v, g_stream, 32, g_h2cDst, sizeof(g_h2cDst) - 1);
+    }
+}
+
+static void
+bench_sc25519_mul(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        sc25519_mul(&g_sc[0], &g_sc[0], &g_sc[1]);
+    }
+}
+
+// S = r + k * a as composed calls and fused.
+static void
+bench_sc25519_mul_add(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        sc25519_mul(&g_sc[2], &g_sc[0], &g_sc[1]);
+        sc25519_add(&g_sc[0], &g_sc[2], &g_sc[1]);
+    }
+}
+
+static void
+bench_sc25519_muladd(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        sc25519_muladd(&g_sc[0], &g_sc[0], &g_sc[1], &g_sc[1]);
+    }
+}
+
+static void
+bench_sc25519_mont_mul(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        sc25519_mont_mul(&g_scMont[0], &g_scMont[0], &g_scMont[1]);
+    }
+}
+
+static void
+bench_sc25519_reduce(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        g_wide.as_uint32_t[15] ^= iterations;
+        sc25519_reduce(&g_wide);
+    }
+}
+
+static void
+bench_sc25519_invert(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        sc25519_invert(&g_sc[0], &g_sc[0]);
+    }
+}
+
+static void
+bench_salsa20(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_stream_salsa20_xor(g_stream, g_stream, sizeof(g_stream), g_sk[1], g_sk[0]);
+    }
+}
+
+static void
+bench_chacha20(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_stream_chacha20_ietf_xor(g_stream, g_stream, sizeof(g_stream), g_sk[1], g_sk[0]);
+    }
+}
+
+static void
+bench_salsa20_chunked(unsigned int iterations)
+{
+    salsa20_xor_chunked context;
+    unsigned int        i;
+
+    crypto_stream_salsa20_xor_chunked_init(&context, g_sk[1], g_sk[0]);
+    while (iterations--)
+    {
+        for (i = 0; i < sizeof(g_stream); i += SALSA20_BENCHMARK_CHUNK)
+        {
+            crypto_stream_salsa20_xor_chunked(&context, g_stream + i, g_stream + i, SALSA20_BENCHMARK_CHUNK);
+        }
+    }
+}
+
+static void
+bench_poly1305(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_onetimeauth_poly1305(g_sk[1], g_stream, sizeof(g_stream), g_sk[0]);
+    }
+}
+
+static void
+bench_secretbox(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_secretbox_xsalsa20poly1305(g_stream, g_stream, sizeof(g_stream), g_sk[1], g_sk[0]);
+    }
+}
+
+static void
+bench_sha512(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_hash_sha512(g_hash, g_stream, SHA512_BENCHMARK_BYTES);
+    }
+}
+
+// Messages of the size of R || A || m in the Ed25519 batch verification.
+static void
+bench_sha512_short(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_hash_sha512(g_hash, g_stream, SHA512_SHORT_BYTES);
+    }
+}
+
+static void
+bench_sha512_batch(unsigned int iterations)
+{
+    static uint8_t     digests[BATCH_SIZE][64];
+    const uint8_t*     in[BATCH_SIZE];
+    unsigned long long inlen[BATCH_SIZE];
+    int                i;
+
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        in[i] = g_stream + SHA512_SHORT_BYTES * i;
+        inlen[i] = SHA512_SHORT_BYTES;
+    }
+    while (iterations--)
+    {
+        crypto_hash_sha512_batch(digests[0], in, inlen, BATCH_SIZE);
+    }
+}
+
+static void
+bench_sign(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_sign_ed25519_detached(g_signature, g_stream, SIGN_BENCHMARK_BYTES, g_signSk);
+    }
+}
+
+static void
+bench_verify(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        if (crypto_sign_ed25519_verify_detached(g_signature, g_stream, SIGN_BENCHMARK_BYTES, g_signPk) != 0)
+        {
+            fprintf(stderr, "signature verification failed\n");
+            exit(1);
+        }
+    }
+}
+
+static void
+bench_verify_batch(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        if (crypto_sign_ed25519_verify_batch(g_batchSig, g_batchM, g_batchMlen, g_batchPk,
+                                             VERIFY_BATCH_SIZE, g_batchValid) != 0)
+        {
+            fprintf(stderr, "batch signature verification failed\n");
+            exit(1);
+        }
+    }
+}
+
+static void
+bench_scalarmult(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_scalarmult_curve25519(g_ss[0], g_sk[0], g_pk[0]);
+    }
+}
+
+static void
+bench_randombytes(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        randombytes(g_sk[0], sizeof(g_sk[0]));
+    }
+}
+
+static void
+bench_scalarmult_base(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_scalarmult_base_curve25519(g_ss[0], g_sk[0]);
+    }
+}
+
+static void
+bench_scalarmult_batch(unsigned int iterations)
+{
+    while (iterations--)
+    {
+        crypto_scalarmult_curve25519_batch(g_ss, (const uint8_t (*)[32])g_sk, (const uint8_t (*)[32])g_pk, BATCH_SIZE);
+    }
+}
+
+static uint8_t* g_scryptMemory;
+static size_t   g_scryptMemorySize;
+
+static void
+bench_scrypt(unsigned int threads, unsigned int iterations)
+{
+    uint8_t w[32];
+
+    while (iterations--)
+    {
+        crypto_pwhash_scryptsalsa208sha256_ll(g_stream, 16, g_hash, 16, SCRYPT_N, SCRYPT_R, SCRYPT_P, w, sizeof(w),
+                                              g_scryptMemory, g_scryptMemorySize, threads);
+    }
+}
+
+static void
+bench_scrypt_1thread(unsigned int iterations)
+{
+    bench_scrypt(1, iterations);
+}
+
+static void
+bench_scrypt_pthreads(unsigned int iterations)
+{
+    bench_scrypt(SCRYPT_P, iterations);
+}
+
+static uint8_t           g_pakeMemory[crypto_pake_ARENABYTES(2)];
+static crypto_pake_arena g_pakeArena;
+static const uint8_t     g_pakeCi[] = "benchmark-client-server";
+
+// Both sides of one CPace or, with g_sk[0] as w and g_pk[0] as W, AuCPace
+// handshake. The sessions stay open for the phase timings until the next call.
+static void
+pake_handshake(
+    int                    augmented,
+    crypto_cpace_session** client,
+    crypto_cpace_session** server
+)
+{
+    uint8_t X[crypto_cpace_BYTES], Ya[crypto_cpace_BYTES], Yb[crypto_cpace_BYTES];
+    uint8_t isk[crypto_cpace_ISKBYTES];
+
+    crypto_pake_arena_init(&g_pakeArena, g_pakeMemory, sizeof(g_pakeMemory), read_counter);
+    *client = crypto_pake_session_open(&g_pakeArena, crypto_cpace_INITIATOR);
+    *server = crypto_pake_session_open(&g_pakeArena, crypto_cpace_RESPONDER);
+
+    if (augmented)
+    {
+        crypto_aucpace_server_augment(*server, X, g_pk[0]);
+        crypto_aucpace_client_augment(*client, g_sk[0], X);
+        crypto_aucpace_generator(*client, g_pakeCi, sizeof(g_pakeCi) - 1, g_hash, 16);
+        crypto_aucpace_generator(*server, g_pakeCi, sizeof(g_pakeCi) - 1, g_hash, 16);
+    }
+    else
+    {
+        crypto_cpace_generator(*client, g_sk[1], 32, g_pakeCi, sizeof(g_pakeCi) - 1, g_hash, 16);
+        crypto_cpace_generator(*server, g_sk[1], 32, g_pakeCi, sizeof(g_pakeCi) - 1, g_hash, 16);
+    }
+    crypto_cpace_share(*client, Ya);
+    crypto_cpace_share(*server, Yb);
+    crypto_cpace_finish(*client, isk, Yb, NULL, 0, NULL, 0);
+    crypto_cpace_finish(*server, isk, Ya, NULL, 0, NULL, 0);
+}
+
+static void
+bench_cpace_handshake(unsigned int iterations)
+{
+    crypto_cpace_session *client, *server;
+
+    while (iterations--)
+    {
+        pake_handshake(0, &client, &server);
+    }
+}
+
+static void
+bench_aucpace_handshake(unsigned int iterations)
+{
+    crypto_cpace_session *client, *server;
+
+    while (iterations--)
+    {
+        pake_handshake(1, &client, &server);
+    }
+}
+
+// Reports the phase timings the sessions record themselves, for the client
+// and the server side of SAMPLES AuCPace handshakes.
+static void
+run_aucpace_phases(void)
+{
+    static const char* const names[crypto_cpace_PHASES] = { "augment", "generator", "share", "finish" };
+    double                   samples[2][crypto_cpace_PHASES][SAMPLES];
+    char                     name[64];
+    int                      i, phase;
+
+    for (i = 0; i < SAMPLES; i++)
+    {
+        crypto_cpace_session *client, *server;
+
+        pake_handshake(1, &client, &server);
+        for (phase = 0; phase < crypto_cpace_PHASES; phase++)
+        {
+            samples[0][phase][i] = (double)client->cycles[phase];
+            samples[1][phase][i] = (double)server->cycles[phase];
+        }
+    }
+    for (phase = 0; phase < crypto_cpace_PHASES; phase++)
+    {
+        snprintf(name, sizeof(name), "crypto_aucpace_client_%s", names[phase]);
+        print_result(name, "call", samples[0][phase], 1);
+        snprintf(name, sizeof(name), "crypto_aucpace_server_%s", names[phase]);
+        print_result(name, "call", samples[1][phase], 1);
+    }
+}
+
+static void
+print_config(void)
+{
+    static const char* const switches[] =
+    {
+#ifdef CRYPTO_HAS_ASM_FE25519_MUL
+        "CRYPTO_HAS_ASM_FE25519_MUL",
+#endif
+#ifdef CRYPTO_HAS_ASM_FE25519_SQUARE
+        "CRYPTO_HAS_ASM_FE25519_SQUARE",
+#endif
+#ifdef CRYPTO_HAS_ASM_HSALSA20_BLOCK
+        "CRYPTO_HAS_ASM_HSALSA20_BLOCK",
+#endif
+#ifdef CRYPTO_HAS_ASM_CHACHA20_BLOCK
+        "CRYPTO_HAS_ASM_CHACHA20_BLOCK",
+#endif
+#ifdef CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE
+        "CRYPTO_HAS_ASM_POLY1305_UPDATE_STATE",
+#endif
+#ifdef CRYPTO_HAS_ASM_SHA512_CORE
+        "CRYPTO_HAS_ASM_SHA512_CORE",
+#endif
+#ifdef CRYPTO_HAS_FE25519_RADIX51
+        "CRYPTO_HAS_FE25519_RADIX51",
+#endif
+#ifdef CRYPTO_HAS_FE25519_INVERT_SAFEGCD
+        "CRYPTO_HAS_FE25519_INVERT_SAFEGCD",
+#endif
+#ifdef CRYPTO_HAS_POLY1305_RADIX44
+        "CRYPTO_HAS_POLY1305_RADIX44",
+#endif
+#ifdef CRYPTO_HAS_AVX2
+        "CRYPTO_HAS_AVX2",
+#endif
+#ifdef CRYPTO_HAS_SSE2
+        "CRYPTO_HAS_SSE2",
+#endif
+#ifdef CRYPTO_HAS_NEON
+        "CRYPTO_HAS_NEON",
+#endif
+#ifdef CRYPTO_HAS_PTHREADS
+        "CRYPTO_HAS_PTHREADS",
+#endif
+        NULL
+    };
+    int i;
+
+    printf("  \"config\": [");
+    for (i = 0; switches[i] != NULL; i++)
+    {
+        printf("%s\"%s\"", (i == 0) ? "" : ", ", switches[i]);
+    }
+    printf("],\n");
+}
+
+int main(int argc, char** argv)
+{
+    int i;
+
+    select_counter((argc > 1) && (strcmp(argv[1], "--perf") == 0));
+
+    randombytes(&g_sk[0][0], sizeof(g_sk));
+    randombytes(&g_pk[0][0], sizeof(g_pk));
+    randombytes(g_wide.as_uint8_t, sizeof(g_wide));
+    for (i = 0; i < 4; i++)
+    {
+        fe25519_unpack(&g_fe[i], g_pk[i]);
+    }
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        fe25519_unpack(&g_feBatch[i], g_pk[i]);
+    }
+    sc25519_from32bytes(&g_sc[0], g_sk[2]);
+    sc25519_from32bytes(&g_sc[1], g_sk[3]);
+    sc25519_to_mont(&g_scMont[0], &g_sc[0]);
+    sc25519_to_mont(&g_scMont[1], &g_sc[1]);
+    crypto_sign_ed25519_keypair(g_signPk, g_signSk);
+    crypto_sign_ed25519_detached(g_signature, g_stream, SIGN_BENCHMARK_BYTES, g_signSk);
+    for (i = 0; i < VERIFY_BATCH_SIZE; i++)
+    {
+        g_batchSig[i] = g_signature;
+        g_batchM[i] = g_stream;
+        g_batchMlen[i] = SIGN_BENCHMARK_BYTES;
+        g_batchPk[i] = g_signPk;
+    }
+    crypto_aucpace_verifier(g_pk[0], g_sk[0]);
+    g_scryptMemorySize = crypto_pwhash_scryptsalsa208sha256_MEMORYBYTES(SCRYPT_N, SCRYPT_R, SCRYPT_P, SCRYPT_P);
+    g_scryptMemory = (uint8_t*)malloc(g_scryptMemorySize);
+    if (g_scryptMemory == NULL)
+    {
+        return 1;
+    }
+
+    printf("{\n");
+    printf("  \"backend\": \"%s\",\n", CRYPTO_BENCHMARK_BACKEND);
+    printf("  \"counter\": \"%s\",\n", counter_name());
+    print_config();
+    printf("  \"results\": [\n");
+
+    run_benchmark("fe25519_mul", "call", bench_fe25519_mul, 1000, 1000);
+    run_benchmark("fe25519_square", "call", bench_fe25519_square, 1000, 1000);
+    run_benchmark("fe25519_invert", "call", bench_fe25519_invert, 10, 10);
+    run_benchmark("fe25519_pow2523", "call", bench_fe25519_pow2523, 10, 10);
+    run_benchmark("fe25519_elligator2", "call", bench_fe25519_elligator2, 10, 10);
+    run_benchmark("fe25519_elligator2x_useProvidedScratchBuffers", "call", bench_fe25519_elligator2x, 10, 10);
+    run_benchmark("fe25519_elligator2_batch", "item", bench_fe25519_elligator2_batch, 1, BATCH_SIZE);
+    run_benchmark("crypto_hash_to_curve_curve25519", "call", bench_hash_to_curve, 1, 1);
+    run_benchmark("crypto_encode_to_curve_curve25519", "call", bench_encode_to_curve, 1, 1);
+    run_benchmark("sc25519_mul", "call", bench_sc25519_mul, 100, 100);
+    run_benchmark("sc25519_mul+sc25519_add", "call", bench_sc25519_mul_add, 100, 100);
+    run_benchmark("sc25519_muladd", "call", bench_sc25519_muladd, 100, 100);
+    run_benchmark("sc25519_mont_mul", "call", bench_sc25519_mont_mul, 100, 100);
+    run_benchmark("sc25519_reduce", "call", bench_sc25519_reduce, 100, 100);
+    run_benchmark("sc25519_invert", "call", bench_sc25519_invert, 1, 1);
+    run_benchmark("crypto_stream_salsa20_xor", "byte", bench_salsa20, 1, SALSA20_BENCHMARK_BYTES);
+    run_benchmark("crypto_stream_salsa20_xor_chunked", "byte", bench_salsa20_chunked, 1, SALSA20_BENCHMARK_BYTES);
+    run_benchmark("crypto_stream_chacha20_ietf_xor", "byte", bench_chacha20, 1, SALSA20_BENCHMARK_BYTES);
+    run_benchmark("crypto_onetimeauth_poly1305", "byte", bench_poly1305, 1, SALSA20_BENCHMARK_BYTES);
+    run_benchmark("crypto_secretbox_xsalsa20poly1305", "byte", bench_secretbox, 1, SALSA20_BENCHMARK_BYTES);
+    run_benchmark("crypto_hash_sha512", "byte", bench_sha512, 1, SHA512_BENCHMARK_BYTES);
+    run_benchmark("crypto_hash_sha512_96", "call", bench_sha512_short, 10, 10);
+    run_benchmark("crypto_hash_sha512_batch_96", "item", bench_sha512_batch, 1, BATCH_SIZE);
+    run_benchmark("randombytes", "call", bench_randombytes, 100, 100);
+    run_benchmark("crypto_scalarmult_curve25519", "call", bench_scalarmult, 1, 1);
+    run_benchmark("crypto_scalarmult_base_curve25519", "call", bench_scalarmult_base, 1, 1);
+    run_benchmark("crypto_scalarmult_curve25519_batch", "item", bench_scalarmult_batch, 1, BATCH_SIZE);
+    run_benchmark("crypto_sign_ed25519_detached", "call", bench_sign, 1, 1);
+    run_benchmark("crypto_sign_ed25519_verify_detached", "call", bench_verify, 1, 1);
+    run_benchmark("crypto_sign_ed25519_verify_batch", "item", bench_verify_batch, 1, VERIFY_BATCH_SIZE);
+    run_benchmark("crypto_cpace_handshake", "call", bench_cpace_handshake, 1, 1);
+    run_benchmark("crypto_aucpace_handshake", "call", bench_aucpace_handshake, 1, 1);
+    run_aucpace_phases();
+    run_benchmark("crypto_pwhash_scryptsalsa208sha256_N1024_r8_p4", "call", bench_scrypt_1thread, 1, 1);
+    run_benchmark("crypto_pwhash_scryptsalsa208sha256_N1024_r8_p4_threads4", "call", bench_scrypt_pthreads, 1, 1);
+
+    printf("\n  ]\n}\n");
+
+    free(g_scryptMemory);
+
+    if (g_perfFd >= 0)
+    {
+        close(g_perfFd);
+    }
+    return 0;
+}
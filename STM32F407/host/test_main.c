@@ -0,0 +1,75 @@
+// 
+// Host test runner for the tests of test.c. Runs the test given as argument
+// or all tests. Returns 0 if all tests pass.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include "../test.h"
+
+typedef struct
+{
+    const char* name;
+    int (*run)(void);
+} ST_test;
+
+static const ST_test tests[] =
+{
+    { "curve25519_DH", test_curve25519_DH },
+    { "curve25519_DH_TV", test_curve25519_DH_TV },
+    { "curve25519_batch", test_curve25519_batch },
+    { "fe25519_batch_invert", test_fe25519_batch_invert },
+    { "fe25519_invert_safegcd", test_fe25519_invert_safegcd },
+    { "elligator2", test_elligator2 },
+    { "hash_to_curve", test_hash_to_curve },
+    { "salsa20", test_salsa20 },
+    { "chacha20", test_chacha20 },
+    { "poly1305", test_poly1305 },
+    { "secretbox", test_secretbox },
+    { "randombytes_drbg", test_randombytes_drbg },
+    { "sha512_TV", test_sha512_TV },
+    { "sha512_batch", test_sha512_batch },
+    { "sc25519_invert", test_sc25519_invert },
+    { "sc25519_mont", test_sc25519_mont },
+    { "sc25519_muladd", test_sc25519_muladd },
+    { "ge25519_double_scalarmult", test_ge25519_double_scalarmult },
+    { "ed25519_TV", test_ed25519_TV },
+    { "ed25519", test_ed25519 },
+    { "ed25519_batch", test_ed25519_batch },
+    { "ed25519_small_order", test_ed25519_small_order },
+    { "cpace", test_cpace },
+    { "scrypt", test_scrypt },
+};
+
+int main(int argc, char** argv)
+{
+    unsigned int i;
+    int failed = 0;
+    int found = 0;
+
+    for (i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        if ((argc > 1) && (strcmp(argv[1], tests[i].name) != 0))
+        {
+            continue;
+        }
+        found = 1;
+
+        {
+            int res = tests[i].run();
+
+            printf("Test %s (0 correct): %d\n", tests[i].name, res);
+            if (res != 0)
+            {
+                failed = 1;
+            }
+        }
+    }
+
+    if (!found)
+    {
+        printf("Unknown test %s\n", argv[1]);
+        return 1;
+    }
+    return failed;
+}
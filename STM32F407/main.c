@@ -2,6 +2,56 @@
 #include <stdio.h>
 #include "main.h"
 
+// DWT_CYCCNT extended to 64 bits, clock of the PAKE session arena.
+static uint64_t dwt_clock(void)
+{
+    static uint32_t last;
+    static uint64_t high;
+    uint32_t now = DWT_CYCCNT;
+
+    if (now < last) {
+        high += (uint64_t)1 << 32;
+    }
+    last = now;
+    return high | now;
+}
+
+// Prints the phase timings of both sides of one AuCPace handshake.
+static void report_aucpace_phases(void)
+{
+    static uint8_t memory[crypto_pake_ARENABYTES(2)];
+    static const char* const phases[crypto_cpace_PHASES] = { "augment", "generator", "share", "finish" };
+    crypto_pake_arena arena;
+    crypto_cpace_session *client, *server;
+    uint8_t w[32], W[32], X[32], Ya[32], Yb[32], isk[64];
+    unsigned char buffer[64];
+    int i;
+
+    crypto_pake_arena_init(&arena, memory, sizeof(memory), dwt_clock);
+    client = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+    server = crypto_pake_session_open(&arena, crypto_cpace_RESPONDER);
+
+    randombytes(w, 32);
+    crypto_aucpace_verifier(W, w);
+    crypto_aucpace_server_augment(server, X, W);
+    crypto_aucpace_client_augment(client, w, X);
+    crypto_aucpace_generator(client, (const uint8_t*)"CI", 2, (const uint8_t*)"sid", 3);
+    crypto_aucpace_generator(server, (const uint8_t*)"CI", 2, (const uint8_t*)"sid", 3);
+    crypto_cpace_share(client, Ya);
+    crypto_cpace_share(server, Yb);
+    crypto_cpace_finish(client, isk, Yb, NULL, 0, NULL, 0);
+    crypto_cpace_finish(server, isk, Ya, NULL, 0, NULL, 0);
+
+    for (i = 0; i < crypto_cpace_PHASES; i++) {
+        sprintf((char*)buffer, "AuCPace %s client: %lu server: %lu", phases[i],
+                (unsigned long)client->cycles[i], (unsigned long)server->cycles[i]);
+        send_USART_str(buffer);
+    }
+
+    crypto_pake_session_close(&arena, client);
+    crypto_pake_session_close(&arena, server);
+}
+
 int main(void)
 {
     clock_setup();
@@ -39,6 +89,98 @@ int main(void)
 	sprintf((char*)buffer, "Test DH TV(0 correct): %lu", res);
     send_USART_str(buffer);    
 
+    res = test_curve25519_batch();
+	sprintf((char*)buffer, "Test DH batch(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_fe25519_batch_invert();
+	sprintf((char*)buffer, "Test fe25519 batch invert(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_fe25519_invert_safegcd();
+	sprintf((char*)buffer, "Test fe25519 safegcd invert(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_elligator2();
+	sprintf((char*)buffer, "Test Elligator2(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_hash_to_curve();
+	sprintf((char*)buffer, "Test hash_to_curve(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_salsa20();
+	sprintf((char*)buffer, "Test Salsa20(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_chacha20();
+	sprintf((char*)buffer, "Test ChaCha20(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_poly1305();
+	sprintf((char*)buffer, "Test Poly1305(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_secretbox();
+	sprintf((char*)buffer, "Test secretbox(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_randombytes_drbg();
+	sprintf((char*)buffer, "Test randombytes DRBG(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_sha512_TV();
+	sprintf((char*)buffer, "Test SHA-512 TV(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_sha512_batch();
+	sprintf((char*)buffer, "Test SHA-512 batch(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_sc25519_invert();
+	sprintf((char*)buffer, "Test sc25519 invert(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_sc25519_mont();
+	sprintf((char*)buffer, "Test sc25519 Montgomery(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_sc25519_muladd();
+	sprintf((char*)buffer, "Test sc25519 muladd(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_ge25519_double_scalarmult();
+	sprintf((char*)buffer, "Test ge25519 double scalarmult(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+	send_USART_str((unsigned char*)"Test signatures!");
+
+    res = test_ed25519_TV();
+	sprintf((char*)buffer, "Test Ed25519 TV(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_ed25519();
+	sprintf((char*)buffer, "Test Ed25519(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_ed25519_batch();
+	sprintf((char*)buffer, "Test Ed25519 batch(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_ed25519_small_order();
+	sprintf((char*)buffer, "Test Ed25519 small order(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_cpace();
+	sprintf((char*)buffer, "Test CPace(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    res = test_scrypt();
+	sprintf((char*)buffer, "Test scrypt(0 correct): %lu", res);
+    send_USART_str(buffer);
+
+    report_aucpace_phases();
+
     send_USART_str((unsigned char*)"Done!");
 
     while(1);
@@ -0,0 +1,180 @@
+// 
+// Semihosting variant of main.c for qemu-system-arm:
+//
+//   qemu-system-arm -M netduinoplus2 -nographic
+//                   -semihosting-config enable=on,target=native -kernel main_qemu.elf
+//
+// Runs the tests of test.c and exits with the number of failed tests. QEMU does
+// not model the DWT cycle counter, instead the benchmarks are bracketed by
+// cycle_region_begin() / cycle_region_end() for tools/m4_cycle_estimate.py.
+//
+
+#include <stdio.h>
+#include "../main.h"
+#include "../crypto/include/crypto_sign.h"
+#include "../crypto/include/crypto_stream.h"
+#include "semihosting.h"
+
+static void
+report(
+    const char* name,
+    int         result
+)
+{
+    char buffer[64];
+
+    sprintf(buffer, "Test %s (0 correct): %d", name, result);
+    send_USART_str((unsigned char*)buffer);
+}
+
+int main(void)
+{
+    uint8_t  result[32] = {0};
+    uint8_t  stream[64] = {0};
+    uint8_t  pk[crypto_sign_ed25519_PUBLICKEYBYTES];
+    uint8_t  sk[crypto_sign_ed25519_SECRETKEYBYTES];
+    uint8_t  signature[crypto_sign_ed25519_BYTES];
+    fe25519  a;
+    fe25519  b;
+    int      failures = 0;
+    int      res;
+
+    fe25519_unpack(&a, static_key.as_uint8_t);
+    fe25519_add(&b, &a, &a);
+
+    cycle_region_begin("fe25519_mul");
+    fe25519_mul(&a, &a, &b);
+    cycle_region_end();
+
+    cycle_region_begin("fe25519_square");
+    fe25519_square(&a, &a);
+    cycle_region_end();
+
+    cycle_region_begin("fe25519_invert");
+    fe25519_invert(&a, &a);
+    cycle_region_end();
+
+    cycle_region_begin("crypto_stream_salsa20_xor_64");
+    crypto_stream_salsa20_xor(stream, stream, sizeof(stream), result, static_key.as_uint8_t);
+    cycle_region_end();
+
+    cycle_region_begin("crypto_scalarmult_base_curve25519");
+    crypto_scalarmult_base_curve25519(result, static_key.as_uint8_t);
+    cycle_region_end();
+
+    cycle_region_begin("crypto_scalarmult_curve25519");
+    crypto_scalarmult_curve25519(result, static_key.as_uint8_t, result);
+    cycle_region_end();
+
+    crypto_sign_ed25519_seed_keypair(pk, sk, static_key.as_uint8_t);
+
+    cycle_region_begin("crypto_sign_ed25519_detached_64");
+    crypto_sign_ed25519_detached(signature, stream, sizeof(stream), sk);
+    cycle_region_end();
+
+    cycle_region_begin("crypto_sign_ed25519_verify_detached_64");
+    crypto_sign_ed25519_verify_detached(signature, stream, sizeof(stream), pk);
+    cycle_region_end();
+
+    send_USART_str((unsigned char*)"Test scalarmult!");
+
+    res = test_curve25519_DH();
+    report("DH", res);
+    failures += (res != 0);
+
+    res = test_curve25519_DH_TV();
+    report("DH TV", res);
+    failures += (res != 0);
+
+    res = test_curve25519_batch();
+    report("DH batch", res);
+    failures += (res != 0);
+
+    res = test_fe25519_batch_invert();
+    report("fe25519 batch invert", res);
+    failures += (res != 0);
+
+    res = test_fe25519_invert_safegcd();
+    report("fe25519 safegcd invert", res);
+    failures += (res != 0);
+
+    res = test_elligator2();
+    report("Elligator2", res);
+    failures += (res != 0);
+
+    res = test_hash_to_curve();
+    report("hash_to_curve", res);
+    failures += (res != 0);
+
+    res = test_salsa20();
+    report("Salsa20", res);
+    failures += (res != 0);
+
+    res = test_chacha20();
+    report("ChaCha20", res);
+    failures += (res != 0);
+
+    res = test_poly1305();
+    report("Poly1305", res);
+    failures += (res != 0);
+
+    res = test_secretbox();
+    report("secretbox", res);
+    failures += (res != 0);
+
+    res = test_randombytes_drbg();
+    report("randombytes DRBG", res);
+    failures += (res != 0);
+
+    res = test_sha512_TV();
+    report("SHA-512 TV", res);
+    failures += (res != 0);
+
+    res = test_sha512_batch();
+    report("SHA-512 batch", res);
+    failures += (res != 0);
+
+    res = test_sc25519_invert();
+    report("sc25519 invert", res);
+    failures += (res != 0);
+
+    res = test_sc25519_mont();
+    report("sc25519 Montgomery", res);
+    failures += (res != 0);
+
+    res = test_sc25519_muladd();
+    report("sc25519 muladd", res);
+    failures += (res != 0);
+
+    res = test_ge25519_double_scalarmult();
+    report("ge25519 double scalarmult", res);
+    failures += (res != 0);
+
+    res = test_ed25519_TV();
+    report("Ed25519 TV", res);
+    failures += (res != 0);
+
+    res = test_ed25519();
+    report("Ed25519", res);
+    failures += (res != 0);
+
+    res = test_ed25519_batch();
+    report("Ed25519 batch", res);
+    failures += (res != 0);
+
+    res = test_ed25519_small_order();
+    report("Ed25519 small order", res);
+    failures += (res != 0);
+
+    res = test_cpace();
+    report("CPace", res);
+    failures += (res != 0);
+
+    res = test_scrypt();
+    report("scrypt", res);
+    failures += (res != 0);
+
+    send_USART_str((unsigned char*)"Done!");
+
+    return failures;
+}
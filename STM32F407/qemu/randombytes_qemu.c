@@ -0,0 +1,50 @@
+// 
+// randombytes implementation for the QEMU build variant.
+//
+// The STM32 RNG is not emulated by QEMU. The generator of randombytes_drbg.c
+// is seeded from this xorshift generator instead, which is NOT secure; it
+// only provides reproducible test inputs, such that the cycle estimates of
+// two runs can be compared.
+//
+
+#include <stdint.h>
+#include "../crypto/include/randombytes.h"
+
+static uint32_t         g_state = 0x2545f491;
+static randombytes_drbg g_drbg;
+static int              g_seeded = 0;
+
+static void
+randombytes_xorshift(uint8_t *seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < randombytes_drbg_SEEDBYTES; i++)
+    {
+        g_state ^= g_state << 13;
+        g_state ^= g_state >> 17;
+        g_state ^= g_state << 5;
+        seed[i] = (uint8_t)(g_state >> 24);
+    }
+}
+
+void randombytes(unsigned char *x,unsigned long long xlen)
+{
+    if (!g_seeded || randombytes_drbg_reseed_due(&g_drbg))
+    {
+        uint8_t seed[randombytes_drbg_SEEDBYTES];
+
+        randombytes_xorshift(seed);
+        if (g_seeded)
+        {
+            randombytes_drbg_reseed(&g_drbg, seed);
+        }
+        else
+        {
+            randombytes_drbg_init(&g_drbg, seed);
+            g_seeded = 1;
+        }
+    }
+
+    randombytes_drbg_generate(&g_drbg, x, xlen);
+}
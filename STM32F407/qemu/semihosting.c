@@ -0,0 +1,90 @@
+// 
+// ARM semihosting support for the QEMU build variant (see qemu/main_qemu.c)
+//
+
+#include "semihosting.h"
+
+#define SYS_WRITE0        0x04
+#define SYS_EXIT_EXTENDED 0x20
+
+#define ADP_Stopped_ApplicationExit 0x20026
+
+static uint32_t
+semihosting_call(
+    uint32_t    op,
+    const void* arg
+)
+{
+    register uint32_t    r0 __asm__ ("r0") = op;
+    register const void* r1 __asm__ ("r1") = arg;
+
+    __asm__ __volatile__ ("bkpt 0xab" : "+r" (r0) : "r" (r1) : "memory");
+    return r0;
+}
+
+void
+semihosting_write0(
+    const char* str
+)
+{
+    semihosting_call(SYS_WRITE0, str);
+}
+
+// SYS_EXIT_EXTENDED passes the status to the host, qemu-system-arm exits with it.
+void
+semihosting_exit(
+    int status
+)
+{
+    uint32_t block[2];
+
+    block[0] = ADP_Stopped_ApplicationExit;
+    block[1] = (uint32_t)status;
+    for (;;)
+    {
+        semihosting_call(SYS_EXIT_EXTENDED, block);
+    }
+}
+
+void
+send_USART_str(
+    const unsigned char* in
+)
+{
+    semihosting_write0((const char*)in);
+    semihosting_write0("\n");
+}
+
+// The estimator locates the two marker functions by their symbol names. They
+// must not be inlined or merged.
+void cycle_marker_begin(void) __attribute__ ((noinline, used));
+void cycle_marker_end(void) __attribute__ ((noinline, used));
+
+void
+cycle_marker_begin(void)
+{
+    __asm__ __volatile__ ("" : : : "memory");
+}
+
+void
+cycle_marker_end(void)
+{
+    __asm__ __volatile__ ("nop" : : : "memory");
+}
+
+void
+cycle_region_begin(
+    const char* name
+)
+{
+    semihosting_write0("@cycles ");
+    semihosting_write0(name);
+    semihosting_write0("\n");
+    cycle_marker_begin();
+}
+
+void
+cycle_region_end(void)
+{
+    cycle_marker_end();
+}
@@ -0,0 +1,23 @@
+#ifndef SEMIHOSTING_H
+#define SEMIHOSTING_H
+
+//
+// ARM semihosting calls for running the firmware under qemu-system-arm
+// (-semihosting-config enable=on,target=native) or a debugger.
+//
+
+#include <stdint.h>
+
+void semihosting_write0(const char* str);
+void semihosting_exit(int status) __attribute__ ((noreturn));
+
+// Counterpart of send_USART_str() in stm32f4_wrapper.c. Appends a line feed.
+void send_USART_str(const unsigned char* in);
+
+// Brackets a code region for tools/m4_cycle_estimate.py. cycle_region_begin()
+// prints "@cycles <name>" and the estimator adds up the instructions executed
+// between the two marker functions.
+void cycle_region_begin(const char* name);
+void cycle_region_end(void);
+
+#endif
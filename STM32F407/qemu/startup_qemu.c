@@ -0,0 +1,86 @@
+// 
+// Minimal startup code for the QEMU build variant. Replaces the vector table
+// and reset handler of libopencm3, such that the variant only needs the
+// arm-none-eabi toolchain.
+//
+
+#include <stdint.h>
+#include "semihosting.h"
+
+extern uint32_t _data_loadaddr;
+extern uint32_t _data;
+extern uint32_t _edata;
+extern uint32_t _ebss;
+extern uint32_t _stack;
+
+extern void (*__preinit_array_start[])(void);
+extern void (*__preinit_array_end[])(void);
+extern void (*__init_array_start[])(void);
+extern void (*__init_array_end[])(void);
+
+int main(void);
+
+void reset_handler(void) __attribute__ ((noreturn));
+void fault_handler(void) __attribute__ ((noreturn));
+
+#define SCB_CPACR (*(volatile uint32_t*)0xE000ED88)
+
+__attribute__ ((section(".vectors"), used))
+void (*const vector_table[16])(void) =
+{
+    (void (*)(void))&_stack,
+    reset_handler,
+    fault_handler, // NMI
+    fault_handler, // HardFault
+    fault_handler, // MemManage
+    fault_handler, // BusFault
+    fault_handler, // UsageFault
+    fault_handler, // reserved
+    fault_handler, // reserved
+    fault_handler, // reserved
+    fault_handler, // reserved
+    fault_handler, // SVCall
+    fault_handler, // DebugMonitor
+    fault_handler, // reserved
+    fault_handler, // PendSV
+    fault_handler, // SysTick
+};
+
+void
+reset_handler(void)
+{
+    uint32_t* src = &_data_loadaddr;
+    uint32_t* dst = &_data;
+    void (**fn)(void);
+
+    while (dst < &_edata)
+    {
+        *dst++ = *src++;
+    }
+    while (dst < &_ebss)
+    {
+        *dst++ = 0;
+    }
+
+    // Enable CP10 and CP11, the firmware is compiled for -mfloat-abi=hard.
+    SCB_CPACR |= 0xfu << 20;
+    __asm__ __volatile__ ("dsb\n\tisb" : : : "memory");
+
+    for (fn = __preinit_array_start; fn < __preinit_array_end; fn++)
+    {
+        (*fn)();
+    }
+    for (fn = __init_array_start; fn < __init_array_end; fn++)
+    {
+        (*fn)();
+    }
+
+    semihosting_exit(main());
+}
+
+void
+fault_handler(void)
+{
+    semihosting_write0("Fault!\n");
+    semihosting_exit(255);
+}
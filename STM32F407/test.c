@@ -95,3 +95,1552 @@ int test_curve25519_DH_TV() {
 	return result;
 
 }
+
+// Compare the batch interface against individual calls, including a
+// number of items that is not a multiple of 4.
+// Return 0 if all results are equal, 1 otherwise
+int test_curve25519_batch() {
+	static const uint8_t order8_point[32] = {
+		0xE0, 0xEB, 0x7A, 0x7C, 0x3B, 0x41, 0xB8, 0xAE, 0x16, 0x56, 0xE3, 0xFA, 0xF1, 0x9F, 0xC4, 0x6A,
+		0xDA, 0x09, 0x8D, 0xEB, 0x9C, 0x32, 0xB1, 0xFD, 0x86, 0x62, 0x05, 0x16, 0x5F, 0x49, 0xB8, 0x00 };
+	uint8_t sk[7][32];
+	uint8_t pk[7][32];
+	uint8_t ss[7][32];
+	uint8_t ss_single[32];
+	int i, j;
+	int result = 0;
+
+	randombytes(&sk[0][0], sizeof(sk));
+	randombytes(&pk[0][0], sizeof(pk));
+	// A point of order 8, its ladder ends with z = 0.
+	memcpy(pk[2], order8_point, 32);
+
+	crypto_scalarmult_curve25519_batch(ss, (const uint8_t (*)[32])sk, (const uint8_t (*)[32])pk, 7);
+
+	for(i=0;i<7;i++) {
+		crypto_scalarmult_curve25519(ss_single, sk[i], pk[i]);
+		for(j=0;j<32;j++) {
+			if(ss[i][j] != ss_single[j]) {
+				result = 1;
+			}
+		}
+	}
+	return result;
+}
+
+// Compares fe25519_batch_invert with single inversions for 7 elements with
+// zeros at the first, a middle and the last index, also in place.
+// Return 0 if correct
+int test_fe25519_batch_invert() {
+	fe25519 in[7];
+	fe25519 out[7];
+	fe25519 scratch[7];
+	fe25519 single;
+	uint8_t bytes[32], bytes_single[32];
+	int i, pass;
+	int result = 0;
+
+	for (i = 0; i < 7; i++) {
+		fe25519_generateRandomValue(&in[i]);
+	}
+	fe25519_setzero(&in[0]);
+	fe25519_setzero(&in[3]);
+	fe25519_setzero(&in[6]);
+
+	for (pass = 0; pass < 2; pass++) {
+		if (pass == 0) {
+			fe25519_batch_invert(out, in, 7, scratch);
+		} else {
+			memcpy(out, in, sizeof(out));
+			fe25519_batch_invert(out, out, 7, scratch);
+		}
+		for (i = 0; i < 7; i++) {
+			if (fe25519_iszero(&in[i]) == 0) {
+				if (fe25519_iszero(&out[i]) != 0) {
+					result |= 1 << pass;
+				}
+				continue;
+			}
+			fe25519_invert(&single, &in[i]);
+			fe25519_pack(bytes, &out[i]);
+			fe25519_pack(bytes_single, &single);
+			if (memcmp(bytes, bytes_single, 32) != 0) {
+				result |= 1 << pass;
+			}
+		}
+	}
+
+	// A single zero element.
+	fe25519_batch_invert(out, in, 1, scratch);
+	if (fe25519_iszero(&out[0]) != 0) {
+		result |= 4;
+	}
+	return result;
+}
+
+// Compares fe25519_invert_safegcd with the exponentiation by p - 2 for random
+// values, 0, 1, p - 1 and the unreduced encodings of 0 and 18.
+// Return 0 if correct
+int test_fe25519_invert_safegcd() {
+	uint8_t bytes[32];
+	uint8_t r1[32], r2[32];
+	fe25519 x, inv, ref, t0, t1, t2;
+	int i;
+	int result = 0;
+
+	for (i = 0; i < 25; i++) {
+		if (i < 20) {
+			randombytes(bytes, 32);
+		} else {
+			// 0, 1, p - 1, p, 2^255 - 1
+			memset(bytes, (i < 22) ? 0 : 0xff, 32);
+			bytes[0] = (i == 21) ? 1 : ((i == 22) ? 0xec : ((i == 23) ? 0xed : bytes[0]));
+		}
+		bytes[31] &= 0x7f;
+		fe25519_unpack(&x, bytes);
+
+		fe25519_invert_safegcd(&inv, &x);
+		fe25519_invert_useProvidedScratchBuffers(&ref, &x, &t0, &t1, &t2);
+		fe25519_pack(r1, &inv);
+		fe25519_pack(r2, &ref);
+		if (memcmp(r1, r2, 32) != 0) {
+			result |= 1;
+		}
+
+		// In place.
+		fe25519_invert_safegcd(&x, &x);
+		fe25519_pack(r2, &x);
+		if (memcmp(r1, r2, 32) != 0) {
+			result |= 2;
+		}
+	}
+	return result;
+}
+
+// Compares fe25519_elligator2 with the two exponentiation variant and the
+// batch function for 11 inputs (including r = 0), i.e. two groups of four and
+// a remainder. Checks that x^3 + A.x^2 + x is a square.
+// Return 0 if correct
+int test_elligator2() {
+	fe25519 r[11];
+	fe25519 x[11];
+	fe25519 x_single, x_ref, w, t0, t1, t2, t3, v;
+	uint8_t bytes[32], bytes_ref[32];
+	int i;
+	int result = 0;
+
+	for (i = 0; i < 11; i++) {
+		fe25519_generateRandomValue(&r[i]);
+	}
+	fe25519_setzero(&r[5]);
+
+	fe25519_elligator2_batch(x, r, 11);
+
+	for (i = 0; i < 11; i++) {
+		fe25519_elligator2(&x_single, &r[i]);
+		fe25519_elligator2x_useProvidedScratchBuffers(&x_ref, &r[i], &t0, &t1, &t2, &t3, &v);
+
+		fe25519_pack(bytes, &x_single);
+		fe25519_pack(bytes_ref, &x_ref);
+		if (memcmp(bytes, bytes_ref, 32) != 0) {
+			result |= 1;
+		}
+		fe25519_pack(bytes_ref, &x[i]);
+		if (memcmp(bytes, bytes_ref, 32) != 0) {
+			result |= 2;
+		}
+
+		// w = x.(x.(x + A) + 1)
+		fe25519_sub(&t0, &x_single, &fe25519_minusA);
+		fe25519_mul(&t1, &t0, &x_single);
+		fe25519_add(&t0, &t1, &fe25519_one);
+		fe25519_mul(&w, &t0, &x_single);
+		if (fe25519_sqrt_ratio(&t0, &w, &fe25519_one) != 1) {
+			result |= 4;
+		}
+	}
+	return result;
+}
+
+typedef struct {
+	int ro;
+	const char *msg;
+	unsigned int msglen;
+	uint8_t u[32]; // big endian
+	uint8_t v[32]; // big endian
+} ST_hash_to_curve_TV;
+
+// Test vectors of RFC 9380, appendices J.7.1, J.7.2 and K.2
+// Return 0 if all outputs are correct
+int test_hash_to_curve() {
+	static const uint8_t dst_ro[] = "QUUX-V01-CS02-with-curve25519_XMD:SHA-512_ELL2_RO_";
+	static const uint8_t dst_nu[] = "QUUX-V01-CS02-with-curve25519_XMD:SHA-512_ELL2_NU_";
+	static const uint8_t dst_xmd[] = "QUUX-V01-CS02-with-expander-SHA512-256";
+	static const uint8_t correct_xmd[32] = {
+		0x6B, 0x9A, 0x73, 0x12, 0x41, 0x1D, 0x92, 0xF9, 0x21, 0xC6, 0xF6, 0x8C, 0xA0, 0xB6, 0x38, 0x07,
+		0x30, 0xA1, 0xA4, 0xD9, 0x82, 0xC5, 0x07, 0x21, 0x1A, 0x90, 0x96, 0x4C, 0x39, 0x41, 0x79, 0xBA };
+	static const ST_hash_to_curve_TV tv[4] = {
+		{ 1, "", 0,
+		  {
+			0x2D, 0xE3, 0x78, 0x0A, 0xBB, 0x67, 0xE8, 0x61, 0x28, 0x9F, 0x57, 0x49, 0xD1, 0x6D, 0x3E, 0x21,
+			0x7F, 0xFA, 0x72, 0x21, 0x92, 0xD1, 0x6B, 0xBD, 0x9D, 0x1B, 0xFB, 0x9D, 0x11, 0x2B, 0x98, 0xC0 },
+		  {
+			0x3B, 0x5D, 0xC2, 0xA4, 0x98, 0x94, 0x1A, 0x10, 0x33, 0xD1, 0x76, 0x56, 0x7D, 0x45, 0x78, 0x45,
+			0x63, 0x75, 0x54, 0xA2, 0xFE, 0x7A, 0x35, 0x07, 0xD2, 0x1A, 0xBD, 0x1C, 0x1B, 0xD6, 0xE8, 0x78 } },
+		{ 1, "abc", 3,
+		  {
+			0x2B, 0x44, 0x19, 0xF1, 0xF2, 0xD4, 0x8F, 0x58, 0x72, 0xDE, 0x69, 0x2B, 0x0A, 0xCA, 0x72, 0xCC,
+			0x7B, 0x0A, 0x60, 0x91, 0x5D, 0xD7, 0x0B, 0xDE, 0x43, 0x2E, 0x82, 0x6B, 0x6A, 0xBC, 0x52, 0x6D },
+		  {
+			0x1B, 0x82, 0x35, 0xF2, 0x55, 0xA2, 0x68, 0xF0, 0xA6, 0xFA, 0x87, 0x63, 0xE9, 0x7E, 0xB3, 0xD2,
+			0x2D, 0x14, 0x93, 0x43, 0xD4, 0x95, 0xDA, 0x11, 0x60, 0xEF, 0xF9, 0x70, 0x3F, 0x2D, 0x07, 0xDD } },
+		{ 0, "", 0,
+		  {
+			0x1B, 0xB9, 0x13, 0xF0, 0xC9, 0xDA, 0xEF, 0xA0, 0xB3, 0x37, 0x53, 0x78, 0xFF, 0xA5, 0x34, 0xBD,
+			0xA5, 0x52, 0x6C, 0x97, 0x39, 0x19, 0x52, 0xA7, 0x78, 0x9E, 0xB9, 0x76, 0xED, 0xFE, 0x4D, 0x08 },
+		  {
+			0x45, 0x48, 0x36, 0x8F, 0x4F, 0x98, 0x32, 0x43, 0xE7, 0x47, 0xB6, 0x2A, 0x60, 0x08, 0x40, 0xAE,
+			0x7C, 0x1D, 0xAB, 0x5C, 0x72, 0x39, 0x91, 0xF8, 0x5D, 0x3A, 0x97, 0x68, 0x47, 0x9F, 0x3E, 0xC4 } },
+		{ 0, "abc", 3,
+		  {
+			0x7C, 0x22, 0x95, 0x0B, 0x7D, 0x90, 0x0F, 0xA8, 0x66, 0x33, 0x42, 0x62, 0xFC, 0xAE, 0xA4, 0x7A,
+			0x44, 0x1A, 0x57, 0x8D, 0xF4, 0x3B, 0x89, 0x4B, 0x46, 0x25, 0xC9, 0xB4, 0x50, 0xF9, 0xA0, 0x26 },
+		  {
+			0x55, 0x47, 0xBC, 0x00, 0xE4, 0xC0, 0x96, 0x85, 0xDC, 0xBC, 0x6C, 0xB6, 0x76, 0x52, 0x88, 0xB3,
+			0x86, 0xD8, 0xBD, 0xCB, 0x59, 0x5F, 0xA5, 0xA6, 0xE3, 0x96, 0x9E, 0x08, 0x09, 0x7F, 0x05, 0x41 } }
+	};
+	uint8_t u[32], v[32], u_only[32], expected[32];
+	unsigned int i;
+	int result = 0;
+
+	if (crypto_expand_message_xmd_sha512(u, 32, (const uint8_t*)"", 0, dst_xmd, sizeof(dst_xmd) - 1) != 0 ||
+	    memcmp(u, correct_xmd, 32) != 0) {
+		result |= 1;
+	}
+
+	for (i = 0; i < 4; i++) {
+		const uint8_t *dst = tv[i].ro ? dst_ro : dst_nu;
+
+		if (tv[i].ro) {
+			crypto_hash_to_curve_curve25519(u, v, (const uint8_t*)tv[i].msg, tv[i].msglen, dst, sizeof(dst_ro) - 1);
+			crypto_hash_to_curve_curve25519(u_only, NULL, (const uint8_t*)tv[i].msg, tv[i].msglen, dst, sizeof(dst_ro) - 1);
+		} else {
+			crypto_encode_to_curve_curve25519(u, v, (const uint8_t*)tv[i].msg, tv[i].msglen, dst, sizeof(dst_nu) - 1);
+			crypto_encode_to_curve_curve25519(u_only, NULL, (const uint8_t*)tv[i].msg, tv[i].msglen, dst, sizeof(dst_nu) - 1);
+		}
+		flipEndian(expected, tv[i].u);
+		if (memcmp(u, expected, 32) != 0 || memcmp(u_only, expected, 32) != 0) {
+			result |= 2;
+		}
+		flipEndian(expected, tv[i].v);
+		if (memcmp(v, expected, 32) != 0) {
+			result |= 4;
+		}
+	}
+
+	if (crypto_hash_to_curve_curve25519(u, v, (const uint8_t*)"abc", 3, dst_ro, 0) != -1) {
+		result |= 8;
+	}
+	return result;
+}
+
+// SHA-512 of "abc" and of the two block message of FIPS 180-4, also hashed
+// incrementally in pieces of 1 and 61 bytes.
+// Return 0 if all digests are correct
+int test_sha512_TV() {
+	static const uint8_t correct_abc[64] = {
+		0xDD, 0xAF, 0x35, 0xA1, 0x93, 0x61, 0x7A, 0xBA, 0xCC, 0x41, 0x73, 0x49, 0xAE, 0x20, 0x41, 0x31,
+		0x12, 0xE6, 0xFA, 0x4E, 0x89, 0xA9, 0x7E, 0xA2, 0x0A, 0x9E, 0xEE, 0xE6, 0x4B, 0x55, 0xD3, 0x9A,
+		0x21, 0x92, 0x99, 0x2A, 0x27, 0x4F, 0xC1, 0xA8, 0x36, 0xBA, 0x3C, 0x23, 0xA3, 0xFE, 0xEB, 0xBD,
+		0x45, 0x4D, 0x44, 0x23, 0x64, 0x3C, 0xE8, 0x0E, 0x2A, 0x9A, 0xC9, 0x4F, 0xA5, 0x4C, 0xA4, 0x9F };
+	static const uint8_t msg2[] = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+	static const uint8_t correct_msg2[64] = {
+		0x8E, 0x95, 0x9B, 0x75, 0xDA, 0xE3, 0x13, 0xDA, 0x8C, 0xF4, 0xF7, 0x28, 0x14, 0xFC, 0x14, 0x3F,
+		0x8F, 0x77, 0x79, 0xC6, 0xEB, 0x9F, 0x7F, 0xA1, 0x72, 0x99, 0xAE, 0xAD, 0xB6, 0x88, 0x90, 0x18,
+		0x50, 0x1D, 0x28, 0x9E, 0x49, 0x00, 0xF7, 0xE4, 0x33, 0x1B, 0x99, 0xDE, 0xC4, 0xB5, 0x43, 0x3A,
+		0xC7, 0xD3, 0x29, 0xEE, 0xB6, 0xDD, 0x26, 0x54, 0x5E, 0x96, 0xE5, 0x5B, 0x87, 0x4B, 0xE9, 0x09 };
+	crypto_hash_sha512_state state;
+	uint8_t digest[64];
+	unsigned int i;
+	int result = 0;
+
+	crypto_hash_sha512(digest, (const uint8_t*)"abc", 3);
+	if (memcmp(digest, correct_abc, 64) != 0) {
+		result |= 1;
+	}
+
+	crypto_hash_sha512(digest, msg2, sizeof(msg2) - 1);
+	if (memcmp(digest, correct_msg2, 64) != 0) {
+		result |= 2;
+	}
+
+	crypto_hash_sha512_init(&state);
+	crypto_hash_sha512_update(&state, msg2, 1);
+	for (i = 1; i < sizeof(msg2) - 1; i += 61) {
+		unsigned int n = (sizeof(msg2) - 1 - i < 61) ? (sizeof(msg2) - 1 - i) : 61;
+		crypto_hash_sha512_update(&state, msg2 + i, n);
+	}
+	crypto_hash_sha512_final(&state, digest);
+	if (memcmp(digest, correct_msg2, 64) != 0) {
+		result |= 4;
+	}
+	return result;
+}
+
+// crypto_hash_sha512_batch and crypto_hash_sha512_update_final_batch with
+// lengths around the block and padding boundaries, compared to crypto_hash_sha512.
+// Return 0 if all digests are equal
+int test_sha512_batch() {
+	static const unsigned long long lengths[15] = { 0, 1, 3, 111, 112, 113, 127, 128, 129, 200, 239, 240, 255, 256, 300 };
+	uint8_t msg[300 + 64];
+	uint8_t digest[15][64], correct[64];
+	const uint8_t *in[15];
+	unsigned long long inlen[15];
+	crypto_hash_sha512_state state[5];
+	unsigned int i;
+	int result = 0;
+
+	for (i = 0; i < sizeof(msg); i++) {
+		msg[i] = (uint8_t)(7 * i + 3);
+	}
+
+	// Different lengths in all lanes
+	for (i = 0; i < 15; i++) {
+		in[i] = msg + i;
+		inlen[i] = lengths[i];
+	}
+	crypto_hash_sha512_batch(digest[0], in, inlen, 15);
+	for (i = 0; i < 15; i++) {
+		crypto_hash_sha512(correct, in[i], inlen[i]);
+		if (memcmp(digest[i], correct, 64) != 0) {
+			result |= 1;
+		}
+	}
+
+	// Equal lengths with one and two padding blocks
+	for (i = 0; i < 8; i++) {
+		inlen[i] = (i < 4) ? 96 : 240;
+	}
+	crypto_hash_sha512_batch(digest[0], in, inlen, 8);
+	for (i = 0; i < 8; i++) {
+		crypto_hash_sha512(correct, in[i], inlen[i]);
+		if (memcmp(digest[i], correct, 64) != 0) {
+			result |= 2;
+		}
+	}
+
+	// Buffered prefixes of 64 bytes as in the batch verification of Ed25519
+	for (i = 0; i < 5; i++) {
+		crypto_hash_sha512_init(&state[i]);
+		crypto_hash_sha512_update(&state[i], msg, 64);
+		in[i] = msg + 64;
+		inlen[i] = lengths[3 * i + 2];
+	}
+	crypto_hash_sha512_update_final_batch(state, digest[0], in, inlen, 5);
+	for (i = 0; i < 5; i++) {
+		crypto_hash_sha512(correct, msg, 64 + inlen[i]);
+		if (memcmp(digest[i], correct, 64) != 0) {
+			result |= 4;
+		}
+	}
+	return result;
+}
+
+typedef struct {
+	uint8_t seed[32];
+	uint8_t pk[32];
+	uint8_t sig[64];
+	uint8_t msg[2];
+	unsigned int msglen;
+} ST_ed25519_TV;
+
+// Test vectors 1 - 3 of RFC 8032, section 7.1
+// Return 0 if keys and signatures are correct and the signatures verify
+int test_ed25519_TV() {
+	static const ST_ed25519_TV tv[3] = {
+	{
+		{
+		  0x9D, 0x61, 0xB1, 0x9D, 0xEF, 0xFD, 0x5A, 0x60, 0xBA, 0x84, 0x4A, 0xF4, 0x92, 0xEC, 0x2C, 0xC4,
+		  0x44, 0x49, 0xC5, 0x69, 0x7B, 0x32, 0x69, 0x19, 0x70, 0x3B, 0xAC, 0x03, 0x1C, 0xAE, 0x7F, 0x60 },
+		{
+		  0xD7, 0x5A, 0x98, 0x01, 0x82, 0xB1, 0x0A, 0xB7, 0xD5, 0x4B, 0xFE, 0xD3, 0xC9, 0x64, 0x07, 0x3A,
+		  0x0E, 0xE1, 0x72, 0xF3, 0xDA, 0xA6, 0x23, 0x25, 0xAF, 0x02, 0x1A, 0x68, 0xF7, 0x07, 0x51, 0x1A },
+		{
+		  0xE5, 0x56, 0x43, 0x00, 0xC3, 0x60, 0xAC, 0x72, 0x90, 0x86, 0xE2, 0xCC, 0x80, 0x6E, 0x82, 0x8A,
+		  0x84, 0x87, 0x7F, 0x1E, 0xB8, 0xE5, 0xD9, 0x74, 0xD8, 0x73, 0xE0, 0x65, 0x22, 0x49, 0x01, 0x55,
+		  0x5F, 0xB8, 0x82, 0x15, 0x90, 0xA3, 0x3B, 0xAC, 0xC6, 0x1E, 0x39, 0x70, 0x1C, 0xF9, 0xB4, 0x6B,
+		  0xD2, 0x5B, 0xF5, 0xF0, 0x59, 0x5B, 0xBE, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8E, 0x7A, 0x10, 0x0B },
+		{ 0 }, 0
+	},
+	{
+		{
+		  0x4C, 0xCD, 0x08, 0x9B, 0x28, 0xFF, 0x96, 0xDA, 0x9D, 0xB6, 0xC3, 0x46, 0xEC, 0x11, 0x4E, 0x0F,
+		  0x5B, 0x8A, 0x31, 0x9F, 0x35, 0xAB, 0xA6, 0x24, 0xDA, 0x8C, 0xF6, 0xED, 0x4F, 0xB8, 0xA6, 0xFB },
+		{
+		  0x3D, 0x40, 0x17, 0xC3, 0xE8, 0x43, 0x89, 0x5A, 0x92, 0xB7, 0x0A, 0xA7, 0x4D, 0x1B, 0x7E, 0xBC,
+		  0x9C, 0x98, 0x2C, 0xCF, 0x2E, 0xC4, 0x96, 0x8C, 0xC0, 0xCD, 0x55, 0xF1, 0x2A, 0xF4, 0x66, 0x0C },
+		{
+		  0x92, 0xA0, 0x09, 0xA9, 0xF0, 0xD4, 0xCA, 0xB8, 0x72, 0x0E, 0x82, 0x0B, 0x5F, 0x64, 0x25, 0x40,
+		  0xA2, 0xB2, 0x7B, 0x54, 0x16, 0x50, 0x3F, 0x8F, 0xB3, 0x76, 0x22, 0x23, 0xEB, 0xDB, 0x69, 0xDA,
+		  0x08, 0x5A, 0xC1, 0xE4, 0x3E, 0x15, 0x99, 0x6E, 0x45, 0x8F, 0x36, 0x13, 0xD0, 0xF1, 0x1D, 0x8C,
+		  0x38, 0x7B, 0x2E, 0xAE, 0xB4, 0x30, 0x2A, 0xEE, 0xB0, 0x0D, 0x29, 0x16, 0x12, 0xBB, 0x0C, 0x00 },
+		{ 0x72 }, 1
+	},
+	{
+		{
+		  0xC5, 0xAA, 0x8D, 0xF4, 0x3F, 0x9F, 0x83, 0x7B, 0xED, 0xB7, 0x44, 0x2F, 0x31, 0xDC, 0xB7, 0xB1,
+		  0x66, 0xD3, 0x85, 0x35, 0x07, 0x6F, 0x09, 0x4B, 0x85, 0xCE, 0x3A, 0x2E, 0x0B, 0x44, 0x58, 0xF7 },
+		{
+		  0xFC, 0x51, 0xCD, 0x8E, 0x62, 0x18, 0xA1, 0xA3, 0x8D, 0xA4, 0x7E, 0xD0, 0x02, 0x30, 0xF0, 0x58,
+		  0x08, 0x16, 0xED, 0x13, 0xBA, 0x33, 0x03, 0xAC, 0x5D, 0xEB, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25 },
+		{
+		  0x62, 0x91, 0xD6, 0x57, 0xDE, 0xEC, 0x24, 0x02, 0x48, 0x27, 0xE6, 0x9C, 0x3A, 0xBE, 0x01, 0xA3,
+		  0x0C, 0xE5, 0x48, 0xA2, 0x84, 0x74, 0x3A, 0x44, 0x5E, 0x36, 0x80, 0xD7, 0xDB, 0x5A, 0xC3, 0xAC,
+		  0x18, 0xFF, 0x9B, 0x53, 0x8D, 0x16, 0xF2, 0x90, 0xAE, 0x67, 0xF7, 0x60, 0x98, 0x4D, 0xC6, 0x59,
+		  0x4A, 0x7C, 0x15, 0xE9, 0x71, 0x6E, 0xD2, 0x8D, 0xC0, 0x27, 0xBE, 0xCE, 0xEA, 0x1E, 0xC4, 0x0A },
+		{ 0xAF, 0x82 }, 2
+	}
+	};
+	uint8_t pk[32];
+	uint8_t sk[64];
+	uint8_t sig[64];
+	int i;
+	int result = 0;
+
+	for (i = 0; i < 3; i++) {
+		crypto_sign_ed25519_seed_keypair(pk, sk, tv[i].seed);
+		if (memcmp(pk, tv[i].pk, 32) != 0) {
+			result |= 1;
+		}
+		crypto_sign_ed25519_detached(sig, tv[i].msg, tv[i].msglen, sk);
+		if (memcmp(sig, tv[i].sig, 64) != 0) {
+			result |= 2;
+		}
+		if (crypto_sign_ed25519_verify_detached(tv[i].sig, tv[i].msg, tv[i].msglen, tv[i].pk) != 0) {
+			result |= 4;
+		}
+	}
+	return result;
+}
+
+// Sign and open random messages with random keys. Modified messages,
+// signatures and S + L (non-canonical S) shall be rejected.
+// Return 0 if all checks pass
+int test_ed25519() {
+	static const uint8_t order[32] = {
+		0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10 };
+	uint8_t pk[32];
+	uint8_t sk[64];
+	uint8_t m[100];
+	uint8_t sm[164];
+	uint8_t opened[164];
+	unsigned long long smlen;
+	unsigned long long mlen;
+	int i, j;
+	int result = 0;
+
+	for (i = 0; i < 4; i++) {
+		crypto_sign_ed25519_keypair(pk, sk);
+		randombytes(m, sizeof(m));
+
+		crypto_sign_ed25519(sm, &smlen, m, sizeof(m), sk);
+		if ((smlen != sizeof(sm)) ||
+		    (crypto_sign_ed25519_open(opened, &mlen, sm, smlen, pk) != 0) ||
+		    (mlen != sizeof(m)) || (memcmp(opened, m, sizeof(m)) != 0)) {
+			result |= 1;
+		}
+
+		sm[64 + i] ^= 1;
+		if (crypto_sign_ed25519_open(opened, &mlen, sm, smlen, pk) == 0) {
+			result |= 2;
+		}
+		sm[64 + i] ^= 1;
+
+		sm[i] ^= 0x10;
+		if (crypto_sign_ed25519_open(opened, &mlen, sm, smlen, pk) == 0) {
+			result |= 4;
+		}
+		sm[i] ^= 0x10;
+
+		// S + L is congruent to S but not canonical. S < 2^253, so S + L < 2^256.
+		{
+			unsigned int carry = 0;
+			for (j = 0; j < 32; j++) {
+				carry += (unsigned int)sm[32 + j] + order[j];
+				sm[32 + j] = (uint8_t)carry;
+				carry >>= 8;
+			}
+		}
+		if (crypto_sign_ed25519_open(opened, &mlen, sm, smlen, pk) == 0) {
+			result |= 8;
+		}
+	}
+	return result;
+}
+
+#define TEST_ED25519_BATCH_N (CRYPTO_SIGN_ED25519_BATCH_CHUNK + 4)
+
+// Verify more signatures than fit into one chunk at once. A modified message,
+// a non-canonical S and a public key with y >= p shall be flagged individually
+// in valid[] while all other signatures stay valid.
+// Return 0 if all checks pass
+int test_ed25519_batch() {
+	static uint8_t sig[TEST_ED25519_BATCH_N][64];
+	static uint8_t m[TEST_ED25519_BATCH_N][40];
+	static uint8_t pk[TEST_ED25519_BATCH_N][32];
+	static const uint8_t *sigs[TEST_ED25519_BATCH_N];
+	static const uint8_t *ms[TEST_ED25519_BATCH_N];
+	static const uint8_t *pks[TEST_ED25519_BATCH_N];
+	static unsigned long long mlen[TEST_ED25519_BATCH_N];
+	static int valid[TEST_ED25519_BATCH_N];
+	uint8_t sk[64];
+	uint8_t savedPk[32];
+	int i;
+	int result = 0;
+
+	for (i = 0; i < TEST_ED25519_BATCH_N; i++) {
+		crypto_sign_ed25519_keypair(pk[i], sk);
+		randombytes(m[i], sizeof(m[i]));
+		mlen[i] = sizeof(m[i]) - (i & 7);
+		crypto_sign_ed25519_detached(sig[i], m[i], mlen[i], sk);
+		sigs[i] = sig[i];
+		ms[i] = m[i];
+		pks[i] = pk[i];
+	}
+
+	if (crypto_sign_ed25519_verify_batch(sigs, ms, mlen, pks, TEST_ED25519_BATCH_N, valid) != 0) {
+		result |= 1;
+	}
+	for (i = 0; i < TEST_ED25519_BATCH_N; i++) {
+		if (valid[i] != 1) {
+			result |= 2;
+		}
+	}
+
+	// Invalid signatures in both chunks.
+	m[3][0] ^= 1;
+	sig[TEST_ED25519_BATCH_N - 2][63] |= 0xf0;
+	memcpy(savedPk, pk[TEST_ED25519_BATCH_N - 1], 32);
+	memset(pk[TEST_ED25519_BATCH_N - 1], 0xff, 32);
+	pk[TEST_ED25519_BATCH_N - 1][0] = 0xed;
+	pk[TEST_ED25519_BATCH_N - 1][31] = 0x7f;
+
+	if (crypto_sign_ed25519_verify_batch(sigs, ms, mlen, pks, TEST_ED25519_BATCH_N, valid) == 0) {
+		result |= 4;
+	}
+	for (i = 0; i < TEST_ED25519_BATCH_N; i++) {
+		int expected = (i != 3) && (i < TEST_ED25519_BATCH_N - 2);
+		if (valid[i] != expected) {
+			result |= 8;
+		}
+	}
+
+	// A single corrupted signature in the last, partial chunk.
+	m[3][0] ^= 1;
+	sig[TEST_ED25519_BATCH_N - 2][63] &= 0x0f;
+	memcpy(pk[TEST_ED25519_BATCH_N - 1], savedPk, 32);
+	sig[TEST_ED25519_BATCH_N - 3][5] ^= 0x40;
+	if (crypto_sign_ed25519_verify_batch(sigs, ms, mlen, pks, TEST_ED25519_BATCH_N, valid) == 0) {
+		result |= 16;
+	}
+	for (i = 0; i < TEST_ED25519_BATCH_N; i++) {
+		if (valid[i] != (i != TEST_ED25519_BATCH_N - 3)) {
+			result |= 32;
+		}
+	}
+	return result;
+}
+
+// Signatures with small order components: A of order 8 and R = r * B + T
+// with T of order 4, S = r. Only the equation multiplied by the cofactor
+// holds, for most messages not the one without it. The single and the batch
+// verification shall both accept all of them.
+// Return 0 if all checks pass
+int test_ed25519_small_order() {
+	static const uint8_t order8[32] = {
+		0xc7, 0x17, 0x6a, 0x70, 0x3d, 0x4d, 0xd8, 0x4f, 0xba, 0x3c, 0x0b, 0x76, 0x0d, 0x10, 0x67, 0x0f,
+		0x2a, 0x20, 0x53, 0xfa, 0x2c, 0x39, 0xcc, 0xc6, 0x4e, 0xc7, 0xfd, 0x77, 0x92, 0xac, 0x03, 0x7a };
+	static const uint8_t order4[32] = { 0 };
+	uint8_t sig[8][64];
+	uint8_t m[8][16];
+	const uint8_t *sigs[8];
+	const uint8_t *ms[8];
+	const uint8_t *pks[8];
+	unsigned long long mlen[8];
+	int valid[8];
+	sc25519 r;
+	ge25519_p3 R, T;
+	ge25519_cached c;
+	ge25519_p1p1 t;
+	int i;
+	int result = 0;
+
+	ge25519_unpackneg_vartime(&T, order4);
+	ge25519_p3_to_cached(&c, &T);
+	for (i = 0; i < 8; i++) {
+		randombytes(m[i], sizeof(m[i]));
+		randombytes(sig[i] + 32, 32);
+		sig[i][63] &= 0x0f;
+		sc25519_from32bytes(&r, sig[i] + 32);
+		ge25519_scalarmult_base(&R, &r);
+		ge25519_add_p1p1(&t, &R, &c);
+		ge25519_p1p1_to_p3(&R, &t);
+		ge25519_pack(sig[i], &R);
+
+		sigs[i] = sig[i];
+		ms[i] = m[i];
+		pks[i] = order8;
+		mlen[i] = sizeof(m[i]);
+		if (crypto_sign_ed25519_verify_detached(sig[i], m[i], mlen[i], order8) != 0) {
+			result |= 1;
+		}
+	}
+
+	if (crypto_sign_ed25519_verify_batch(sigs, ms, mlen, pks, 8, valid) != 0) {
+		result |= 2;
+	}
+	for (i = 0; i < 8; i++) {
+		if (valid[i] != 1) {
+			result |= 4;
+		}
+	}
+	return result;
+}
+
+// Compare s1 * (k * B) + s2 * B with (k * s1 + s2) * B for random and
+// zero scalars and check the bits of sc25519_2interleave1.
+// Return 0 if all checks pass
+int test_ge25519_double_scalarmult() {
+	uint8_t bytes[32];
+	uint8_t packed[32];
+	uint8_t expectedPacked[32];
+	uint8_t interleaved[255];
+	sc25519 k, s1, s2, e;
+	ge25519_p3 p, r, expected;
+	int i, j;
+	int result = 0;
+
+	for (i = 0; i < 8; i++) {
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&k, bytes);
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&s1, bytes);
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&s2, bytes);
+		if (i & 1) {
+			memset(&s1, 0, sizeof(s1));
+		}
+		if (i & 2) {
+			memset(&s2, 0, sizeof(s2));
+		}
+
+		ge25519_scalarmult_base(&p, &k);
+		ge25519_double_scalarmult_vartime(&r, &p, &s1, &s2);
+
+		sc25519_mul(&e, &k, &s1);
+		sc25519_add(&e, &e, &s2);
+		ge25519_scalarmult_base(&expected, &e);
+
+		ge25519_pack(packed, &r);
+		ge25519_pack(expectedPacked, &expected);
+		if (memcmp(packed, expectedPacked, 32) != 0) {
+			result |= 1;
+		}
+
+		sc25519_2interleave1(interleaved, &s1, &s2);
+		for (j = 0; j < 255; j++) {
+			int b1 = (s1.as_uint8_t[j >> 3] >> (j & 7)) & 1;
+			int b2 = (s2.as_uint8_t[j >> 3] >> (j & 7)) & 1;
+			if (interleaved[j] != (b1 | (b2 << 1))) {
+				result |= 2;
+			}
+		}
+	}
+	return result;
+}
+
+// Check x * x^-1 = 1 for random x, 0^-1 = 0 and compare sc25519_invert_batch
+// with single inversions.
+// Return 0 if all checks pass
+int test_sc25519_invert() {
+	uint8_t bytes[32];
+	sc25519 x[5];
+	sc25519 inv[5];
+	sc25519 t, one;
+	int i;
+	int result = 0;
+
+	memset(&one, 0, sizeof(one));
+	one.as_uint8_t[0] = 1;
+
+	for (i = 0; i < 5; i++) {
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&x[i], bytes);
+		sc25519_invert(&t, &x[i]);
+		sc25519_mul(&t, &t, &x[i]);
+		if (memcmp(&t, &one, sizeof(t)) != 0) {
+			result |= 1;
+		}
+	}
+
+	sc25519_invert_batch(inv, x, 5);
+	for (i = 0; i < 5; i++) {
+		sc25519_invert(&t, &x[i]);
+		if (memcmp(&t, &inv[i], sizeof(t)) != 0) {
+			result |= 2;
+		}
+	}
+
+	memset(&t, 0, sizeof(t));
+	sc25519_invert(&t, &t);
+	for (i = 0; i < 32; i++) {
+		if (t.as_uint8_t[i] != 0) {
+			result |= 4;
+		}
+	}
+	return result;
+}
+
+// Evaluate (a * b * c)^2 + a for random a, b, c with sc25519_mont and with
+// sc25519 and compare the results.
+// Return 0 if all checks pass
+int test_sc25519_mont() {
+	uint8_t bytes[3][32];
+	uint8_t r1[32];
+	uint8_t r2[32];
+	sc25519 a, b, c, e;
+	sc25519_mont am, bm, cm, em;
+	int i;
+	int result = 0;
+
+	for (i = 0; i < 8; i++) {
+		randombytes(&bytes[0][0], sizeof(bytes));
+		if (i == 0) {
+			memset(bytes[0], 0xff, 32);
+		}
+		sc25519_from32bytes(&a, bytes[0]);
+		sc25519_from32bytes(&b, bytes[1]);
+		sc25519_from32bytes(&c, bytes[2]);
+		sc25519_mul(&e, &a, &b);
+		sc25519_mul(&e, &e, &c);
+		sc25519_sqr(&e, &e);
+		sc25519_add(&e, &e, &a);
+		sc25519_to32bytes(r1, &e);
+
+		sc25519_mont_from32bytes(&am, bytes[0]);
+		sc25519_mont_from32bytes(&bm, bytes[1]);
+		sc25519_to_mont(&cm, &c);
+		sc25519_mont_mul(&em, &am, &bm);
+		sc25519_mont_mul(&em, &em, &cm);
+		sc25519_mont_sqr(&em, &em);
+		sc25519_add(&em.value, &em.value, &am.value);
+		sc25519_mont_to32bytes(r2, &em);
+
+		if (memcmp(r1, r2, 32) != 0) {
+			result |= 1;
+		}
+
+		sc25519_from_mont(&e, &cm);
+		if (memcmp(&e, &c, sizeof(e)) != 0) {
+			result |= 2;
+		}
+	}
+	return result;
+}
+
+// Compare sc25519_muladd with sc25519_mul followed by sc25519_add, including
+// x = y = c = L - 1.
+// Return 0 if all checks pass
+int test_sc25519_muladd() {
+	uint8_t bytes[32];
+	sc25519 x, y, c, r, e;
+	int i;
+	int result = 0;
+
+	for (i = 0; i < 16; i++) {
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&x, bytes);
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&y, bytes);
+		randombytes(bytes, 32);
+		sc25519_from32bytes(&c, bytes);
+		if (i == 0) {
+			// L - 1 = 0 - 1
+			memset(&e, 0, sizeof(e));
+			memset(&x, 0, sizeof(x));
+			x.as_uint8_t[0] = 1;
+			sc25519_sub(&x, &e, &x);
+			y = x;
+			c = x;
+		}
+
+		sc25519_mul(&e, &x, &y);
+		sc25519_add(&e, &e, &c);
+		sc25519_muladd(&r, &x, &y, &c);
+		if (memcmp(&r, &e, sizeof(r)) != 0) {
+			result |= 1;
+		}
+
+		sc25519_muladd(&c, &x, &y, &c);
+		if (memcmp(&c, &e, sizeof(c)) != 0) {
+			result |= 2;
+		}
+	}
+	return result;
+}
+
+// Salsa20 keystream of block counter ctr using the one block core.
+static void salsa20_reference(uint8_t *out, unsigned int len, const uint8_t *n, const uint8_t *k, uint64_t ctr) {
+	static const uint8_t sigma[16] = "expand 32-byte k";
+	uint8_t in[16];
+	uint8_t block[64];
+	unsigned int i;
+
+	memcpy(in, n, 8);
+	while (len) {
+		for (i = 0; i < 8; i++) {
+			in[8 + i] = (uint8_t)(ctr >> (8 * i));
+		}
+		crypto_core_salsa20(block, in, k, sigma);
+		for (i = 0; (i < 64) && (i < len); i++) {
+			out[i] = block[i];
+		}
+		out += i;
+		len -= i;
+		ctr++;
+	}
+}
+
+// Compare the stream functions, which use multi-block kernels for long inputs,
+// with the one block core and with a hash of a reference keystream.
+// Return 0 if all results are correct.
+int test_salsa20() {
+	// SHA-512 of the first 1200 bytes of the keystream for key 1 .. 32, nonce 101 .. 108.
+	static const uint8_t expected[64] = {
+		0x1b, 0x0c, 0xd4, 0x30, 0x8f, 0xac, 0xc2, 0xe5, 0x18, 0xd9, 0x08, 0xc5, 0x3a, 0x62, 0xfc, 0x41,
+		0xaf, 0x53, 0x2d, 0x12, 0xc9, 0x7e, 0x20, 0x6e, 0xc0, 0x28, 0x84, 0xa9, 0x7d, 0xf5, 0xf0, 0xb6,
+		0xa8, 0x6e, 0xe8, 0x99, 0x70, 0x22, 0x1a, 0x3c, 0x27, 0xb1, 0x93, 0xd1, 0x71, 0xc6, 0xd8, 0x9e,
+		0x09, 0xcb, 0x7c, 0x5b, 0xb1, 0xc2, 0x64, 0xe7, 0x7e, 0xa7, 0x48, 0xcb, 0xbd, 0x57, 0x45, 0x8c
+	};
+	static const unsigned int lengths[] = { 1, 63, 64, 255, 256, 257, 511, 512, 513, 767, 1031, 1200 };
+	static const unsigned int chunks[] = { 1, 300, 7, 600, 64, 228 };
+	static uint8_t ref[1200];
+	static uint8_t m[1200];
+	static uint8_t c[1200];
+	salsa20_xor_chunked context;
+	uint8_t k[32];
+	uint8_t n[8];
+	uint8_t hash[64];
+	unsigned int i, j, pos;
+	int result = 0;
+
+	for (i = 0; i < 32; i++) {
+		k[i] = (uint8_t)(i + 1);
+	}
+	for (i = 0; i < 8; i++) {
+		n[i] = (uint8_t)(i + 101);
+	}
+
+	crypto_stream_salsa20(c, sizeof(c), n, k);
+	crypto_hash_sha512(hash, c, sizeof(c));
+	if (memcmp(hash, expected, sizeof(hash)) != 0) {
+		result |= 1;
+	}
+	salsa20_reference(ref, sizeof(ref), n, k, 0);
+	if (memcmp(c, ref, sizeof(c)) != 0) {
+		result |= 2;
+	}
+
+	randombytes(k, sizeof(k));
+	randombytes(n, sizeof(n));
+	randombytes(m, sizeof(m));
+	salsa20_reference(ref, sizeof(ref), n, k, 0);
+
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		memset(c, 0, sizeof(c));
+		crypto_stream_salsa20(c, lengths[i], n, k);
+		crypto_stream_salsa20_xor(c, c, lengths[i], n, k);
+		crypto_stream_salsa20_xor(c, m, lengths[i], n, k);
+		for (j = 0; j < lengths[i]; j++) {
+			if (c[j] != (m[j] ^ ref[j])) {
+				result |= 4;
+			}
+		}
+		for (j = lengths[i]; j < sizeof(c); j++) {
+			if (c[j] != 0) {
+				result |= 8;
+			}
+		}
+	}
+
+	crypto_stream_salsa20_xor_chunked_init(&context, n, k);
+	pos = 0;
+	for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+		crypto_stream_salsa20_xor_chunked(&context, c + pos, m + pos, chunks[i]);
+		pos += chunks[i];
+	}
+	for (j = 0; j < pos; j++) {
+		if (c[j] != (m[j] ^ ref[j])) {
+			result |= 16;
+		}
+	}
+
+	// In place, with word-wise XOR for the chunks of multiples of 4 bytes.
+	memcpy(c, m, sizeof(c));
+	crypto_stream_salsa20_xor_chunked_init(&context, n, k);
+	crypto_stream_salsa20_xor_chunked(&context, c, c, 1024);
+	crypto_stream_salsa20_xor_chunked(&context, c + 1024, c + 1024, 100);
+	crypto_stream_salsa20_xor_chunked(&context, c + 1124, c + 1124, 76);
+	for (j = 0; j < sizeof(c); j++) {
+		if (c[j] != (m[j] ^ ref[j])) {
+			result |= 64;
+		}
+	}
+
+	// Carry of the block counter from word 8 into word 9 within a multi-block kernel.
+	salsa20_reference(ref, sizeof(ref), n, k, 0xfffffffeUL);
+	crypto_stream_salsa20_xor_chunked_init(&context, n, k);
+	context.counter = 0xfffffffeUL;
+	crypto_stream_salsa20_xor_chunked(&context, c, m, 100);
+	crypto_stream_salsa20_xor_chunked(&context, c + 100, m + 100, sizeof(c) - 100);
+	for (j = 0; j < sizeof(c); j++) {
+		if (c[j] != (m[j] ^ ref[j])) {
+			result |= 32;
+		}
+	}
+	return result;
+}
+
+// Test vectors of RFC 8439 (2.5.2 and A.3 #5, #6, which need the final
+// reduction modulo 2^130 - 5), a long message, the incremental interface with
+// odd splits and unaligned input, and the verification.
+// Return 0 if all results are correct.
+int test_poly1305() {
+	static const uint8_t rfcKey[32] = {
+		0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33, 0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+		0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd, 0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b
+	};
+	static const uint8_t rfcTag[16] = {
+		0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6, 0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9
+	};
+	// Key 3 .. 34, message (7 i + 1) mod 256 for i < 1000.
+	static const uint8_t longTag[16] = {
+		0x48, 0x15, 0x65, 0xbd, 0xe9, 0x2b, 0xbb, 0x98, 0xc2, 0x7b, 0x75, 0xa3, 0x92, 0x5e, 0xc6, 0x4d
+	};
+	static const unsigned int splits[] = { 1, 15, 17, 100, 3, 16, 848 };
+	static uint8_t m[1001];
+	crypto_onetimeauth_poly1305_state state;
+	uint8_t k[32];
+	uint8_t tag[16];
+	uint8_t expected[16];
+	unsigned int i, pos;
+	int result = 0;
+
+	crypto_onetimeauth_poly1305(tag, (const uint8_t *)"Cryptographic Forum Research Group", 34, rfcKey);
+	if (memcmp(tag, rfcTag, sizeof(tag)) != 0) {
+		result |= 1;
+	}
+
+	memset(k, 0, sizeof(k));
+	k[0] = 2;
+	memset(m, 0xff, 16);
+	memset(expected, 0, sizeof(expected));
+	expected[0] = 3;
+	crypto_onetimeauth_poly1305(tag, m, 16, k);
+	if (memcmp(tag, expected, sizeof(tag)) != 0) {
+		result |= 2;
+	}
+	memset(k + 16, 0xff, 16);
+	memset(m, 0, 16);
+	m[0] = 2;
+	crypto_onetimeauth_poly1305(tag, m, 16, k);
+	if (memcmp(tag, expected, sizeof(tag)) != 0) {
+		result |= 2;
+	}
+
+	for (i = 0; i < 32; i++) {
+		k[i] = (uint8_t)(i + 3);
+	}
+	for (i = 0; i < 1000; i++) {
+		m[i] = (uint8_t)(7 * i + 1);
+	}
+	crypto_onetimeauth_poly1305(tag, m, 1000, k);
+	if (memcmp(tag, longTag, sizeof(tag)) != 0) {
+		result |= 4;
+	}
+	if (crypto_onetimeauth_poly1305_verify(longTag, m, 1000, k) != 0) {
+		result |= 8;
+	}
+
+	// The same message at an odd address.
+	for (i = 1000; i > 0; i--) {
+		m[i] = m[i - 1];
+	}
+	crypto_onetimeauth_poly1305_init(&state, k);
+	pos = 1;
+	for (i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+		crypto_onetimeauth_poly1305_update(&state, m + pos, splits[i]);
+		pos += splits[i];
+	}
+	crypto_onetimeauth_poly1305_final(&state, tag);
+	if (memcmp(tag, longTag, sizeof(tag)) != 0) {
+		result |= 16;
+	}
+
+	for (i = 0; i < 16; i++) {
+		memcpy(tag, longTag, sizeof(tag));
+		tag[i] ^= (uint8_t)(1 << (i & 7));
+		if (crypto_onetimeauth_poly1305_verify(tag, m + 1, 1000, k) != -1) {
+			result |= 32;
+		}
+	}
+	return result;
+}
+
+// Test vector of NaCl (tests/secretbox.c) and round trips of random messages
+// around the stripe size, in place and with a modified box.
+// Return 0 if all results are correct.
+int test_secretbox() {
+	static const uint8_t key[32] = {
+		0x1b, 0x27, 0x55, 0x64, 0x73, 0xe9, 0x85, 0xd4, 0x62, 0xcd, 0x51, 0x19, 0x7a, 0x9a, 0x46, 0xc7,
+		0x60, 0x09, 0x54, 0x9e, 0xac, 0x64, 0x74, 0xf2, 0x06, 0xc4, 0xee, 0x08, 0x44, 0xf6, 0x83, 0x89
+	};
+	static const uint8_t nonce[24] = {
+		0x69, 0x69, 0x6e, 0xe9, 0x55, 0xb6, 0x2b, 0x73, 0xcd, 0x62, 0xbd, 0xa8,
+		0x75, 0xfc, 0x73, 0xd6, 0x82, 0x19, 0xe0, 0x03, 0x6b, 0x7a, 0x0b, 0x37
+	};
+	static const uint8_t message[131] = {
+		0xbe, 0x07, 0x5f, 0xc5, 0x3c, 0x81, 0xf2, 0xd5, 0xcf, 0x14, 0x13, 0x16, 0xeb, 0xeb, 0x0c, 0x7b,
+		0x52, 0x28, 0xc5, 0x2a, 0x4c, 0x62, 0xcb, 0xd4, 0x4b, 0x66, 0x84, 0x9b, 0x64, 0x24, 0x4f, 0xfc,
+		0xe5, 0xec, 0xba, 0xaf, 0x33, 0xbd, 0x75, 0x1a, 0x1a, 0xc7, 0x28, 0xd4, 0x5e, 0x6c, 0x61, 0x29,
+		0x6c, 0xdc, 0x3c, 0x01, 0x23, 0x35, 0x61, 0xf4, 0x1d, 0xb6, 0x6c, 0xce, 0x31, 0x4a, 0xdb, 0x31,
+		0x0e, 0x3b, 0xe8, 0x25, 0x0c, 0x46, 0xf0, 0x6d, 0xce, 0xea, 0x3a, 0x7f, 0xa1, 0x34, 0x80, 0x57,
+		0xe2, 0xf6, 0x55, 0x6a, 0xd6, 0xb1, 0x31, 0x8a, 0x02, 0x4a, 0x83, 0x8f, 0x21, 0xaf, 0x1f, 0xde,
+		0x04, 0x89, 0x77, 0xeb, 0x48, 0xf5, 0x9f, 0xfd, 0x49, 0x24, 0xca, 0x1c, 0x60, 0x90, 0x2e, 0x52,
+		0xf0, 0xa0, 0x89, 0xbc, 0x76, 0x89, 0x70, 0x40, 0xe0, 0x82, 0xf9, 0x37, 0x76, 0x38, 0x48, 0x64,
+		0x5e, 0x07, 0x05
+	};
+	static const uint8_t box[147] = {
+		0xf3, 0xff, 0xc7, 0x70, 0x3f, 0x94, 0x00, 0xe5, 0x2a, 0x7d, 0xfb, 0x4b, 0x3d, 0x33, 0x05, 0xd9,
+		0x8e, 0x99, 0x3b, 0x9f, 0x48, 0x68, 0x12, 0x73, 0xc2, 0x96, 0x50, 0xba, 0x32, 0xfc, 0x76, 0xce,
+		0x48, 0x33, 0x2e, 0xa7, 0x16, 0x4d, 0x96, 0xa4, 0x47, 0x6f, 0xb8, 0xc5, 0x31, 0xa1, 0x18, 0x6a,
+		0xc0, 0xdf, 0xc1, 0x7c, 0x98, 0xdc, 0xe8, 0x7b, 0x4d, 0xa7, 0xf0, 0x11, 0xec, 0x48, 0xc9, 0x72,
+		0x71, 0xd2, 0xc2, 0x0f, 0x9b, 0x92, 0x8f, 0xe2, 0x27, 0x0d, 0x6f, 0xb8, 0x63, 0xd5, 0x17, 0x38,
+		0xb4, 0x8e, 0xee, 0xe3, 0x14, 0xa7, 0xcc, 0x8a, 0xb9, 0x32, 0x16, 0x45, 0x48, 0xe5, 0x26, 0xae,
+		0x90, 0x22, 0x43, 0x68, 0x51, 0x7a, 0xcf, 0xea, 0xbd, 0x6b, 0xb3, 0x73, 0x2b, 0xc0, 0xe9, 0xda,
+		0x99, 0x83, 0x2b, 0x61, 0xca, 0x01, 0xb6, 0xde, 0x56, 0x24, 0x4a, 0x9e, 0x88, 0xd5, 0xf9, 0xb3,
+		0x79, 0x73, 0xf6, 0x22, 0xa4, 0x3d, 0x14, 0xa6, 0x59, 0x9b, 0x1f, 0x65, 0x4c, 0xb4, 0x5a, 0x74,
+		0xe3, 0x55, 0xa5
+	};
+	static const unsigned int lengths[] = { 0, 1, 255, 480, 481, 1100, 1500 };
+	static uint8_t m[32 + 1500];
+	static uint8_t c[32 + 1500];
+	static uint8_t p[32 + 1500];
+	uint8_t k[32];
+	uint8_t n[24];
+	unsigned int i, j, len;
+	int result = 0;
+
+	memset(m, 0, 32);
+	memcpy(m + 32, message, sizeof(message));
+	crypto_secretbox_xsalsa20poly1305(c, m, 32 + sizeof(message), nonce, key);
+	for (i = 0; i < 16; i++) {
+		if (c[i] != 0) {
+			result |= 1;
+		}
+	}
+	if (memcmp(c + 16, box, sizeof(box)) != 0) {
+		result |= 1;
+	}
+	if ((crypto_secretbox_xsalsa20poly1305_open(p, c, 32 + sizeof(message), nonce, key) != 0) ||
+	    (memcmp(p, m, 32 + sizeof(message)) != 0)) {
+		result |= 2;
+	}
+
+	randombytes(k, sizeof(k));
+	randombytes(n, sizeof(n));
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		len = 32 + lengths[i];
+		memset(m, 0, 32);
+		randombytes(m + 32, lengths[i]);
+		crypto_secretbox_xsalsa20poly1305(c, m, len, n, k);
+
+		// In place.
+		memcpy(p, m, len);
+		crypto_secretbox_xsalsa20poly1305(p, p, len, n, k);
+		if (memcmp(p, c, len) != 0) {
+			result |= 4;
+		}
+		if ((crypto_secretbox_xsalsa20poly1305_open(p, p, len, n, k) != 0) || (memcmp(p, m, len) != 0)) {
+			result |= 8;
+		}
+
+		// Modified authenticator or ciphertext, the box shall be left unchanged.
+		for (j = 16; j < len; j += 7) {
+			memcpy(p, c, len);
+			p[j] ^= 0x10;
+			if (crypto_secretbox_xsalsa20poly1305_open(p, p, len, n, k) != -1) {
+				result |= 16;
+			}
+			p[j] ^= 0x10;
+			if (memcmp(p, c, len) != 0) {
+				result |= 16;
+			}
+		}
+	}
+
+	if (crypto_secretbox_xsalsa20poly1305_open(p, c, 31, n, k) != -1) {
+		result |= 32;
+	}
+	return result;
+}
+
+// Expected output of randombytes_drbg_generate after randombytes_drbg_init with
+// seed: each refill takes the Salsa20 blocks 0 ... RANDOMBYTES_DRBG_BUFFERBYTES / 64 - 1
+// with nonce 0, the first 32 bytes are the next key.
+static void randombytes_drbg_reference(uint8_t *out, unsigned int len, const uint8_t *seed) {
+	static const uint8_t sigma[16] = "expand 32-byte k";
+	uint8_t key[32];
+	uint8_t buffer[RANDOMBYTES_DRBG_BUFFERBYTES];
+	uint8_t in[16];
+	unsigned int i;
+
+	memcpy(key, seed, 32);
+	memset(in, 0, sizeof(in));
+	while (len > 0) {
+		unsigned int n = sizeof(buffer) - 32;
+
+		for (i = 0; i < sizeof(buffer) / 64; i++) {
+			in[8] = (uint8_t)i;
+			crypto_core_salsa20(buffer + 64 * i, in, key, sigma);
+		}
+		memcpy(key, buffer, 32);
+		if (n > len) {
+			n = len;
+		}
+		memcpy(out, buffer + 32, n);
+		out += n;
+		len -= n;
+	}
+}
+
+// Checks the DRBG against randombytes_drbg_reference for requests of different
+// lengths, the erasure of returned bytes and reseeding.
+// Return 0 if correct
+int test_randombytes_drbg() {
+	static const unsigned int lengths[] = { 1, 3, 32, 200, 224, 225, 447, 992, 64 };
+	static randombytes_drbg drbg;
+	uint8_t seed[randombytes_drbg_SEEDBYTES];
+	static uint8_t expected[4096];
+	static uint8_t out[4096];
+	unsigned int i, j, pos;
+	int result = 0;
+
+	randombytes(seed, sizeof(seed));
+	randombytes_drbg_reference(expected, sizeof(expected), seed);
+
+	randombytes_drbg_init(&drbg, seed);
+	pos = 0;
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		randombytes_drbg_generate(&drbg, out + pos, lengths[i]);
+		pos += lengths[i];
+
+		for (j = 0; j < drbg.position; j++) {
+			if (drbg.buffer[j] != 0) {
+				result |= 1;
+			}
+		}
+	}
+	randombytes_drbg_generate(&drbg, out + pos, sizeof(out) - pos);
+	if (memcmp(out, expected, sizeof(out)) != 0) {
+		result |= 2;
+	}
+
+	randombytes_drbg_init(&drbg, seed);
+	randombytes_drbg_generate(&drbg, out, 16);
+	randombytes_drbg_reseed(&drbg, seed);
+	randombytes_drbg_generate(&drbg, out, 16);
+	if ((memcmp(out, expected + 16, 16) == 0) || randombytes_drbg_reseed_due(&drbg)) {
+		result |= 4;
+	}
+
+	randombytes(out, 32);
+	randombytes(out + 32, 32);
+	if (memcmp(out, out + 32, 32) == 0) {
+		result |= 8;
+	}
+	return result;
+}
+
+// ChaCha20 keystream of block counter ctr using one call of at most 64 bytes
+// (no multi-block kernels) per block.
+static void chacha20_reference(uint8_t *out, const uint8_t *m, unsigned int len, const uint8_t *n, const uint8_t *k, uint32_t ctr) {
+	unsigned int l;
+
+	while (len) {
+		l = (len < 64) ? len : 64;
+		crypto_stream_chacha20_ietf_xor_ic(out, m, l, n, ctr, k);
+		out += l;
+		m += l;
+		len -= l;
+		ctr++;
+	}
+}
+
+// RFC 8439 (2.4.2) and draft-irtf-cfrg-xchacha (2.2.1) test vectors, a hash
+// of an XChaCha20 keystream and the comparison of all entry points, chunk
+// splits and a wrap of the 32 bit block counter with the one block code.
+// Return 0 if all results are correct.
+int test_chacha20() {
+	static const char plaintext[] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+	static const uint8_t ciphertext[114] = {
+		0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+		0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2, 0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+		0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+		0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+		0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61, 0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+		0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+		0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+		0x87, 0x4d
+	};
+	static const uint8_t rfcNonce[12] = { 0, 0, 0, 0, 0, 0, 0, 0x4a, 0, 0, 0, 0 };
+	static const uint8_t hNonce[16] = { 0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0, 0x31, 0x41, 0x59, 0x27 };
+	static const uint8_t hOut[32] = {
+		0x82, 0x41, 0x3b, 0x42, 0x27, 0xb2, 0x7b, 0xfe, 0xd3, 0x0e, 0x42, 0x50, 0x8a, 0x87, 0x7d, 0x73,
+		0xa0, 0xf9, 0xe4, 0xd5, 0x8a, 0x74, 0xa8, 0x53, 0xc1, 0x2e, 0xc4, 0x13, 0x26, 0xd3, 0xec, 0xdc
+	};
+	// SHA-512 of the first 1200 bytes of the XChaCha20 keystream for key 1 .. 32, nonce 101 .. 124.
+	static const uint8_t expected[64] = {
+		0x59, 0x01, 0xac, 0x0c, 0xbe, 0xc8, 0x05, 0x34, 0x41, 0x0e, 0x18, 0xad, 0x37, 0xfc, 0xc8, 0xd4,
+		0x11, 0x07, 0x1d, 0xce, 0xb2, 0x73, 0x5f, 0x22, 0xcf, 0xb6, 0xd7, 0xfd, 0xf8, 0x14, 0x37, 0x89,
+		0xa2, 0x93, 0xca, 0x12, 0x34, 0xe1, 0x12, 0x67, 0x49, 0xcd, 0x1b, 0x1b, 0x7c, 0xae, 0xd8, 0x11,
+		0xca, 0xa1, 0x10, 0x93, 0x83, 0xeb, 0xf9, 0xa2, 0xfe, 0x58, 0x37, 0xbc, 0xa1, 0x01, 0x20, 0x02
+	};
+	static const unsigned int lengths[] = { 1, 63, 64, 255, 256, 257, 511, 512, 513, 767, 1031, 1200 };
+	static const unsigned int chunks[] = { 1, 300, 7, 600, 64, 228 };
+	static uint8_t ref[1200];
+	static uint8_t m[1200];
+	static uint8_t c[1200];
+	chacha20_xor_chunked context;
+	uint8_t k[32];
+	uint8_t n[24];
+	uint8_t hash[64];
+	unsigned int i, pos;
+	int result = 0;
+
+	for (i = 0; i < 32; i++) {
+		k[i] = (uint8_t)i;
+	}
+	crypto_stream_chacha20_ietf_xor_ic(c, (const uint8_t *)plaintext, sizeof(ciphertext), rfcNonce, 1, k);
+	if (memcmp(c, ciphertext, sizeof(ciphertext)) != 0) {
+		result |= 1;
+	}
+	crypto_core_hchacha20(hash, hNonce, k, NULL);
+	if (memcmp(hash, hOut, sizeof(hOut)) != 0) {
+		result |= 2;
+	}
+
+	for (i = 0; i < 32; i++) {
+		k[i] = (uint8_t)(i + 1);
+	}
+	for (i = 0; i < 24; i++) {
+		n[i] = (uint8_t)(i + 101);
+	}
+	crypto_stream_xchacha20(c, sizeof(c), n, k);
+	crypto_hash_sha512(hash, c, sizeof(c));
+	if (memcmp(hash, expected, sizeof(hash)) != 0) {
+		result |= 4;
+	}
+	memset(m, 0, sizeof(m));
+	crypto_stream_xchacha20_xor(ref, m, sizeof(ref), n, k);
+	if (memcmp(c, ref, sizeof(c)) != 0) {
+		result |= 4;
+	}
+
+	randombytes(k, sizeof(k));
+	randombytes(n, sizeof(n));
+	randombytes(m, sizeof(m));
+	chacha20_reference(ref, m, sizeof(ref), n, k, 0);
+
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		memset(c, 0, sizeof(c));
+		crypto_stream_chacha20_ietf_xor(c, m, lengths[i], n, k);
+		if (memcmp(c, ref, lengths[i]) != 0) {
+			result |= 8;
+		}
+		if ((lengths[i] < sizeof(c)) && (c[lengths[i]] != 0)) {
+			result |= 8;
+		}
+		crypto_stream_chacha20_ietf(c, lengths[i], n, k);
+		crypto_stream_chacha20_ietf_xor(c, c, lengths[i], n, k);
+		for (pos = 0; pos < lengths[i]; pos++) {
+			if (c[pos] != 0) {
+				result |= 16;
+			}
+		}
+	}
+
+	crypto_stream_chacha20_ietf_xor_chunked_init(&context, n, k);
+	pos = 0;
+	for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+		crypto_stream_chacha20_ietf_xor_chunked(&context, c + pos, m + pos, chunks[i]);
+		pos += chunks[i];
+	}
+	if (memcmp(c, ref, pos) != 0) {
+		result |= 32;
+	}
+
+	// Wrap of the block counter within a multi-block kernel, in place.
+	chacha20_reference(ref, m, sizeof(ref), n, k, 0xfffffffeUL);
+	memcpy(c, m, sizeof(c));
+	crypto_stream_chacha20_ietf_xor_chunked_init(&context, n, k);
+	context.counter = 0xfffffffeUL;
+	crypto_stream_chacha20_ietf_xor_chunked(&context, c, c, 100);
+	crypto_stream_chacha20_ietf_xor_chunked(&context, c + 100, c + 100, sizeof(c) - 100);
+	if (memcmp(c, ref, sizeof(c)) != 0) {
+		result |= 64;
+	}
+	return result;
+}
+
+static uint64_t g_testClock;
+
+static uint64_t test_clock(void) {
+	return ++g_testClock;
+}
+
+// Runs both sides of a CPace or, if w_client is not NULL, an AuCPace handshake.
+// Returns 0 if both sides agree on the ISK and the phases were timed.
+static int cpace_handshake(crypto_pake_arena *arena, const uint8_t *prs_a, const uint8_t *prs_b,
+                           const uint8_t *w_client, const uint8_t *W_server, uint8_t isk_a[64], uint8_t isk_b[64]) {
+	static const uint8_t ci[] = "client-server";
+	static const uint8_t sid[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+	static const uint8_t ad_a[] = "ADa";
+	static const uint8_t ad_b[] = "ADb";
+	crypto_cpace_session *a, *b;
+	uint8_t X[32], Ya[32], Yb[32];
+	int i;
+	int result = 0;
+
+	a = crypto_pake_session_open(arena, crypto_cpace_INITIATOR);
+	b = crypto_pake_session_open(arena, crypto_cpace_RESPONDER);
+	if (a == NULL || b == NULL) {
+		return 1;
+	}
+
+	if (w_client) {
+		result |= crypto_aucpace_server_augment(b, X, W_server) != 0;
+		result |= crypto_aucpace_client_augment(a, w_client, X) != 0;
+		result |= crypto_aucpace_generator(a, ci, sizeof(ci) - 1, sid, sizeof(sid)) != 0;
+		result |= crypto_aucpace_generator(b, ci, sizeof(ci) - 1, sid, sizeof(sid)) != 0;
+	} else {
+		result |= crypto_cpace_generator(a, prs_a, 8, ci, sizeof(ci) - 1, sid, sizeof(sid)) != 0;
+		result |= crypto_cpace_generator(b, prs_b, 8, ci, sizeof(ci) - 1, sid, sizeof(sid)) != 0;
+	}
+	result |= crypto_cpace_share(a, Ya) != 0;
+	result |= crypto_cpace_share(b, Yb) != 0;
+	result |= crypto_cpace_finish(a, isk_a, Yb, ad_a, 3, ad_b, 3) != 0;
+	result |= crypto_cpace_finish(b, isk_b, Ya, ad_b, 3, ad_a, 3) != 0;
+	result |= a->state != crypto_cpace_STATE_DONE || b->state != crypto_cpace_STATE_DONE;
+
+	for (i = (w_client ? crypto_cpace_PHASE_AUGMENT : crypto_cpace_PHASE_GENERATOR); i < crypto_cpace_PHASES; i++) {
+		result |= a->cycles[i] != 1 || b->cycles[i] != 1;
+	}
+
+	crypto_pake_session_close(arena, a);
+	crypto_pake_session_close(arena, b);
+	return result;
+}
+
+// CPace and AuCPace handshakes with matching and different passwords, the
+// state checks, small order shares and the arena bookkeeping, and reference
+// values for the generator, the shares and the ISK with the ephemeral scalars
+// injected through crypto_cpace_share_scalar().
+// Return 0 if all checks pass
+int test_cpace() {
+	static const uint8_t kat_sid[16] = {
+		0x7E, 0x4B, 0x47, 0x91, 0xD6, 0xA8, 0xEF, 0x01, 0x9B, 0x93, 0x6C, 0x79, 0xFB, 0x7F, 0x2C, 0x57 };
+	static const uint8_t kat_g[32] = {
+		0x4E, 0x60, 0x98, 0x73, 0x30, 0x61, 0xC0, 0xE8, 0x48, 0x66, 0x11, 0xA9, 0x04, 0xFE, 0x5E, 0xDB,
+		0x04, 0x98, 0x04, 0xD2, 0x61, 0x30, 0xA4, 0x41, 0x31, 0xA6, 0x22, 0x9E, 0x55, 0xC5, 0xC3, 0x21 };
+	static const uint8_t kat_ya[32] = {
+		0x21, 0xB4, 0xF4, 0xBD, 0x9E, 0x64, 0xED, 0x35, 0x5C, 0x3E, 0xB6, 0x76, 0xA2, 0x8E, 0xBE, 0xDA,
+		0xF6, 0xD8, 0xF1, 0x7B, 0xDC, 0x36, 0x59, 0x95, 0xB3, 0x19, 0x09, 0x71, 0x53, 0x04, 0x40, 0x80 };
+	static const uint8_t kat_Ya[32] = {
+		0xF9, 0x70, 0xE3, 0x6F, 0x37, 0xCF, 0xCD, 0x9A, 0x39, 0xE3, 0x7D, 0xD2, 0xD1, 0xFB, 0xC9, 0x15,
+		0x6D, 0x6D, 0x2F, 0x9A, 0xE4, 0x22, 0xF4, 0x72, 0x2C, 0xBD, 0x9D, 0x32, 0xE9, 0xB1, 0xE7, 0x04 };
+	static const uint8_t kat_yb[32] = {
+		0x84, 0x8B, 0x07, 0x79, 0xFF, 0x41, 0x5F, 0x0A, 0xF4, 0xEA, 0x14, 0xDF, 0x9D, 0xD1, 0xD3, 0xC2,
+		0x9A, 0xC4, 0x1D, 0x83, 0x6C, 0x78, 0x08, 0x89, 0x6C, 0x4E, 0xBA, 0x19, 0xC5, 0x1A, 0xC4, 0x0A };
+	static const uint8_t kat_Yb[32] = {
+		0x01, 0x78, 0xBB, 0xBA, 0xB0, 0x80, 0x4A, 0x44, 0x55, 0xB8, 0xF0, 0x2E, 0x5D, 0x6E, 0x7D, 0x80,
+		0x99, 0x7C, 0x64, 0x70, 0xBF, 0xB3, 0x61, 0x8D, 0x7E, 0x74, 0xC3, 0x96, 0x47, 0xAF, 0x5A, 0x29 };
+	static const uint8_t kat_isk[64] = {
+		0xF5, 0xEF, 0x3C, 0x13, 0xFD, 0xB9, 0xDF, 0xE8, 0x39, 0xBD, 0xBF, 0x8A, 0x92, 0x56, 0xE8, 0xCE,
+		0xE7, 0xDB, 0x8A, 0x8F, 0x1D, 0xFA, 0x74, 0x95, 0x8A, 0x92, 0x54, 0x50, 0xCF, 0x80, 0x89, 0xCD,
+		0x56, 0x0D, 0x9A, 0x4E, 0x79, 0x56, 0xB7, 0x33, 0x4B, 0x6F, 0x62, 0x5C, 0x85, 0x59, 0xB7, 0x5E,
+		0xA0, 0x76, 0x4A, 0xC2, 0xBE, 0x89, 0x4B, 0x8F, 0x3D, 0x43, 0x4B, 0x30, 0xE8, 0x77, 0x97, 0xD5 };
+	static const uint8_t kat_prs[8] = "Password";
+	static const uint8_t kat_ci[22] = "\nAinitiator\nBresponder";
+	static uint8_t memory[crypto_pake_ARENABYTES(3) + 1];
+	static const uint8_t prs[8] = "password";
+	static const uint8_t prs_wrong[8] = "passw0rd";
+	static const uint8_t zero[32] = { 0 };
+	crypto_pake_arena arena;
+	crypto_cpace_session *s[4];
+	uint8_t isk_a[64], isk_b[64], w[32], w_wrong[32], W[32], Y[32];
+	int result = 0;
+
+	// Arena in unaligned memory
+	if (crypto_pake_arena_init(&arena, memory + 1, sizeof(memory) - 1, test_clock) != 3) {
+		result |= 1;
+	}
+	s[0] = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+	s[1] = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+	s[2] = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+	s[3] = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+	if (s[2] == NULL || s[3] != NULL || ((uintptr_t)s[0] % sizeof(uint64_t)) != 0) {
+		result |= 1;
+	}
+
+	// Calls out of order
+	if (crypto_cpace_share(s[0], Y) != -1 || crypto_aucpace_generator(s[0], NULL, 0, NULL, 0) != -1 ||
+	    crypto_cpace_finish(s[0], isk_a, Y, NULL, 0, NULL, 0) != -1 || s[0]->state != crypto_cpace_STATE_OPEN) {
+		result |= 2;
+	}
+
+	// Share of small order
+	if (crypto_cpace_generator(s[0], prs, 8, NULL, 0, NULL, 0) != 0 || crypto_cpace_share(s[0], Y) != 0 ||
+	    crypto_cpace_finish(s[0], isk_a, zero, NULL, 0, NULL, 0) != -1 || s[0]->state != crypto_cpace_STATE_FAILED) {
+		result |= 4;
+	}
+	if (crypto_aucpace_client_augment(s[1], prs, zero) != -1 || s[1]->state != crypto_cpace_STATE_FAILED) {
+		result |= 4;
+	}
+	crypto_pake_session_close(&arena, s[0]);
+	crypto_pake_session_close(&arena, s[1]);
+	crypto_pake_session_close(&arena, s[2]);
+
+	// CPace
+	result |= cpace_handshake(&arena, prs, prs, NULL, NULL, isk_a, isk_b) << 3;
+	if (memcmp(isk_a, isk_b, 64) != 0) {
+		result |= 16;
+	}
+	result |= cpace_handshake(&arena, prs, prs_wrong, NULL, NULL, isk_a, isk_b) << 3;
+	if (memcmp(isk_a, isk_b, 64) == 0) {
+		result |= 16;
+	}
+
+	// AuCPace
+	randombytes(w, 32);
+	randombytes(w_wrong, 32);
+	crypto_aucpace_verifier(W, w);
+	result |= cpace_handshake(&arena, NULL, NULL, w, W, isk_a, isk_b) << 5;
+	if (memcmp(isk_a, isk_b, 64) != 0) {
+		result |= 64;
+	}
+	result |= cpace_handshake(&arena, NULL, NULL, w_wrong, W, isk_a, isk_b) << 5;
+	if (memcmp(isk_a, isk_b, 64) == 0) {
+		result |= 64;
+	}
+
+	// Reference values of an independent model of the construction (Python
+	// hashlib, X25519 of RFC 7748 and Elligator2 of RFC 9380) for the inputs of
+	// the X25519 test vectors of the CPace draft. They are not the draft's
+	// outputs: g from the generator string, shares Ya, Yb for the fixed scalars
+	// ya, yb and the ISK with ADa = "ADa" and ADb = "ADb".
+	s[0] = crypto_pake_session_open(&arena, crypto_cpace_INITIATOR);
+	s[1] = crypto_pake_session_open(&arena, crypto_cpace_RESPONDER);
+	if (crypto_cpace_generator(s[0], kat_prs, 8, kat_ci, 22, kat_sid, 16) != 0 ||
+	    crypto_cpace_generator(s[1], kat_prs, 8, kat_ci, 22, kat_sid, 16) != 0 ||
+	    memcmp(s[0]->g, kat_g, 32) != 0 || memcmp(s[1]->g, kat_g, 32) != 0) {
+		result |= 128;
+	}
+	if (crypto_cpace_share_scalar(s[0], Y, kat_ya) != 0 || memcmp(Y, kat_Ya, 32) != 0 ||
+	    crypto_cpace_share_scalar(s[1], Y, kat_yb) != 0 || memcmp(Y, kat_Yb, 32) != 0) {
+		result |= 256;
+	}
+	if (crypto_cpace_finish(s[0], isk_a, kat_Yb, (const uint8_t *)"ADa", 3, (const uint8_t *)"ADb", 3) != 0 ||
+	    crypto_cpace_finish(s[1], isk_b, kat_Ya, (const uint8_t *)"ADb", 3, (const uint8_t *)"ADa", 3) != 0 ||
+	    memcmp(isk_a, kat_isk, 64) != 0 || memcmp(isk_b, kat_isk, 64) != 0) {
+		result |= 512;
+	}
+	crypto_pake_session_close(&arena, s[0]);
+	crypto_pake_session_close(&arena, s[1]);
+
+	return result;
+}
+
+// SHA-256 and scrypt test vectors of FIPS 180-2 and RFC 7914, the one with
+// p = 4 from Python's hashlib.scrypt. Threads must not change the result.
+// Return 0 if all checks pass
+int test_scrypt() {
+	static const uint8_t correct_sha256_abc[32] = {
+		0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+		0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD };
+	static const uint8_t msg2[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	static const uint8_t correct_sha256_msg2[32] = {
+		0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+		0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1 };
+	// P = "", S = "", N = 16, r = 1, p = 1
+	static const uint8_t correct_rfc1[64] = {
+		0x77, 0xD6, 0x57, 0x62, 0x38, 0x65, 0x7B, 0x20, 0x3B, 0x19, 0xCA, 0x42, 0xC1, 0x8A, 0x04, 0x97,
+		0xF1, 0x6B, 0x48, 0x44, 0xE3, 0x07, 0x4A, 0xE8, 0xDF, 0xDF, 0xFA, 0x3F, 0xED, 0xE2, 0x14, 0x42,
+		0xFC, 0xD0, 0x06, 0x9D, 0xED, 0x09, 0x48, 0xF8, 0x32, 0x6A, 0x75, 0x3A, 0x0F, 0xC8, 0x1F, 0x17,
+		0xE8, 0xD3, 0xE0, 0xFB, 0x2E, 0x0D, 0x36, 0x28, 0xCF, 0x35, 0xE2, 0x0C, 0x38, 0xD1, 0x89, 0x06 };
+	// P = "password", S = "NaCl", N = 32, r = 2, p = 4
+	static const uint8_t correct_p4[64] = {
+		0x05, 0xDC, 0x0D, 0x73, 0xAD, 0x21, 0x6E, 0x65, 0x22, 0xAD, 0x6F, 0x17, 0xF2, 0x01, 0xBF, 0xA0,
+		0xFB, 0x34, 0xC5, 0x47, 0x68, 0x52, 0xAC, 0x73, 0xB9, 0xDF, 0x8E, 0xAC, 0xC2, 0xEE, 0xD5, 0xDE,
+		0x28, 0xC3, 0xAC, 0x41, 0x69, 0x6B, 0x68, 0xB0, 0x12, 0xC3, 0x8D, 0xA1, 0x2E, 0xC6, 0x68, 0xC6,
+		0x18, 0x3F, 0xA2, 0x3C, 0xF0, 0x41, 0x78, 0x08, 0xC9, 0x31, 0x6D, 0xF9, 0x7E, 0xE0, 0xBF, 0xB4 };
+	static uint8_t memory[crypto_pwhash_scryptsalsa208sha256_MEMORYBYTES(32, 2, 4, 2) + 1];
+	uint8_t out[64];
+	unsigned int threads;
+	int result = 0;
+
+	crypto_hash_sha256(out, (const uint8_t*)"abc", 3);
+	if (memcmp(out, correct_sha256_abc, 32) != 0) {
+		result |= 1;
+	}
+	crypto_hash_sha256(out, msg2, sizeof(msg2) - 1);
+	if (memcmp(out, correct_sha256_msg2, 32) != 0) {
+		result |= 1;
+	}
+
+	if (crypto_pwhash_scryptsalsa208sha256_ll((const uint8_t*)"", 0, (const uint8_t*)"", 0, 16, 1, 1, out, 64,
+	                                          memory + 1, sizeof(memory) - 1, 1) != 0 ||
+	    memcmp(out, correct_rfc1, 64) != 0) {
+		result |= 2;
+	}
+
+	for (threads = 1; threads <= 2; threads++) {
+		memset(out, 0, sizeof(out));
+		if (crypto_pwhash_scryptsalsa208sha256_ll((const uint8_t*)"password", 8, (const uint8_t*)"NaCl", 4, 32, 2, 4,
+		                                          out, 64, memory + 1, sizeof(memory) - 1, threads) != 0 ||
+		    memcmp(out, correct_p4, 64) != 0) {
+			result |= 4;
+		}
+	}
+
+#ifndef CRYPTO_HAS_PTHREADS
+	// Without threads, the memory for one thread suffices for any number of threads.
+	memset(out, 0, sizeof(out));
+	if (crypto_pwhash_scryptsalsa208sha256_ll((const uint8_t*)"password", 8, (const uint8_t*)"NaCl", 4, 32, 2, 4,
+	                                          out, 64, memory + 1,
+	                                          crypto_pwhash_scryptsalsa208sha256_MEMORYBYTES(32, 2, 4, 1), 4) != 0 ||
+	    memcmp(out, correct_p4, 64) != 0) {
+		result |= 4;
+	}
+#endif
+
+	// N not a power of two, too little memory
+	if (crypto_pwhash_scryptsalsa208sha256_ll((const uint8_t*)"password", 8, (const uint8_t*)"NaCl", 4, 24, 2, 4,
+	                                          out, 64, memory, sizeof(memory), 1) != -1 ||
+	    crypto_pwhash_scryptsalsa208sha256_ll((const uint8_t*)"password", 8, (const uint8_t*)"NaCl", 4, 128, 2, 4,
+	                                          out, 64, memory, sizeof(memory), 2) != -1) {
+		result |= 8;
+	}
+	return result;
+}
@@ -3,15 +3,52 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "crypto/include/randombytes.h"
 #include "crypto/include/crypto_scalarmult.h"
 #include "crypto/include/fe25519.h"
+#include "crypto/include/ge25519.h"
+#include "crypto/include/crypto_hash.h"
+#include "crypto/include/crypto_hash_to_curve.h"
+#include "crypto/include/crypto_pake.h"
+#include "crypto/include/cpacedefs.h"
+#include "crypto/include/crypto_pwhash.h"
+#include "crypto/include/crypto_sign.h"
+#include "crypto/include/crypto_stream.h"
+#include "crypto/include/crypto_onetimeauth.h"
+#include "crypto/include/crypto_secretbox.h"
 
 
 
 int test_curve25519_DH(void);
 int test_curve25519_DH_TV(void);
 int test_curve25519_static(void);
+int test_curve25519_batch(void);
+int test_fe25519_batch_invert(void);
+int test_fe25519_invert_safegcd(void);
+int test_elligator2(void);
+int test_hash_to_curve(void);
+
+int test_sc25519_invert(void);
+int test_sc25519_mont(void);
+int test_sc25519_muladd(void);
+int test_ge25519_double_scalarmult(void);
+
+int test_salsa20(void);
+int test_chacha20(void);
+int test_poly1305(void);
+int test_secretbox(void);
+int test_randombytes_drbg(void);
+
+int test_sha512_TV(void);
+int test_sha512_batch(void);
+int test_ed25519_TV(void);
+int test_ed25519(void);
+int test_ed25519_batch(void);
+int test_ed25519_small_order(void);
+
+int test_cpace(void);
+int test_scrypt(void);
 
 int test_cswap(void);
 
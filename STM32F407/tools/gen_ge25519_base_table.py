@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+# Generates crypto/numerics/ge25519_base_table.c, i.e. the precomputed
+# multiples of the edwards25519 base point used by ge25519_scalarmult_base().
+#
+# Window w (0 <= w < 32) holds i * 16^(2w) * B for i = 1 .. 8 in affine
+# "niels" form (y - x, y + x, 2 d x y), fully reduced, little endian.
+# The 12 KByte and 6 KByte configurations use every second / fourth window.
+#
+# ge25519_base_odd_multiples holds (2 i + 1) * B for i = 0 .. 31 in the same
+# form for the sliding windows of ge25519_double_scalarmult_vartime().
+#
+# Author: Bjoern Haase
+#
+# License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+
+import sys
+
+p = 2**255 - 19
+d = (-121665 * pow(121666, p - 2, p)) % p
+
+
+def recover_x(y):
+    xx = (y * y - 1) * pow(d * y * y + 1, p - 2, p) % p
+    x = pow(xx, (p + 3) // 8, p)
+    if (x * x - xx) % p != 0:
+        x = x * pow(2, (p - 1) // 4, p) % p
+    if x & 1:
+        x = p - x
+    return x
+
+
+def add(P, Q):
+    (x1, y1), (x2, y2) = P, Q
+    t = d * x1 * x2 * y1 * y2 % p
+    x3 = (x1 * y2 + x2 * y1) * pow(1 + t, p - 2, p) % p
+    y3 = (y1 * y2 + x1 * x2) * pow(1 - t, p - 2, p) % p
+    return (x3, y3)
+
+
+def scalarmult(P, n):
+    R = (0, 1)
+    while n:
+        if n & 1:
+            R = add(R, P)
+        P = add(P, P)
+        n >>= 1
+    return R
+
+
+def fe_initializer(v):
+    b = v.to_bytes(32, "little")
+    return "{{" + ", ".join("0x%02x" % c for c in b) + "}}"
+
+
+def niels_initializer(out, P, last, indent="        "):
+    x, y = P
+    out.write(indent + "{\n")
+    out.write(indent + "    %s,\n" % fe_initializer((y - x) % p))
+    out.write(indent + "    %s,\n" % fe_initializer((y + x) % p))
+    out.write(indent + "    %s\n" % fe_initializer(2 * d * x * y % p))
+    out.write(indent + "}%s\n" % ("" if last else ","))
+
+
+def main(out):
+    by = 4 * pow(5, p - 2, p) % p
+    B = (recover_x(by), by)
+
+    out.write("/*                          =======================\n")
+    out.write("  ============================ C/C++ HEADER FILE =============================\n")
+    out.write("                            =======================\n\n")
+    out.write("    \\file ge25519_base_table.c\n\n")
+    out.write("    Precomputed multiples of the edwards25519 base point for\n")
+    out.write("    ge25519_scalarmult_base() and ge25519_double_scalarmult_vartime().\n\n")
+    out.write("    Generated by tools/gen_ge25519_base_table.py. Do not edit by hand!\n\n")
+    out.write("    \\Author: B. Haase, Endress + Hauser Conducta GmbH & Co. KG\n\n")
+    out.write("    License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)\n")
+    out.write("  ============================================================================*/\n\n")
+    out.write('#include "../include/ge25519.h"\n\n')
+    out.write("#if (GE25519_BASE_TABLE_WINDOWS > 0)\n\n")
+    out.write("const ge25519_niels_packed\n")
+    out.write("ge25519_base_multiples[GE25519_BASE_TABLE_WINDOWS][8] =\n{\n")
+
+    for w in range(32):
+        if w % 4 == 0:
+            cond = None
+        elif w % 2 == 0:
+            cond = "(GE25519_BASE_TABLE_WINDOWS >= 16)"
+        else:
+            cond = "(GE25519_BASE_TABLE_WINDOWS >= 32)"
+        if cond:
+            out.write("#if %s\n" % cond)
+        W = scalarmult(B, 16 ** (2 * w))
+        out.write("    { // 16^%d * B\n" % (2 * w))
+        P = W
+        for i in range(8):
+            niels_initializer(out, P, i == 7)
+            P = add(P, W)
+        out.write("    },\n")
+        if cond:
+            out.write("#endif\n")
+
+    out.write("};\n\n")
+
+    out.write("const ge25519_niels_packed\n")
+    out.write("ge25519_base_odd_multiples[1 << (GE25519_BASE_SLIDE_WIDTH - 2)] =\n{\n")
+    B2 = add(B, B)
+    P = B
+    for i in range(32):
+        out.write("    // %d * B\n" % (2 * i + 1))
+        niels_initializer(out, P, i == 31, "    ")
+        P = add(P, B2)
+    out.write("};\n\n")
+    out.write("#endif // #if (GE25519_BASE_TABLE_WINDOWS > 0)\n")
+
+
+if __name__ == "__main__":
+    main(sys.stdout)
@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+#
+# Estimates Cortex-M4 cycle counts of the regions bracketed by
+# cycle_region_begin() / cycle_region_end() in qemu/main_qemu.c.
+#
+# QEMU neither models the pipeline nor the DWT cycle counter of the M4. Instead,
+# the firmware is run with the execlog TCG plugin, which logs every executed
+# instruction, and the instructions are weighted with the timings of the
+# Cortex-M4 Technical Reference Manual (table 3-1):
+#
+#  - data processing, MUL, UMULL, UMLAL, UMAAL, ...      1
+#  - MLA, MLS                                           2
+#  - LDR, STR, ... (single)                             2, 1 if following a single load or store
+#  - LDRD, STRD, LDM, STM, PUSH, POP                    1 + number of registers
+#  - SDIV, UDIV                                         2 .. 12, counted as 7
+#  - every taken branch or other write to pc            + P, see --branch-penalty
+#
+# Flash wait states are not modeled, which matches the STM32F407 at 24 MHz
+# (benchmarkclock in stm32f4_wrapper.c). Instructions skipped in IT blocks
+# are counted with their full cost. The estimate is meant for comparing two
+# versions of the asm code, not as a replacement for the DWT counts.
+#
+# Usage:
+#
+#   m4_cycle_estimate.py --plugin /path/to/libexeclog.so main_qemu.elf
+#       runs qemu-system-arm and prints the estimate per region.
+#   m4_cycle_estimate.py --trace trace.log --output output.txt main_qemu.elf
+#       evaluates the trace (-d plugin -D trace.log) and the semihosting output
+#       of an earlier run.
+#
+#   --json writes the results as JSON, --baseline old.json prints the change
+#   relative to such a file.
+#
+# Author: Bjoern Haase
+#
+# License: CC0 1.0 (http://creativecommons.org/publicdomain/zero/1.0/legalcode)
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+
+CONDITIONS = ("eq", "ne", "cs", "hs", "cc", "lo", "mi", "pl", "vs", "vc",
+              "hi", "ls", "ge", "lt", "gt", "le", "al")
+
+# Mnemonic -> (class, cycles). Mnemonics not listed take one cycle.
+TIMINGS = {
+    "mla": ("alu", 2), "mls": ("alu", 2),
+    "sdiv": ("alu", 7), "udiv": ("alu", 7),
+    "tbb": ("alu", 2), "tbh": ("alu", 2),
+    "dsb": ("alu", 3), "dmb": ("alu", 3), "isb": ("alu", 3),
+    "vdiv": ("alu", 14), "vsqrt": ("alu", 14),
+    "vmla": ("alu", 3), "vmls": ("alu", 3), "vnmla": ("alu", 3), "vnmls": ("alu", 3),
+    "vfma": ("alu", 3), "vfms": ("alu", 3), "vfnma": ("alu", 3), "vfnms": ("alu", 3),
+}
+for m in ("ldr", "ldrb", "ldrh", "ldrsb", "ldrsh", "ldrt", "ldrex",
+          "str", "strb", "strh", "strt", "strex", "vldr", "vstr"):
+    TIMINGS[m] = ("single", 2)
+for m in ("ldrd", "strd"):
+    TIMINGS[m] = ("double", 3)
+for m in ("ldm", "ldmia", "ldmfd", "ldmdb", "ldmea", "stm", "stmia", "stmea",
+          "stmdb", "stmfd", "push", "pop", "vpush", "vpop", "vldm", "vldmia",
+          "vldmdb", "vstm", "vstmia", "vstmdb"):
+    TIMINGS[m] = ("multiple", 1)
+
+TRACE_LINE = re.compile(r'^\s*\d+,\s*0x([0-9a-fA-F]+),\s*0x[0-9a-fA-F]+,\s*"([^"]*)"')
+REGISTER_RANGE = re.compile(r"([a-z]+)(\d+)-[a-z]+(\d+)")
+
+
+def base_mnemonic(mnemonic):
+    mnemonic = mnemonic.lower().split(".")[0]
+    # Strip "s" and condition code suffixes, e.g. "addseq" or "ldrne".
+    candidates = [mnemonic]
+    for cond in CONDITIONS:
+        if mnemonic.endswith(cond):
+            candidates.append(mnemonic[:-len(cond)])
+    for candidate in list(candidates):
+        if candidate.endswith("s"):
+            candidates.append(candidate[:-1])
+    for candidate in candidates:
+        if candidate in TIMINGS:
+            return candidate
+    return mnemonic
+
+
+def count_registers(operands):
+    if "{" not in operands:
+        return 2
+    registers = operands[operands.index("{") + 1:operands.index("}")]
+    n = 0
+    for item in registers.split(","):
+        item = item.strip()
+        match = REGISTER_RANGE.match(item)
+        if match:
+            n += int(match.group(3)) - int(match.group(2)) + 1
+        elif item:
+            n += 1
+    return n
+
+
+def classify(disassembly):
+    """Returns (class, cycles without branch penalty) of one instruction."""
+    parts = disassembly.strip().split(None, 1)
+    if not parts:
+        return ("alu", 1)
+    mnemonic = base_mnemonic(parts[0])
+    operands = parts[1] if len(parts) > 1 else ""
+    kind, cycles = TIMINGS.get(mnemonic, ("alu", 1))
+    if kind == "multiple":
+        cycles = 1 + count_registers(operands)
+    return (kind, cycles)
+
+
+def read_symbols(nm, elf):
+    """Returns {name: (start, end)} of the function symbols of elf."""
+    out = subprocess.run([nm, "-S", "--defined-only", elf], check=True,
+                         stdout=subprocess.PIPE, universal_newlines=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2].lower() == "t":
+            start = int(fields[0], 16) & ~1
+            symbols[fields[3]] = (start, start + int(fields[1], 16))
+    return symbols
+
+
+class Estimator:
+    def __init__(self, begin, end, branch_penalty):
+        self.begin = begin
+        self.end = end
+        self.branch_penalty = branch_penalty
+        self.cache = {}
+        self.inside = False
+        self.previous = None
+        self.previous_single = False
+        self.instructions = 0
+        self.cycles = 0
+        self.regions = []
+
+    def add(self, pc, disassembly):
+        info = self.cache.get(pc)
+        if info is None:
+            info = self.cache[pc] = classify(disassembly)
+
+        if self.inside and self.previous is not None and pc not in (self.previous + 2, self.previous + 4):
+            self.cycles += self.branch_penalty
+        self.previous = None
+
+        if pc == self.end[0]:
+            if self.inside:
+                self.regions.append((self.instructions, self.cycles))
+            self.inside = False
+        if self.begin[0] <= pc < self.begin[1]:
+            self.inside = True
+            self.instructions = 0
+            self.cycles = 0
+            self.previous_single = False
+            return
+        if not self.inside:
+            return
+
+        kind, cycles = info
+        if kind == "single" and self.previous_single:
+            cycles -= 1
+        self.previous_single = (kind == "single")
+        self.instructions += 1
+        self.cycles += cycles
+        self.previous = pc
+
+    def parse(self, stream):
+        for line in stream:
+            match = TRACE_LINE.match(line)
+            if match:
+                self.add(int(match.group(1), 16), match.group(2))
+
+
+def region_names(output):
+    return [line[len("@cycles "):].strip() for line in output.splitlines() if line.startswith("@cycles ")]
+
+
+def run_qemu(args, estimator):
+    """Runs the firmware with the trace written to a fifo. Returns (output, status)."""
+    directory = tempfile.mkdtemp()
+    fifo = os.path.join(directory, "trace")
+    os.mkfifo(fifo)
+    command = [args.qemu, "-M", args.machine, "-nographic", "-monitor", "none",
+               "-semihosting-config", "enable=on,target=native",
+               "-kernel", args.elf, "-plugin", args.plugin, "-d", "plugin", "-D", fifo]
+    try:
+        with tempfile.TemporaryFile(mode="w+") as output:
+            process = subprocess.Popen(command, stdout=output)
+            reader = threading.Thread(target=lambda: estimator.parse(open(fifo)))
+            reader.start()
+            status = process.wait()
+            if reader.is_alive():
+                # QEMU terminated without opening the trace, release the reader.
+                os.close(os.open(fifo, os.O_WRONLY | os.O_NONBLOCK))
+            reader.join()
+            output.seek(0)
+            return (output.read(), status)
+    finally:
+        os.unlink(fifo)
+        os.rmdir(directory)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cortex-M4 cycle estimate from a QEMU instruction trace")
+    parser.add_argument("elf", help="firmware built with qemu/main_qemu.c")
+    parser.add_argument("--qemu", default="qemu-system-arm")
+    parser.add_argument("--machine", default="netduinoplus2")
+    parser.add_argument("--plugin", default=os.environ.get("QEMU_EXECLOG_PLUGIN"),
+                        help="path of libexeclog.so (default: $QEMU_EXECLOG_PLUGIN)")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--trace", help="evaluate this execlog trace instead of running QEMU")
+    parser.add_argument("--output", help="semihosting output belonging to --trace")
+    parser.add_argument("--branch-penalty", type=int, default=2,
+                        help="pipeline refill cycles P of a taken branch (1 .. 3, default 2)")
+    parser.add_argument("--json", help="write the results to this file")
+    parser.add_argument("--baseline", help="JSON file of an earlier run to compare with")
+    args = parser.parse_args()
+
+    symbols = read_symbols(args.nm, args.elf)
+    for name in ("cycle_marker_begin", "cycle_marker_end"):
+        if name not in symbols:
+            sys.exit("%s: symbol %s not found, not built from qemu/main_qemu.c?" % (args.elf, name))
+    estimator = Estimator(symbols["cycle_marker_begin"], symbols["cycle_marker_end"], args.branch_penalty)
+
+    if args.trace:
+        if not args.output:
+            sys.exit("--trace requires --output")
+        with open(args.trace) as trace:
+            estimator.parse(trace)
+        with open(args.output) as output:
+            output_text = output.read()
+        status = 0
+    else:
+        if not args.plugin:
+            sys.exit("the execlog plugin is required, see --plugin")
+        output_text, status = run_qemu(args, estimator)
+        sys.stderr.write(output_text)
+
+    names = region_names(output_text)
+    if len(names) != len(estimator.regions):
+        sys.exit("found %d region names but %d regions in the trace" % (len(names), len(estimator.regions)))
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = {r["name"]: r["cycles"] for r in json.load(f)["results"]}
+
+    results = []
+    print("%-40s %14s %14s" % ("region", "instructions", "cycles"))
+    for name, (instructions, cycles) in zip(names, estimator.regions):
+        line = "%-40s %14d %14d" % (name, instructions, cycles)
+        if name in baseline and baseline[name] > 0:
+            line += "  %+.2f%%" % (100.0 * (cycles - baseline[name]) / baseline[name])
+        print(line)
+        results.append({"name": name, "instructions": instructions, "cycles": cycles})
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"branch_penalty": args.branch_penalty, "results": results}, f, indent=2)
+
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
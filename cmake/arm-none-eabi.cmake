@@ -0,0 +1,23 @@
+# Toolchain file for building the STM32F407 firmware:
+#   cmake -S . -B build-arm -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR cortex-m4)
+
+set(CROSS_PREFIX arm-none-eabi- CACHE STRING "Prefix of the cross compiler binaries")
+
+set(CMAKE_C_COMPILER ${CROSS_PREFIX}gcc)
+set(CMAKE_ASM_COMPILER ${CROSS_PREFIX}gcc)
+set(CMAKE_OBJCOPY ${CROSS_PREFIX}objcopy CACHE FILEPATH "")
+
+# Linking a test executable requires startup code and a linker script.
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(ARM_ARCH_FLAGS "-mthumb -mcpu=cortex-m4 -mfloat-abi=hard -mfpu=fpv4-sp-d16")
+set(CMAKE_C_FLAGS_INIT "${ARM_ARCH_FLAGS}")
+set(CMAKE_ASM_FLAGS_INIT "${ARM_ARCH_FLAGS}")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${ARM_ARCH_FLAGS}")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)